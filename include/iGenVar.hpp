@@ -2,7 +2,7 @@
 
 #include <seqan3/argument_parser/argument_parser.hpp>   // for seqan3::argument_parser
 
-#include "variant_detection/method_enums.hpp"           // for enum detection_methods, clustering_methods and refinement_methods
+#include "variant_detection/method_enums.hpp"           // for enum detection_methods, clustering_methods, refinement_methods and resume_stages
 
 struct cmd_arguments
 {
@@ -17,7 +17,7 @@ struct cmd_arguments
 // Others:
     /* -h - help - not part of the args struct */
     /* -v - verbose - not implementet yet */
-    /* -t */ int16_t threads = 1;
+    /* -t */ int16_t threads = 1;   // analysis and clustering threads, see decompression_threads below
 // Methods:
     /* -d */ std::vector<detection_methods> methods{cigar_string, split_read, read_pairs, read_depth}; // default: all
     /* -c */ clustering_methods clustering_method{hierarchical_clustering};          // default: hierarchical clustering
@@ -30,9 +30,26 @@ struct cmd_arguments
     /* -q */ int32_t min_qual = 1;
 // Clustering specifications:
     /* -w */ double hierarchical_clustering_cutoff = 10;
+    /* --compaction_tolerance */ int32_t compaction_tolerance = 0;
     /* x? */
 // Refinement specifications:
     /* y, z? */
+// Parallelization:
+    /* -g */ int32_t region_size = 10000000;
+    /* --decompression_threads */ int16_t decompression_threads = 1;
+// Memory usage:
+    /* --streaming */ bool streaming = false;
+    /* --by_chromosome */ bool by_chromosome = false;
+    /* --max_memory */ int32_t max_memory = 0;
+// Junction store:
+    /* --junction_store */ std::filesystem::path junction_store_path{};
+    /* --input_junction_store */ std::filesystem::path input_junction_store_path{};
+    /* --cluster_checkpoint */ std::filesystem::path cluster_checkpoint_path{};
+    /* --resume_from */ resume_stages resume_from{no_resume};
+// Parameter sweep:
+    /* --sweep */ std::vector<std::string> sweep{};
+    /* --sweep_separately */ bool sweep_separately = false;
+    /* --sweep_output_directory */ std::filesystem::path sweep_output_directory{};
 };
 
 void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments & args);
@@ -45,7 +62,7 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
  *                   **args.alignment_long_reads_file_path** - long reads input file, path to the sam/bam file\n
  *                   **args.output_file_path** output file - path for the VCF file - *default: standard output*\n
  *                   **args.vcf_sample_name - Name of the sample for the vcf header line*\n
- *                   **args.threads - The number of decompression threads used for reading BAM files.*\n
+ *                   **args.threads - The number of threads used for the junction detection and the clustering.*\n
  *                   **args.methods** - list of methods for detecting junctions
  *                      (1: cigar_string, 2: split_read, 3: read_pairs, 4: read_depth) - *default: all methods*\n
  *                   **args.clustering_method** - method for clustering junctions
@@ -68,7 +85,34 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
  *                   **args.min_qual** - minimum quality (amount of supporting reads) of a structural variant
  *                                       (expected to be non-negative) - *default: 1 supporting read*\n
  *                   **args.hierarchical_clustering_cutoff** - distance cutoff for the hierarchical clustering
- *                                                             (expected to be non-negative) - *default: 10*
+ *                                                             (expected to be non-negative) - *default: 10*\n
+ *                   **args.compaction_tolerance** - tolerance for collapsing nearly identical junctions into weighted
+ *                                                   representatives before the hierarchical clustering, 0 collapses
+ *                                                   identical junctions only
+ *                                                   (expected to be non-negative) - *default: 0*\n
+ *                   **args.region_size** - size of the regions for the parallel junction detection in indexed long
+ *                                          read BAM files, 0 splits by chromosome only
+ *                                          (expected to be non-negative) - *default: 10,000,000 bp*\n
+ *                   **args.decompression_threads** - number of decompression threads used for reading BAM files
+ *                                                    - *default: 1*\n
+ *                   **args.streaming** - cluster the junctions of a long read file while reading it, see
+ *                                        detect_variants_in_alignment_file_streaming() - *default: false*\n
+ *                   **args.by_chromosome** - analyze an indexed long read BAM file one chromosome at a time, see
+ *                                            detect_variants_in_alignment_file_by_chromosome() - *default: false*\n
+ *                   **args.max_memory** - memory budget for the junctions in MiB, see
+ *                                         detect_variants_in_alignment_file_with_memory_limit()
+ *                                         (expected to be non-negative) - *default: 0, no limit*\n
+ *                   **args.junction_store_path** - path of the optional binary junction store of the sorted
+ *                                                  junctions, see write_junction_store()\n
+ *                   **args.input_junction_store_path** - path of a binary junction store to cluster instead of the
+ *                                                        alignment files, see detect_variants_in_junction_store()\n
+ *                   **args.cluster_checkpoint_path** - path of the optional binary cluster checkpoint of the clusters,
+ *                                                      see write_cluster_checkpoint()\n
+ *                   **args.resume_from** - stage to resume a previous run from, whose junction store is read from
+ *                                          `args.input_junction_store_path` and whose cluster checkpoint is read
+ *                                          from `args.cluster_checkpoint_path` - *default: no_resume*\n
+ *                   **args.sweep**, **args.sweep_separately**, **args.sweep_output_directory** - parameter sweep, see
+ *                                   detect_variants_in_alignment_file_sweep()
  *
  *
  * \details Detects novel junctions from read alignment records using different detection methods.
@@ -79,4 +123,86 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
  */
 void detect_variants_in_alignment_file(cmd_arguments const & args);
 
+/*! \brief Detects genomic variants in a coordinate-sorted long read alignment file (sam/bam) like
+ *         detect_variants_in_alignment_file(), but clusters the junctions and outputs their variants while reading.
+ *
+ * \param[in] args - command line arguments, see detect_variants_in_alignment_file()
+ *
+ * \details The junctions are collected in a junction_window, which releases them in batches of complete partitions
+ *          once their first mates have fallen more than `max_var_length + max_overlap` bases behind the current
+ *          alignment. Each batch is clustered and its variants are output right away, and the inserted sequences and
+ *          read names of the output junctions are freed in the global junction arena (see
+ *          junction_window::compact_arena()), so the memory grows with the local coverage instead of the genome size.
+ *          The sequences are output in the order of the alignment file. Junctions arriving after their part of the
+ *          genome was released (e.g. the first mates of translocations on sequences which were already processed)
+ *          are clustered separately at the end. All other clusters are identical to the ones of
+ *          detect_variants_in_alignment_file().
+ */
+void detect_variants_in_alignment_file_streaming(cmd_arguments const & args);
+
+/*! \brief Detects genomic variants in an indexed long read BAM file like detect_variants_in_alignment_file(), but
+ *         runs the detection, the clustering and the output one chromosome at a time.
+ *
+ * \param[in] args - command line arguments, see detect_variants_in_alignment_file()
+ *
+ * \details The chromosomes are analyzed in the order of the BAM header with the index, see
+ *          detect_junctions_in_long_reads_bam_file_by_chromosome(). The junctions are collected in a
+ *          contig_pair_buffer: the junctions within a chromosome are clustered and output right after the chromosome
+ *          and freed before the next one, together with their inserted sequences and read names in the global junction
+ *          arena (see contig_pair_buffer::compact_arena()). The junctions between two chromosomes are held until both
+ *          chromosomes have been analyzed. Thus, the memory grows with the junctions of the largest chromosome plus
+ *          the held junctions between chromosomes instead of the genome size. Junctions arriving after their pair of
+ *          chromosomes was output are clustered separately at the end. All other clusters are identical to the ones
+ *          of detect_variants_in_alignment_file().
+ */
+void detect_variants_in_alignment_file_by_chromosome(cmd_arguments const & args);
+
+/*! \brief Detects genomic variants in an alignment file (sam/bam) like detect_variants_in_alignment_file(), but keeps
+ *         the junctions within the memory budget `args.max_memory` (in MiB).
+ *
+ * \param[in] args - command line arguments, see detect_variants_in_alignment_file()
+ *
+ * \details The junctions are passed to an external_junction_sorter while they are detected, which spills sorted runs
+ *          to temporary files when the budget is exceeded. Instead of sorting all junctions in memory, the runs are
+ *          merged and the merged junctions are clustered and output in batches of complete partitions. Thus, the
+ *          clusters are identical to the ones of detect_variants_in_alignment_file(). The long read junctions are
+ *          detected by a single thread, the short read junctions are detected before they are passed to the sorter.
+ */
+void detect_variants_in_alignment_file_with_memory_limit(cmd_arguments const & args);
+
+/*! \brief Detects genomic variants in a long read alignment file (sam/bam) like detect_variants_in_alignment_file()
+ *         for every parameter combination of a parameter sweep, reading the file only once.
+ *
+ * \param[in] args - command line arguments, see detect_variants_in_alignment_file() and
+ *                   parameter_sweep_combinations() for the swept parameters
+ *
+ * \details The junctions are detected once for every distinct pair of min_var_length and max_overlap of the
+ *          combinations, in a single pass over the file (see detect_junctions_in_long_reads_sam_file()). The junctions
+ *          are clustered at all distinct values of hierarchical_clustering_cutoff at once: the dendrogram of every
+ *          partition is computed once up to the largest cutoff and cut at the others (see
+ *          hierarchical_clustering_method()). The combinations, which only differ in max_var_length,
+ *          max_tol_inserted_length or min_qual, share their clusters and only run find_and_output_variants(). The VCF
+ *          file of every combination is identical to the output of detect_variants_in_alignment_file() with its
+ *          parameters, up to clusters of junctions with equal distances, which may be merged in another order for a
+ *          cutoff smaller than the largest one.
+ */
+void detect_variants_in_alignment_file_sweep(cmd_arguments const & args);
+
+/*! \brief Detects genomic variants in the junctions of a binary junction store written by a previous run of
+ *         detect_variants_in_alignment_file(), without analyzing the alignment files again.
+ *
+ * \param[in] args - command line arguments, see detect_variants_in_alignment_file()
+ *
+ * \details The store `args.input_junction_store_path` is mapped into memory (see junction_store), so its sorted
+ *          junctions are available without parsing. Only the partitioning, the clustering and the output are run, so
+ *          the clustering parameters can be changed quickly. The clusters and variants are identical to the ones of
+ *          detect_variants_in_alignment_file() with the same parameters.
+ *          A run resumed with `args.resume_from` clusters the junctions of the junction store again
+ *          (resume_from_junctions) or reads the clusters of the cluster checkpoint (resume_from_clusters), which has
+ *          to belong to the junction store, so that only find_and_output_variants() is run again, e.g. with other
+ *          values of min_qual, max_var_length or max_tol_inserted_length. The value of min_var_length of the resumed
+ *          run only filters the output, the junctions were detected with the one of the previous run.
+ */
+void detect_variants_in_junction_store(cmd_arguments const & args);
+
 int main(int argc, char ** argv);
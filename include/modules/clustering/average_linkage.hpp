@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/*! \brief A merge of two clusters, each given by one of its objects, at their average distance `height`. */
+struct linkage_merge
+{
+    uint32_t lhs;
+    uint32_t rhs;
+    double height;
+};
+
+/*! \brief Buffers of average_linkage(), which can be reused for many calls to avoid allocating the distance matrix and
+ *         the results for every partition.
+ */
+struct average_linkage_buffers
+{
+    // Condensed distance matrix (upper triangle of the full distance matrix, row by row), filled by the caller.
+    std::vector<double> distances{};
+    // The merges, sorted by height.
+    std::vector<linkage_merge> merges{};
+    // The cluster label of every object, numbered consecutively from 0.
+    std::vector<int> labels{};
+
+    // Internal state of the nearest neighbor chain.
+    std::vector<uint32_t> sizes{};
+    std::vector<uint8_t> states{};
+    std::vector<uint32_t> chain{};
+    std::vector<uint32_t> parents{};
+};
+
+/*! \brief Cluster objects by average linkage and stop before the first merge at a distance of at least the cutoff.
+ *         The result is the same as cutting the full average linkage dendrogram (e.g. of hclust_fast()) at
+ *         `clustering_cutoff`, up to the order of merges with equal distances.
+ *
+ * \param[in]     num_objects       - number of objects, `buffers.distances` holds their condensed distance matrix
+ * \param[in]     clustering_cutoff - two clusters are merged only if their average distance is smaller than the cutoff
+ * \param[in,out] buffers           - the distance matrix as input, which is overwritten, and `merges` and `labels` as
+ *                                    output
+ * \param[in]     weights           - number of identical objects represented by each object, e.g. the support of
+ *                                    compacted junctions, or empty if all objects have a weight of 1
+ *
+ * \details The clusters are merged along nearest neighbor chains, as average linkage is reducible. A cluster without a
+ *          neighbor closer than the cutoff is never merged again, so it is excluded from all further nearest neighbor
+ *          searches. The merges above the cutoff, which are cut off from the dendrogram anyway, are not computed.
+ *          An object of weight k starts as a cluster of k objects at distance 0, which is the same as merging k
+ *          identical objects first.
+ */
+void average_linkage(size_t const num_objects,
+                     double const clustering_cutoff,
+                     average_linkage_buffers & buffers,
+                     std::span<uint32_t const> const weights = {});
+
+/*! \brief Cut a dendrogram at `clustering_cutoff`: objects connected by merges with a height smaller than the cutoff
+ *         get the same label.
+ *
+ * \param[in] num_objects       - number of objects
+ * \param[in] merges            - the merges of the dendrogram in any order, e.g. of average_linkage() with the largest
+ *                                cutoff of interest
+ * \param[in] clustering_cutoff - height at which the dendrogram is cut
+ *
+ * \returns the cluster label of every object, numbered consecutively from 0 in the order of the first objects of the
+ *          clusters.
+ *
+ * \details As average linkage has no inversions, a merge below the cutoff only joins clusters formed by merges below
+ *          the cutoff. Cutting the dendrogram computed up to a larger cutoff therefore gives the same clusters as
+ *          stopping the average linkage at `clustering_cutoff`, up to the order of merges with equal distances.
+ */
+std::vector<int> cut_dendrogram(size_t const num_objects,
+                                std::span<linkage_merge const> const merges,
+                                double const clustering_cutoff);
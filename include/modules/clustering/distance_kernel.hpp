@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief The coordinates of the junctions of one partition as structure of arrays. All junctions of a partition
+ *         connect the same reference sequences with the same orientations, so their distance only depends on these.
+ */
+struct junction_coordinates
+{
+    std::vector<int32_t> mate1_positions{};
+    std::vector<int32_t> mate2_positions{};
+    std::vector<int32_t> inserted_sizes{};
+};
+
+/*! \brief Implementations of the distance computation, from the slowest to the fastest. */
+enum class distance_kernel
+{
+    scalar,     //!< portable loop
+    sse2,       //!< 4 distances at a time, x86 only
+    avx2        //!< 8 distances at a time, x86 CPUs with AVX2 only
+};
+
+/*! \brief The fastest distance kernel supported by the CPU, detected once at runtime. */
+distance_kernel best_distance_kernel();
+
+/*! \brief Store the coordinates of the junctions of one partition, reusing the memory of `coordinates`.
+ *
+ * \param[in]  partition   - junctions with the same sequence names and orientations of their mates
+ * \param[out] coordinates - the mate positions and inserted sizes of the junctions
+ */
+void load_coordinates(std::span<Junction const> const partition, junction_coordinates & coordinates);
+
+/*! \brief Compute the condensed distance matrix (upper triangle of the full distance matrix, row by row) of the
+ *         junctions of one partition. The distances are the same as of junction_distance().
+ *
+ * \param[in]  coordinates - the coordinates of the junctions
+ * \param[out] distances   - the condensed distance matrix, resized to the number of pairs
+ * \param[in]  kernel      - the implementation, it has to be supported by the CPU
+ */
+void condensed_distances(junction_coordinates const & coordinates,
+                         std::vector<double> & distances,
+                         distance_kernel const kernel = best_distance_kernel());
@@ -1,27 +1,49 @@
 #pragma once
 
+#include <cstdint>    // for int32_t
+#include <cstdlib>    // for std::abs
+#include <span>
+
 #include "structures/cluster.hpp"   // for class Cluster
 
+/*! \brief Returns true if two breakends, which are neighbors in sorted order, belong to different partitions: they
+ *         are on different sequences, have different orientations or are more than 50bp apart.
+ *
+ * \param[in] previous - the smaller breakend
+ * \param[in] current  - the next breakend
+ */
+inline bool is_partition_border(Breakend const & previous, Breakend const & current)
+{
+    return current.seq_id != previous.seq_id ||
+           current.orientation != previous.orientation ||
+           std::abs(current.position - previous.position) > 50;
+}
+
 /*! \brief Partition junctions by their distance on the reference genome.
  *         The returned partitions contain junctions meeting the following criteria:
  *         a) all junctions in a partition connect the same reference sequences,
  *         b) all junctions in a partition have the same orientations, and
  *         c) the distance between corresponding mates of two neighboring junctions is at most 50bp.
- *         The junctions in each of the returned partitions are sorted even though
- *         the partitions themselves are not returned in a particular order.
+ *         The junctions are reordered in place, so that each partition is a contiguous and sorted range of
+ *         `junctions`, even though the partitions themselves are not returned in a particular order.
+ *
+ * \param[in,out] junctions - a vector of junctions (needs to be sorted)
  *
- * \param[in] junctions - a vector of junctions (needs to be sorted)
+ * \returns the partitions as spans into `junctions`, valid until `junctions` is modified.
  */
-std::vector<std::vector<Junction>> partition_junctions(std::vector<Junction> const & junctions);
+std::vector<std::span<Junction>> partition_junctions(std::vector<Junction> & junctions);
 
 /*! \brief Sub-partition an existing partition based on the second mate of each junction.
- *         The junctions in each of the returned sub-partitions are sorted even though
- *         the sub-partitions themselves are not returned in a particular order.
+ *         The junctions are reordered in place, so that each sub-partition is a contiguous and sorted range of
+ *         `partition`, even though the sub-partitions themselves are not returned in a particular order.
+ *
+ * \param[in,out] partition - a partition of junctions
  *
- * \param[in] partition - a partition (i.e. a vector) of junctions (needs to be sorted
- *                        by their second mates)
+ * \returns the sub-partitions as spans into `partition`.
+ *
+ * \details The junctions are sorted through an array of indices, so that every junction is moved at most twice.
  */
-std::vector<std::vector<Junction>> split_partition_based_on_mate2(std::vector<Junction> const & partition);
+std::vector<std::span<Junction>> split_partition_based_on_mate2(std::span<Junction> const partition);
 
 /*! \brief Compute the distance between two junctions.
  *         For two junctions that connect the same reference sequences and have the same
@@ -37,11 +59,42 @@ int junction_distance(Junction const & lhs, Junction const & rhs);
 /*! \brief Cluster junctions by an hierarchical clustering method.
  *         The returned clusters and the junctions in each returned cluster are sorted.
  *
- * \param[in] junctions - a vector of junctions (needs to be sorted)
+ * \param[in] junctions - a vector of junctions (needs to be sorted), partitioned in place and moved into the clusters
  * \param[in] clustering_cutoff - distance cutoff for clustering
+ * \param[in] threads - number of threads clustering the partitions in parallel, the result does not depend on it
+ * \param[in] compaction_tolerance - junctions of a partition whose coordinates differ by at most this value are
+ *                                   clustered as one weighted junction, see compact_junctions()
  *
- * \details For the algorithms we use the library hclust.
+ * \details The identical junctions of each partition are collapsed into weighted representatives first, which does
+ *          not change the clusters. With a positive `compaction_tolerance`, nearly identical junctions are collapsed
+ *          as well, which may change the clusters. The cluster sizes and averages are computed from all members.
+ *          The partitions are clustered by average_linkage(), which stops at the cutoff, with the same result as the
+ *          library hclust. Partitions of more than 200 representatives are clustered with sparse_average_linkage()
+ *          instead, which keeps all junctions without the quadratic distance matrix.
  * \see https://lionel.kr.hs-niederrhein.de/~dalitz/data/hclust/ (last access 01.06.2021).
  */
-std::vector<Cluster> hierarchical_clustering_method(std::vector<Junction> const & junctions,
-                                                    double clustering_cutoff);
+std::vector<Cluster> hierarchical_clustering_method(std::vector<Junction> junctions,
+                                                    double clustering_cutoff,
+                                                    size_t const threads = 1,
+                                                    int32_t const compaction_tolerance = 0);
+
+/*! \brief Cluster junctions by an hierarchical clustering method at several cutoffs at once.
+ *         The returned clusters of each cutoff and the junctions in each cluster are sorted.
+ *
+ * \param[in] junctions - a vector of junctions (needs to be sorted), partitioned in place and copied into the clusters
+ * \param[in] clustering_cutoffs - distance cutoffs for clustering
+ * \param[in] threads - number of threads clustering the partitions in parallel, the result does not depend on it
+ * \param[in] compaction_tolerance - see hierarchical_clustering_method()
+ *
+ * \returns the clusters of every cutoff, in the order of `clustering_cutoffs`.
+ *
+ * \details The clusters of every cutoff are the same as those of hierarchical_clustering_method() with this cutoff,
+ *          up to the order of merges with equal distances. The junctions are partitioned and compacted once. The
+ *          distance matrix and the dendrogram of each partition are computed once up to the largest cutoff and then
+ *          cut at every cutoff with cut_dendrogram(), so the cost is close to a single clustering at the largest
+ *          cutoff.
+ */
+std::vector<std::vector<Cluster>> hierarchical_clustering_method(std::vector<Junction> junctions,
+                                                                 std::vector<double> const & clustering_cutoffs,
+                                                                 size_t const threads = 1,
+                                                                 int32_t const compaction_tolerance = 0);
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t, int32_t
+#include <span>
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief Junctions collapsed into weighted representatives. The junctions themselves are not copied, all members are
+ *         referred to by their index into the compacted junctions.
+ *
+ * \details The members of representative `i` are `members[member_offsets[i]]` to `members[member_offsets[i + 1] - 1]`.
+ *          The first member is the representative itself. The read names of the members are the reads supporting the
+ *          representative.
+ */
+struct compacted_junctions
+{
+    std::vector<uint32_t> member_offsets{0};
+    std::vector<uint32_t> members{};
+
+    //! \brief Returns the number of representatives.
+    size_t size() const
+    {
+        return member_offsets.size() - 1;
+    }
+
+    //! \brief Returns the index of the representative `i`.
+    uint32_t representative(size_t const i) const
+    {
+        return members[member_offsets[i]];
+    }
+
+    //! \brief Returns the number of junctions collapsed into the representative `i`, i.e. its support.
+    uint32_t weight(size_t const i) const
+    {
+        return member_offsets[i + 1] - member_offsets[i];
+    }
+
+    //! \brief Returns the indices of the junctions collapsed into the representative `i`.
+    std::span<uint32_t const> members_of(size_t const i) const
+    {
+        return std::span{members}.subspan(member_offsets[i], weight(i));
+    }
+};
+
+/*! \brief Collapse junctions with identical breakends and inserted sizes, whose distance (see junction_distance()) is
+ *         0, into weighted representatives.
+ *
+ * \param[in] junctions - the junctions to compact
+ * \param[in] tolerance - if positive, junctions whose mate positions and inserted size each differ by at most
+ *                        `tolerance` from a representative are collapsed into it as well
+ *
+ * \returns the representatives in the order of their breakends and inserted sizes. The members of a representative
+ *          follow in this order too, junctions with equal breakends and inserted sizes in the order of `junctions`.
+ *
+ * \details With a tolerance, the junctions are assigned greedily in sorted order to the first representative in reach,
+ *          so two members of a representative can be up to `2 * tolerance` apart in each coordinate.
+ */
+compacted_junctions compact_junctions(std::span<Junction const> const junctions, int32_t const tolerance = 0);
+
+/*! \brief Collapse equal junctions (see operator==), which includes their inserted sequences, into weighted
+ *         representatives.
+ *
+ * \param[in] junctions - the junctions to compact (need to be sorted)
+ *
+ * \returns the representatives in the order of the junctions.
+ */
+compacted_junctions compact_equal_junctions(std::span<Junction const> const junctions);
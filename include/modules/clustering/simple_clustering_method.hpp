@@ -2,7 +2,7 @@
 
 #include "structures/cluster.hpp"   // for class Cluster
 
-/*! \brief This method clusters junctions by merging identical junctions into a single cluster object.
+/*! \brief This method clusters junctions by merging identical neighboring junctions into a single cluster object.
  *
  * \param[in]       junctions   - a vector of junctions
  */
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <span>
+#include <vector>
+
+#include "modules/clustering/average_linkage.hpp"   // for linkage_merge
+#include "modules/clustering/distance_kernel.hpp"   // for junction_coordinates
+#include "structures/junction.hpp"                  // for class Junction
+
+/*! \brief Cluster the junctions of one partition by average linkage without computing the full distance matrix.
+ *         The result is the same as cutting the average linkage dendrogram of all junctions at
+ *         `clustering_cutoff`, up to the order of merges with equal distances.
+ *
+ * \param[in] partition         - junctions with the same sequence names and orientations of their mates, so that
+ *                                their distance is the sum of the position and inserted size differences
+ * \param[in] clustering_cutoff - two clusters are merged only if their average distance is smaller than the cutoff
+ *
+ * \returns the cluster label of each junction.
+ *
+ * \details Identical junctions are collapsed into one weighted point first. Only pairs of points closer than the
+ *          cutoff are stored, as two clusters can only have an average distance below the cutoff if at least one pair
+ *          of their members is closer than the cutoff. For the clusters connected by such pairs, the exact sum of the
+ *          distances between their members is updated on every merge, and the clusters are merged along nearest
+ *          neighbor chains. Memory and runtime therefore grow with the number of distinct junctions and close pairs
+ *          instead of quadratically with the partition size.
+ */
+std::vector<int> sparse_average_linkage(std::span<Junction const> const partition, double const clustering_cutoff);
+
+/*! \brief Cluster weighted junctions of one partition by average linkage like sparse_average_linkage(), e.g. the
+ *         representatives of compact_junctions().
+ *
+ * \param[in] coordinates       - the coordinates of the junctions
+ * \param[in] weights           - number of identical junctions represented by each junction, or empty if all
+ *                                junctions have a weight of 1
+ * \param[in] clustering_cutoff - two clusters are merged only if their average distance is smaller than the cutoff
+ *
+ * \returns the cluster label of each junction.
+ */
+std::vector<int> sparse_average_linkage(junction_coordinates const & coordinates,
+                                        std::span<uint32_t const> const weights,
+                                        double const clustering_cutoff);
+
+
+/*! \brief Cluster weighted junctions of one partition by average linkage like sparse_average_linkage() and return the
+ *         merges as well, so that the dendrogram can be cut at smaller cutoffs by cut_dendrogram().
+ *
+ * \param[in]  coordinates       - the coordinates of the junctions
+ * \param[in]  weights           - number of identical junctions represented by each junction, or empty if all
+ *                                 junctions have a weight of 1
+ * \param[in]  clustering_cutoff - two clusters are merged only if their average distance is smaller than the cutoff
+ * \param[out] merges            - the merges below the cutoff, each given by one junction of both clusters, in the
+ *                                 order they were found. Identical junctions are merged at height 0.
+ *
+ * \returns the cluster label of each junction.
+ */
+std::vector<int> sparse_average_linkage(junction_coordinates const & coordinates,
+                                        std::span<uint32_t const> const weights,
+                                        double const clustering_cutoff,
+                                        std::vector<linkage_merge> & merges);
\ No newline at end of file
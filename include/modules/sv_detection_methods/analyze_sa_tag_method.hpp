@@ -1,5 +1,8 @@
 #pragma once
 
+#include <span>
+#include <string_view>
+
 #include "iGenVar.hpp"                          // for struct cmd_arguments
 #include "structures/aligned_segment.hpp"       // for struct AlignedSegment
 #include "structures/junction.hpp"              // for class Junction
@@ -14,11 +17,38 @@
 template <class Container>
 void split_string(std::string const & str, Container & cont, char const delim = ' ');
 
+/*! \brief Parses one element of an SA tag (`rname,pos,strand,CIGAR,mapQ,NM`) into an existing
+ *         [aligned_segment](\ref AlignedSegment), whose memory is reused. Returns false if the element is invalid.
+ *
+ * \param[in]       sa_entry            - one element of an SA tag, without the terminating ';'
+ * \param[in, out]  aligned_segment     - the [aligned_segment](\ref AlignedSegment) to overwrite
+ *
+ * \details Elements with a wrong amount of fields or an invalid position, CIGAR string or mapping quality are
+ *          reported on the debug stream. Elements with an invalid strand are skipped silently. The position and the
+ *          mapping quality are parsed like std::stoi, the NM field is not used.
+ */
+bool parse_aligned_segment(std::string_view const sa_entry, AlignedSegment & aligned_segment);
+
+/*! \brief Parses the SA tag of a chimeric/split-aligned read into `aligned_segments[first]`,
+ *         `aligned_segments[first + 1]`, ... and returns the index behind the last parsed segment.
+ *
+ * \param[in]       sa_string           - "SA" tag string
+ * \param[in, out]  aligned_segments    - buffer of [aligned_segments](\ref AlignedSegment)
+ * \param[in]       first               - index of the first segment to write
+ *
+ * \details Existing elements are overwritten and their memory is reused, the vector only grows if it holds too few
+ *          elements. Elements behind the returned index are left in an unspecified state. Thus, a buffer which is
+ *          reused for all reads does not allocate memory once it has grown to the longest SA tag.
+ */
+size_t parse_sa_tag(std::string_view const sa_string,
+                    std::vector<AlignedSegment> & aligned_segments,
+                    size_t const first);
+
 /*! \brief Parse the SA tag from the SAM/BAM alignment of a chimeric/split-aligned read. Build
  *         [aligned_segments](\ref AlignedSegment), one for each alignment segment of the read.
  *
  * \param[in]       sa_string           - "SA" tag string
- * \param[in, out]  aligned_segments    - vector of [aligned_segments](\ref AlignedSegment)
+ * \param[in, out]  aligned_segments    - vector of [aligned_segments](\ref AlignedSegment), the segments are appended
  *
  * \details The SA tag describes the alignments of a chimeric read and is like a small SAM within a SAM
  *          file:
@@ -28,24 +58,24 @@ void split_string(std::string const & str, Container & cont, char const delim =
  *          Each element (in parentheses) represents one alignment segment of the chimeric alignment formatted as
  *          a colon-delimited list.
  *          We add all segments to our candidate list `aligned_segments` and examine them in the following function
- *          `analyze_aligned_segments()`.
+ *          `analyze_aligned_segments()`. Invalid elements are skipped, see parse_aligned_segment().
  *
  *          For more information about this tag, see the
  *          [Map Optional Fields Specification](https://samtools.github.io/hts-specs/SAMtags.pdf)
  *          (last access 09.04.2021).
  */
-void retrieve_aligned_segments(std::string const & sa_string, std::vector<AlignedSegment> & aligned_segments);
+void retrieve_aligned_segments(std::string_view const sa_string, std::vector<AlignedSegment> & aligned_segments);
 
 /*! \brief Build junctions out of aligned_segments.
  *
- * \param[in]       aligned_segments    - vector of [aligned_segments](\ref AlignedSegment)
+ * \param[in]       aligned_segments    - sorted [aligned_segments](\ref AlignedSegment)
  * \param[in, out]  junctions           - vector for storing junctions
  * \param[in, out]  query_sequence      - SEQ field of the SAM/BAM file
  * \param[in]       read_name           - QNAME field of the SAM/BAM file
  * \param[in]       min_length          - minimum length of variants to detect (expected to be non-negative)
  * \param[in]       max_overlap         - maximum overlap between alignment segments (expected to be non-negative)
  */
-void analyze_aligned_segments(std::vector<AlignedSegment> const & aligned_segments,
+void analyze_aligned_segments(std::span<AlignedSegment const> const aligned_segments,
                               std::vector<Junction> & junctions,
                               seqan3::dna5_vector const & query_sequence,
                               std::string const & read_name,
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <span>
+#include <string_view>
+
 #include <seqan3/alphabet/cigar/cigar.hpp>
 
 #include "structures/breakend.hpp"          // for strand
@@ -12,40 +15,135 @@
  * \param pos           - start position of the alignment
  * \param mapq          - mapping quality
  * \param cig           - cigar string of the alignment
+ *
+ * \details The coordinates derived from the CIGAR string are computed once by the constructor and by assign(), so the
+ *          getters, which are called in every comparison while sorting the segments, do not walk the CIGAR string. The
+ *          members can only be changed through assign() to keep the coordinates valid.
  */
 struct AlignedSegment
 {
-    strand orientation;
-    std::string ref_name;
-    int32_t pos;
-    int32_t mapq;
-    std::vector<seqan3::cigar> cig;
+private:
+    strand orientation{};
+    std::string ref_name{};
+    int32_t pos{};
+    int32_t mapq{};
+    std::vector<seqan3::cigar> cig{};
+    int32_t reference_end{-1};
+    int32_t left_soft_clip{0};
+    int32_t right_soft_clip{0};
+    int32_t query_length{0};
+
+    //! \brief Computes the coordinates derived from the CIGAR string in a single pass.
+    void update_coordinates();
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    AlignedSegment()                                    = default; //!< Defaulted.
+    AlignedSegment(AlignedSegment const &)              = default; //!< Defaulted.
+    AlignedSegment(AlignedSegment &&)                   = default; //!< Defaulted.
+    AlignedSegment & operator=(AlignedSegment const &)  = default; //!< Defaulted.
+    AlignedSegment & operator=(AlignedSegment &&)       = default; //!< Defaulted.
+    ~AlignedSegment()                                   = default; //!< Defaulted.
+
+    AlignedSegment(strand the_orientation,
+                   std::string the_ref_name,
+                   int32_t the_pos,
+                   int32_t the_mapq,
+                   std::vector<seqan3::cigar> the_cig) : orientation{the_orientation},
+                                                         ref_name{std::move(the_ref_name)},
+                                                         pos{the_pos},
+                                                         mapq{the_mapq},
+                                                         cig{std::move(the_cig)}
+    {
+        update_coordinates();
+    }
+    //!\}
+
+    /*! \brief Overwrites all members, reusing the memory of the reference name and the CIGAR string, and updates the
+     *         coordinates derived from the CIGAR string.
+     */
+    void assign(strand const the_orientation,
+                std::string_view const the_ref_name,
+                int32_t const the_pos,
+                int32_t const the_mapq,
+                std::span<seqan3::cigar const> const the_cig)
+    {
+        orientation = the_orientation;
+        ref_name.assign(the_ref_name);
+        pos = the_pos;
+        mapq = the_mapq;
+        cig.assign(the_cig.begin(), the_cig.end());
+        update_coordinates();
+    }
+
+    strand get_orientation() const
+    {
+        return orientation;
+    }
+
+    std::string const & get_ref_name() const
+    {
+        return ref_name;
+    }
+
+    int32_t get_mapq() const
+    {
+        return mapq;
+    }
+
+    std::vector<seqan3::cigar> const & get_cigar() const
+    {
+        return cig;
+    }
 
     //! \brief Returns the reference position of the first aligned based.
-    int32_t get_reference_start() const;
+    int32_t get_reference_start() const
+    {
+        return pos;
+    }
 
     //! \brief Returns the reference position of the last aligned based.
-    int32_t get_reference_end() const;
+    int32_t get_reference_end() const
+    {
+        return reference_end;
+    }
 
-    int32_t get_left_soft_clip() const;
+    int32_t get_left_soft_clip() const
+    {
+        return left_soft_clip;
+    }
 
-    int32_t get_right_soft_clip() const;
+    int32_t get_right_soft_clip() const
+    {
+        return right_soft_clip;
+    }
 
-    int32_t get_query_start() const;
+    int32_t get_query_start() const
+    {
+        return (orientation == strand::forward) ? left_soft_clip : right_soft_clip;
+    }
 
-    int32_t get_query_length() const;
+    int32_t get_query_length() const
+    {
+        return query_length;
+    }
 
-    int32_t get_query_end() const;
+    int32_t get_query_end() const
+    {
+        return query_length - ((orientation == strand::forward) ? right_soft_clip : left_soft_clip);
+    }
 };
 
 template <typename stream_t>
 inline constexpr stream_t operator<<(stream_t && stream, AlignedSegment const & a)
 {
-    stream << a.ref_name << ";"
+    stream << a.get_ref_name() << ";"
            << a.get_reference_start() << "-" << a.get_reference_end() << ";"
            << a.get_query_start() << "-" << a.get_query_end() << ";"
-           << ((a.orientation == strand::forward) ? "+" : "-") << ";"
-           << a.mapq;
+           << ((a.get_orientation() == strand::forward) ? "+" : "-") << ";"
+           << a.get_mapq();
     return stream;
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+
+#include "structures/sequence_dictionary.hpp"   // for sequence_id_t
 
 enum struct strand : uint8_t
 {
@@ -10,9 +13,41 @@ enum struct strand : uint8_t
 
 struct Breakend
 {
-    std::string seq_name; // The id of the respective sequence
-    int32_t position;
-    strand orientation;
+    sequence_id_t seq_id{}; // The id of the respective sequence in the global sequence dictionary
+    int32_t position{};
+    strand orientation{};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    constexpr Breakend()                        = default; //!< Defaulted.
+    Breakend(Breakend const &)                  = default; //!< Defaulted.
+    Breakend(Breakend &&)                       = default; //!< Defaulted.
+    Breakend & operator=(Breakend const &)      = default; //!< Defaulted.
+    Breakend & operator=(Breakend &&)           = default; //!< Defaulted.
+    ~Breakend()                                 = default; //!< Defaulted.
+
+    constexpr Breakend(sequence_id_t const the_seq_id,
+                       int32_t const the_position,
+                       strand const the_orientation) : seq_id{the_seq_id},
+                                                       position{the_position},
+                                                       orientation{the_orientation}
+    {}
+
+    //! \brief Adds the sequence name to the global sequence dictionary and stores its id.
+    Breakend(std::string_view const the_seq_name,
+             int32_t const the_position,
+             strand const the_orientation) : Breakend{intern_sequence_name(the_seq_name),
+                                                      the_position,
+                                                      the_orientation}
+    {}
+    //!\}
+
+    //! \brief Returns the name of the respective sequence.
+    std::string const & seq_name() const
+    {
+        return sequence_name(seq_id);
+    }
 
     void flip_orientation()
     {
@@ -30,12 +65,20 @@ struct Breakend
 template <typename stream_t>
 inline constexpr stream_t operator<<(stream_t && stream, Breakend const & b)
 {
-    stream << b.seq_name << '\t'
+    stream << b.seq_name() << '\t'
            << b.position  << '\t'
            << ((b.orientation == strand::forward) ? "Forward" : "Reverse");
     return stream;
 }
 
+/*! \brief Returns true if the sequence name of `lhs` is lexicographically smaller than the one of `rhs`, without
+ *         resolving the names.
+ */
+inline bool seq_name_less(Breakend const & lhs, Breakend const & rhs)
+{
+    return lhs.seq_id != rhs.seq_id && sequence_rank(lhs.seq_id) < sequence_rank(rhs.seq_id);
+}
+
 bool operator<(Breakend const & lhs, Breakend const & rhs);
 
 bool operator==(Breakend const & lhs, Breakend const & rhs);
@@ -1,14 +1,54 @@
 #pragma once
 
+#include <cstdint>    // for int64_t
+#include <span>
 #include <vector>
 
+#include <seqan3/std/filesystem>
+
 #include "structures/junction.hpp"  // for class Junction
 
+struct cmd_arguments;
+
+/*! \brief A set of junctions supporting the same variant.
+ *
+ * \details The summary of the members (average mates, average, minimal and maximal inserted sequence size) is computed
+ *          when the cluster is constructed and updated when members are added, so that the getters are O(1).
+ *          All members are required to have identical sequence names and orientations for their first and for their
+ *          second mate, otherwise a std::runtime_error is thrown.
+ */
 class Cluster
 {
 private:
     std::vector<Junction> members{};
 
+    // Summary of the members, updated by add_to_summary().
+    int64_t sum_mate1_positions{0};
+    int64_t sum_mate2_positions{0};
+    uint64_t sum_inserted_sizes{0};
+    Breakend average_mate1{};
+    Breakend average_mate2{};
+    int32_t average_inserted_size{0};
+    int32_t min_inserted_size{0};
+    int32_t max_inserted_size{0};
+
+    /*! \brief Adds a junction to the summary. Throws a std::runtime_error, without changing the summary, if its
+     *         mates are incompatible with the other members.
+     *
+     * \param[in] junction      - the new member
+     * \param[in] num_members   - number of members including the new one
+     */
+    void add_to_summary(Junction const & junction, size_t const num_members);
+
+    // The cluster checkpoint stores and restores the summaries instead of recomputing them.
+    friend void write_cluster_checkpoint(std::filesystem::path const & path,
+                                         std::span<Cluster const> const clusters,
+                                         std::span<Junction const> const junctions,
+                                         cmd_arguments const & args);
+    friend std::vector<Cluster> read_cluster_checkpoint(std::filesystem::path const & path,
+                                                        std::span<Junction const> const junctions,
+                                                        cmd_arguments const & args);
+
 public:
     /*!\name Constructors, destructor and assignment
      * \{
@@ -20,32 +60,56 @@ public:
     Cluster & operator=(Cluster &&)        = default; //!< Defaulted.
     ~Cluster()                             = default; //!< Defaulted.
 
-    Cluster(std::vector<Junction> members) : members{std::move(members)}
-    {
-
-    }
+    Cluster(std::vector<Junction> members);
     //!\}
 
-    //! \brief Returns the number of members in the cluster.
-    size_t get_cluster_size() const;
+    //! \brief Adds a junction to the cluster and updates the summary.
+    void add_member(Junction const & junction);
+
+    //! \brief Returns the number of members in the cluster, i.e. the number of supporting reads.
+    size_t get_cluster_size() const
+    {
+        return members.size();
+    }
 
     /*! \brief Returns the average first mate of all cluster members.
     *          All cluster members are required to have identical sequence names and orientations for their first mate.
     *          To produce the average, the average first mate's position of all cluster members is computed.
     */
-    Breakend get_average_mate1() const;
+    Breakend const & get_average_mate1() const
+    {
+        return average_mate1;
+    }
 
     /*! \brief Returns the average second mate of all cluster members.
     *          All cluster members are required to have identical sequence names and orientations for their second mate.
     *          To produce the average, the average second mate's position of all cluster members is computed.
     */
-    Breakend get_average_mate2() const;
+    Breakend const & get_average_mate2() const
+    {
+        return average_mate2;
+    }
 
     //! \brief Returns the average length of the inserted sequences of all cluster members.
-    int32_t get_average_inserted_sequence_size() const;
+    int32_t get_average_inserted_sequence_size() const
+    {
+        return average_inserted_size;
+    }
+
+    //! \brief Returns the minimal length of the inserted sequences of all cluster members.
+    int32_t get_min_inserted_sequence_size() const
+    {
+        return min_inserted_size;
+    }
+
+    //! \brief Returns the maximal length of the inserted sequences of all cluster members.
+    int32_t get_max_inserted_sequence_size() const
+    {
+        return max_inserted_size;
+    }
 
     //! \brief Returns the members of the cluster.
-    std::vector<Junction> get_members() const;
+    std::vector<Junction> const & get_members() const;
 };
 
 template <typename stream_t>
@@ -4,16 +4,65 @@
 #include <seqan3/alphabet/views/char_to.hpp>
 #include <seqan3/alphabet/views/complement.hpp>
 #include <seqan3/utility/views/to.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string_view>
 
-#include "structures/breakend.hpp"
+#include "structures/breakend.hpp"          // for class Breakend
+#include "structures/junction_arena.hpp"    // for arena_allocate
 
+/*! \brief A novel adjacency between two breakends, supported by a read.
+ *
+ * \details A junction is a compact, fixed-size object of 48 bytes: the two mates refer to their sequences by id, and the
+ *          inserted sequence (packed with two bases per byte) and the read name are stored in the global junction
+ *          arena. Copying and sorting junctions therefore never allocates.
+ */
 class Junction
 {
 private:
     Breakend mate1{};
     Breakend mate2{};
-    seqan3::dna5_vector inserted_sequence{};
-    std::string read_name{};
+    uint32_t inserted_length{0};
+    uint32_t read_name_length{0};
+    arena_reference inserted_bases{};
+    arena_reference read_name{};
+
+    //! \brief Returns the rank of the base at position `i` of the inserted sequence.
+    uint8_t inserted_base_rank(size_t const i) const
+    {
+        uint8_t const packed = static_cast<uint8_t>(arena_data(inserted_bases)[i / 2]);
+        return (i % 2) ? (packed & 0xF) : (packed >> 4);
+    }
+
+    //! \brief Packs the bases of `sequence` with two bases per byte into the global junction arena.
+    void store_inserted_sequence(auto && sequence)
+    {
+        inserted_length = std::ranges::distance(sequence);
+        if (inserted_length == 0)
+            return;
+        char * data = arena_allocate((inserted_length + 1) / 2, inserted_bases);
+        size_t i = 0;
+        for (seqan3::dna5 const base : sequence)
+        {
+            uint8_t const rank = seqan3::to_rank(base);
+            if (i % 2)
+                data[i / 2] = static_cast<char>(static_cast<uint8_t>(data[i / 2]) | rank);
+            else
+                data[i / 2] = static_cast<char>(rank << 4);
+            ++i;
+        }
+    }
+
+    friend bool operator<(Junction const & lhs, Junction const & rhs);
+    friend bool operator==(Junction const & lhs, Junction const & rhs);
+    friend void write_junction(std::ostream & stream, Junction const & junction);
+    friend bool read_junction(std::istream & stream, Junction & junction);
+    friend void compact_junction_arena(std::span<std::span<Junction> const> const junction_groups);
+    friend class junction_store;
 
 public:
     /*!\name Constructors, destructor and assignment
@@ -29,39 +78,95 @@ public:
     Junction(Breakend the_mate1,
              Breakend the_mate2,
              auto const & the_inserted_sequence,
-             std::string the_read_name) : mate1{std::move(the_mate1)},
-                                          mate2{std::move(the_mate2)},
-                                          read_name{std::move(the_read_name)}
+             std::string_view const the_read_name) : mate1{the_mate1},
+                                                     mate2{the_mate2},
+                                                     read_name_length{static_cast<uint32_t>(the_read_name.size())},
+                                                     read_name{arena_store_read_name(the_read_name)}
     {
-        if ((mate2.seq_name < mate1.seq_name) ||
-            (mate2.seq_name == mate1.seq_name && mate2.position < mate1.position))
+        if (seq_name_less(mate2, mate1) ||
+            (mate2.seq_id == mate1.seq_id && mate2.position < mate1.position))
         {
             std::swap(mate1, mate2);
             mate1.flip_orientation();
             mate2.flip_orientation();
 
-            inserted_sequence = the_inserted_sequence | std::views::reverse | seqan3::views::complement | seqan3::views::to<seqan3::dna5_vector>;
+            store_inserted_sequence(the_inserted_sequence | std::views::reverse | seqan3::views::complement);
         }
         else
         {
-            inserted_sequence = the_inserted_sequence | seqan3::views::to<seqan3::dna5_vector>;
+            store_inserted_sequence(the_inserted_sequence);
         }
     }
     //!\}
 
     //! \brief Returns the first mate of this junction.
-    Breakend get_mate1() const;
+    Breakend const & get_mate1() const
+    {
+        return mate1;
+    }
 
     //! \brief Returns the second mate of this junction.
-    Breakend get_mate2() const;
+    Breakend const & get_mate2() const
+    {
+        return mate2;
+    }
+
+    //! \brief Returns the length of the sequence inserted between the two mates.
+    size_t inserted_size() const
+    {
+        return inserted_length;
+    }
+
+    /*! \brief Returns a view on the sequence inserted between the two mates, which unpacks the bases from the
+    *          junction arena on access.
+    */
+    auto inserted_sequence() const
+    {
+        return std::views::iota(size_t{0}, size_t{inserted_length}) | std::views::transform([this] (size_t const i)
+        {
+            return seqan3::dna5{}.assign_rank(inserted_base_rank(i));
+        });
+    }
 
-    /*! \brief Returns the sequence inserted between the two mates.
+    /*! \brief Returns the first `num_bases` (at most 21) bases of the inserted sequence packed with three bits per base,
+    *          the first base in the most significant bits. The bases are stored with their rank + 1, so that a shorter
+    *          inserted sequence with the same first bases gets a smaller prefix, as in the lexicographical comparison.
+    */
+    uint64_t inserted_sequence_prefix(size_t const num_bases) const
+    {
+        uint64_t prefix = 0;
+        size_t const length = std::min<size_t>(inserted_length, num_bases);
+        if (length == 0)
+            return prefix;
+        char const * data = arena_data(inserted_bases);
+        for (size_t i = 0; i < length; ++i)
+        {
+            uint8_t const packed = static_cast<uint8_t>(data[i / 2]);
+            uint64_t const rank = (i % 2) ? (packed & 0xF) : (packed >> 4);
+            prefix |= (rank + 1) << (3 * (num_bases - 1 - i));
+        }
+        return prefix;
+    }
+
+    //! \brief Returns the bases of the inserted sequence packed with two bases per byte, the first base in the high bits.
+    std::string_view packed_inserted_sequence() const
+    {
+        return std::string_view{inserted_length ? arena_data(inserted_bases) : "", (inserted_length + 1) / 2};
+    }
+
+    /*! \brief Returns a copy of the sequence inserted between the two mates.
     *          If the two mates are connected directly, the inserted sequence is empty.
+    *          Use inserted_size() or inserted_sequence() to avoid the allocation.
     */
     seqan3::dna5_vector get_inserted_sequence() const;
 
-    //! \brief Returns the name of the read giving rise to this junction.
-    std::string get_read_name() const;
+    /*! \brief Returns the name of the read giving rise to this junction. The name is stored in the junction arena and
+    *          stays valid until the end of the program.
+    */
+    std::string_view get_read_name() const
+    {
+        return std::string_view{read_name_length ? arena_data(read_name) : "", read_name_length};
+    }
 };
 
 template <typename stream_t>
@@ -69,7 +174,7 @@ inline constexpr stream_t operator<<(stream_t && stream, Junction const & junc)
 {
     stream << junc.get_mate1() << '\t'
            << junc.get_mate2() << '\t'
-           << junc.get_inserted_sequence().size() << '\t'
+           << junc.inserted_size() << '\t'
            << junc.get_read_name();
     return stream;
 }
@@ -96,3 +201,40 @@ bool operator==(Junction const & lhs, Junction const & rhs);
  * \param rhs - right side junction
  */
 bool operator!=(Junction const & lhs, Junction const & rhs);
+
+/*! \brief Writes a junction to a binary stream: the two mates, the lengths of the inserted sequence and the read name,
+ *         followed by the packed inserted sequence and the read name.
+ *
+ * \param[in, out] stream   - binary output stream
+ * \param[in]      junction - the junction to write
+ *
+ * \details The mates are written with the ids of their sequences in the global sequence dictionary and in the native
+ *          byte order, so the junctions can only be read back by the same process, e.g. from temporary files.
+ */
+void write_junction(std::ostream & stream, Junction const & junction);
+
+/*! \brief Reads a junction written by write_junction() and stores its inserted sequence and read name in the global
+ *         junction arena.
+ *
+ * \param[in, out] stream   - binary input stream
+ * \param[out]     junction - the junction read
+ *
+ * \returns false if the stream ended before the junction. Throws a std::runtime_error if the junction is truncated.
+ */
+bool read_junction(std::istream & stream, Junction & junction);
+
+/*! \brief Moves the inserted sequences and read names of the given junctions into new chunks of the global junction
+ *         arena and frees all other chunks, see arena_clear().
+ *
+ * \param[in, out] junction_groups - all junctions which are still used, they refer to the new chunks afterwards
+ *
+ * \details Used by the streaming modes to free the bytes of the junctions which were output already, while the
+ *          junctions they still hold are kept. Must only be called while no other thread uses the arena. Junctions
+ *          which are not in `junction_groups` and junctions of a junction store must not be used anymore.
+ */
+void compact_junction_arena(std::span<std::span<Junction> const> const junction_groups);
+
+/*! \brief The streaming modes compact the global junction arena once it has grown beyond twice the bytes of the
+ *         junctions they hold, but not below this size, so that the copying is amortized.
+ */
+inline constexpr size_t min_arena_compaction_bytes = size_t{16} << 20;
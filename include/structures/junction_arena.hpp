@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <string_view>
+
+/*! \brief Position of a byte sequence in the global junction arena.
+ *
+ * \param chunk     - index of the chunk holding the bytes
+ * \param offset    - offset of the first byte in the chunk
+ */
+struct arena_reference
+{
+    uint32_t chunk{};
+    uint32_t offset{};
+};
+
+/*! \brief Reserves `size` bytes in the global junction arena, which holds the packed inserted sequences and the read
+ *         names of all junctions, and returns a pointer to write them to.
+ *
+ * \details Every thread fills its own chunk of the arena, so allocating does not lock except for taking a new chunk.
+ *          The bytes stay valid until arena_clear() is called, they are never moved.
+ *
+ * \param[in]  size         - number of bytes to reserve
+ * \param[out] reference    - position of the reserved bytes, to be passed to arena_data()
+ */
+char * arena_allocate(size_t const size, arena_reference & reference);
+
+//! \brief Returns a pointer to the bytes at the position `reference` of the global junction arena.
+char const * arena_data(arena_reference const reference);
+
+/*! \brief Stores the read name in the global junction arena. Consecutive calls with the same name from one thread
+ *         (e.g. for all junctions of a read) share the stored name.
+ *
+ * \param[in] read_name - the read name to store
+ *
+ * \returns the position of the stored name.
+ */
+arena_reference arena_store_read_name(std::string_view const read_name);
+
+//! \brief Number of bytes of external memory covered by one chunk of the global junction arena.
+inline constexpr size_t external_chunk_size = size_t{1} << 30;
+
+/*! \brief Adds external memory (e.g. a memory-mapped file) to the global junction arena without copying it, so that
+ *         junctions can refer to the bytes in it.
+ *
+ * \details The memory is covered by consecutive chunks of `external_chunk_size` bytes each, the byte at `offset` is at
+ *          `arena_reference{first_chunk + offset / external_chunk_size, offset % external_chunk_size}`. The arena does
+ *          not own the memory: it has to stay valid while junctions refer to it and it is not freed by arena_clear().
+ *
+ * \param[in] data - the first byte of the external memory
+ * \param[in] size - number of bytes of the external memory
+ *
+ * \returns the index of the first chunk.
+ */
+uint32_t arena_add_external(char const * data, size_t const size);
+
+//! \brief Returns the number of bytes of all chunks of the global junction arena, without external memory.
+size_t arena_allocated_bytes();
+
+/*! \brief Frees all chunks of the global junction arena.
+ *
+ * \details Invalidates the inserted sequences and read names of all junctions. Must only be called while no other
+ *          thread uses the arena and when no junction which is still used refers to it, e.g. after all junctions were
+ *          written to a file (see write_junction()).
+ */
+void arena_clear();
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <span>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief Returns a packed sort key of a breakend: the rank of its sequence name, its orientation and its position.
+ *         Comparing the keys of two breakends gives the same result as comparing the breakends.
+ */
+inline uint64_t breakend_sort_key(Breakend const & breakend)
+{
+    // The sign bit of the position is flipped, so that negative positions are ordered in front of positive ones.
+    return (static_cast<uint64_t>(sequence_rank(breakend.seq_id)) << 33) |
+           (static_cast<uint64_t>(breakend.orientation) << 32) |
+           (static_cast<uint32_t>(breakend.position) ^ 0x80000000u);
+}
+
+/*! \brief Sorts the indices of junctions stably by the junctions.
+ *
+ * \param[in]       junctions   - the junctions to which the indices refer
+ * \param[in, out]  indices     - the indices to sort
+ * \param[in]       threads     - number of threads for large inputs
+ *
+ * \details Each junction gets a packed key of its two mates (see breakend_sort_key()) and of the first bases of its
+ *          inserted sequence. The keys are sorted with a parallel LSD radix sort, which skips the bytes that are equal
+ *          in all keys. Junctions with equal keys and long inserted sequences are then sorted with operator<, so the
+ *          order is the one of std::stable_sort() and does not depend on the number of threads.
+ */
+void sort_junction_indices(std::span<Junction const> const junctions,
+                           std::span<size_t> const indices,
+                           size_t const threads = 1);
+
+/*! \brief Sorts junctions stably, see sort_junction_indices().
+ *
+ * \param[in, out]  junctions   - the junctions to sort
+ * \param[in]       threads     - number of threads for large inputs
+ */
+void sort_junctions(std::span<Junction> const junctions, size_t const threads = 1);
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <cstddef>                  // for size_t
+#include <cstdint>                  // for uint32_t, uint64_t
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief Writes sorted junctions to a binary junction store, which can be loaded again with junction_store.
+ *
+ * \param[in] path                  - path of the junction store
+ * \param[in] junctions             - the junctions to store (need to be sorted)
+ * \param[in] references_lengths    - reference sequence dictionary parsed from \@SQ header lines
+ *
+ * \details The store is versioned and columnar: a header with the offsets of all sections is followed by the contig
+ *          dictionary (names and lengths), one array per junction field (the contigs, positions and orientations of
+ *          the mates, the lengths and offsets of the inserted sequences and read names) and the pools of the packed
+ *          inserted sequences and of the read names. Consecutive junctions of a read share their read name in the
+ *          pool. The numbers are written in the native byte order, which is recorded in the header.
+ *          Throws a std::runtime_error if the file can not be written.
+ */
+void write_junction_store(std::filesystem::path const & path,
+                          std::span<Junction const> const junctions,
+                          std::map<std::string, int32_t> const & references_lengths);
+
+/*! \brief A binary junction store written by write_junction_store(), mapped into memory.
+ *
+ * \details The file is mapped into memory instead of being parsed: the columns are used in place and the packed
+ *          inserted sequences and read names of the junctions refer to the mapped pools, which are added to the global
+ *          junction arena as external memory (see arena_add_external()). The contigs of the store are added to the
+ *          global sequence dictionary. The junctions of the store must therefore not be used after the store is
+ *          destroyed.
+ */
+class junction_store
+{
+private:
+    char const * data{nullptr};
+    size_t file_size{0};
+    size_t num_junctions{0};
+    std::map<std::string, int32_t> store_references_lengths{};
+    // Id in the global sequence dictionary of every contig of the store.
+    std::vector<sequence_id_t> seq_ids{};
+    // First chunks of the pools of the inserted sequences and the read names in the global junction arena.
+    uint32_t inserted_bases_chunk{0};
+    uint32_t read_names_chunk{0};
+
+    // Columns of the junctions, pointing into the mapped file.
+    uint32_t const * mate1_contigs{nullptr};
+    int32_t const * mate1_positions{nullptr};
+    uint32_t const * mate2_contigs{nullptr};
+    int32_t const * mate2_positions{nullptr};
+    uint8_t const * orientations{nullptr};
+    uint32_t const * inserted_lengths{nullptr};
+    uint64_t const * inserted_offsets{nullptr};
+    uint32_t const * read_name_lengths{nullptr};
+    uint64_t const * read_name_offsets{nullptr};
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    junction_store(junction_store const &)              = delete; //!< Deleted.
+    junction_store(junction_store &&)                   = delete; //!< Deleted.
+    junction_store & operator=(junction_store const &)  = delete; //!< Deleted.
+    junction_store & operator=(junction_store &&)       = delete; //!< Deleted.
+
+    /*! \brief Maps a junction store into memory. Throws a std::runtime_error if the file can not be opened or if it is
+     *         not a junction store of this version and byte order.
+     *
+     * \param[in] path - path of the junction store
+     */
+    junction_store(std::filesystem::path const & path);
+
+    //! \brief Unmaps the file.
+    ~junction_store();
+    //!\}
+
+    //! \brief Returns the number of junctions in the store.
+    size_t size() const
+    {
+        return num_junctions;
+    }
+
+    //! \brief Returns the reference sequence dictionary of the alignment files the junctions were detected in.
+    std::map<std::string, int32_t> const & references_lengths() const
+    {
+        return store_references_lengths;
+    }
+
+    //! \brief Returns the junction `i`, without copying its inserted sequence and read name.
+    Junction junction(size_t const i) const;
+
+    //! \brief Returns all junctions of the store, in sorted order.
+    std::vector<Junction> junctions() const;
+};
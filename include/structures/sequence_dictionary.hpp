@@ -0,0 +1,44 @@
+#pragma once
+
+#include <concepts>     // for std::same_as
+#include <cstdint>      // for uint32_t
+#include <string>
+#include <string_view>
+#include <type_traits>  // for std::remove_cvref_t
+#include <vector>
+
+//! \brief Compact id of a sequence (contig) name in the global sequence dictionary.
+using sequence_id_t = uint32_t;
+
+/*! \brief Returns the id of the sequence name `name` and adds it to the global sequence dictionary if it is not known
+ *         yet. Ids are assigned consecutively in the order in which the names are added.
+ *
+ * \details The dictionary is shared by all threads. Looking up a known name does not lock, adding a new name copies
+ *          the lookup tables, so the names should be added in bulk with intern_sequence_names() (e.g. from the \@SQ
+ *          header lines) before the alignments are processed.
+ *
+ * \param[in] name - sequence name, e.g. the RNAME field of a SAM/BAM file
+ */
+sequence_id_t intern_sequence_name(std::string_view const name);
+
+/*! \brief Adds all sequence names to the global sequence dictionary at once.
+ *
+ * \param[in] names - sequence names, already known names are skipped
+ */
+void intern_sequence_names(std::vector<std::string_view> const & names);
+
+//! \overload
+template <typename names_t>
+    requires (!std::same_as<std::remove_cvref_t<names_t>, std::vector<std::string_view>>)
+void intern_sequence_names(names_t const & names)
+{
+    intern_sequence_names(std::vector<std::string_view>(names.begin(), names.end()));
+}
+
+//! \brief Returns the name of the sequence with the given id.
+std::string const & sequence_name(sequence_id_t const id);
+
+/*! \brief Returns the rank of the sequence name with the given id among all names of the dictionary in
+ *         lexicographical order. Comparing the ranks of two ids gives the same result as comparing their names.
+ */
+uint32_t sequence_rank(sequence_id_t const id);
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <optional>
+#include <vector>
+
+/*! \brief Genomic region of one reference sequence, with the virtual file offset at which reading of the region has to
+ *         start.
+ *
+ * \param ref_id        - index of the reference sequence in the BAM header
+ * \param begin         - first position of the region (0-based, inclusive)
+ * \param end           - end position of the region (0-based, exclusive)
+ * \param file_offset   - virtual file offset in front of the first alignment starting in the region
+ *
+ * \details An alignment belongs to the region in which its start position lies. Reading starts at `file_offset` and
+ *          skips alignments starting in front of `begin`.
+ */
+struct bam_region
+{
+    int32_t ref_id;
+    int32_t begin;
+    int32_t end;
+    uint64_t file_offset;
+};
+
+/*! \brief Index of a coordinate-sorted BAM file parsed from a BAI or CSI file.
+ *
+ * \details Only the information needed to seek to the alignments of a region is kept:
+ *          the smallest virtual file offset of each reference sequence and, for BAI files, the linear index with
+ *          the smallest virtual file offset of each 16 kbp window.
+ *          For more information see the [SAM/BAM Format Specification](https://samtools.github.io/hts-specs/SAMv1.pdf#page=16)
+ *          and the [CSI Specification](https://samtools.github.io/hts-specs/CSIv1.pdf) (last access 09.04.2021).
+ */
+class bam_index
+{
+private:
+    // Smallest virtual file offset of the alignments on each reference sequence, empty if there are none.
+    std::vector<std::optional<uint64_t>> reference_offsets{};
+    // Linear index of each reference sequence (BAI only).
+    std::vector<std::vector<uint64_t>> linear_indices{};
+
+    void read_bai(std::istream & stream);
+    void read_csi(std::istream & stream);
+
+public:
+    //! \brief Window size of the linear index of BAI files.
+    static constexpr int32_t linear_index_shift = 14;
+
+    /*! \brief Reads the BAI or (BGZF compressed) CSI file at `path`. Throws a std::runtime_error if the file can
+     *         not be opened and a seqan3::format_error if it is not a valid index.
+     */
+    explicit bam_index(std::filesystem::path const & path);
+
+    /*! \brief Searches the index of a BAM file. Returns the path of the first existing file out of
+     *         `<file>.bam.bai`, `<file>.bai` and `<file>.bam.csi`, or an empty path if there is none.
+     */
+    static std::filesystem::path find_index_file(std::filesystem::path const & bam_path);
+
+    /*! \brief Splits the reference sequences with alignments into regions.
+     *
+     * \param[in] references_lengths    - lengths of the reference sequences in the order of the BAM header
+     * \param[in] region_size           - length of the regions, 0 keeps whole reference sequences
+     *
+     * \returns the regions sorted by reference sequence and position.
+     *
+     * \details Reference sequences can only be split if the index has a linear index (BAI). Reference sequences
+     *          without alignments and regions behind the last window of the linear index are dropped.
+     */
+    std::vector<bam_region> split_into_regions(std::vector<int32_t> const & references_lengths,
+                                               int32_t const region_size) const;
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <seqan3/alphabet/cigar/cigar.hpp>
+#include <seqan3/alphabet/nucleotide/dna5.hpp>
+#include <seqan3/std/filesystem>                // for filesystem
+#include <deque>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "variant_detection/bgzf_reader.hpp"    // for class bgzf_reader
+
+/*! \brief Header of a BAM file. Provides the same members as the header of a seqan3::sam_file_input, which are used by
+ *         read_header_information().
+ *
+ * \param sorting       - value of the SO tag of the \@HD header line
+ * \param ref_id_info   - length and additional information of each reference sequence
+ */
+struct bam_file_header
+{
+    std::string sorting{};
+    std::vector<std::tuple<int32_t, std::string>> ref_id_info{};
+    std::deque<std::string> reference_names{};
+
+    //! \brief Returns the names of the reference sequences in the order of the BAM header.
+    std::deque<std::string> const & ref_ids() const
+    {
+        return reference_names;
+    }
+};
+
+/*! \brief Alignment record of a SAM/BAM file with the fields needed for the junction detection.
+ *
+ * \param ref_id        - RNAME field as index into the reference sequences of the header (-1 if unset)
+ * \param pos           - POS field (0-based, -1 if unset)
+ * \param mapq          - MAPQ field
+ * \param flag          - FLAG field
+ * \param read_name     - QNAME field
+ * \param cigar         - CIGAR field, or the CG tag if the CIGAR string has more than 65535 operations
+ * \param sequence      - SEQ field
+ * \param sa_tag        - value of the SA tag, empty if the record has none
+ */
+struct bam_record
+{
+    int32_t ref_id{-1};
+    int32_t pos{-1};
+    uint8_t mapq{};
+    uint16_t flag{};
+    std::string read_name{};
+    std::vector<seqan3::cigar> cigar{};
+    seqan3::dna5_vector sequence{};
+    std::string sa_tag{};
+};
+
+/*! \brief Selection of the variable fields of a BAM record, which are decoded by
+ *         bam_file_reader::decode_variable_fields(). The read name is always decoded.
+ *
+ * \param cigar         - decode the CIGAR string
+ * \param sequence      - decode the sequence
+ * \param sa_tag        - search the SA tag
+ */
+struct bam_record_fields
+{
+    bool cigar{true};
+    bool sequence{true};
+    bool sa_tag{true};
+};
+
+/*! \brief Reader for the alignment records of a BAM file, which can be positioned at virtual file offsets from a
+ *         [BAM index](\ref bam_index).
+ *
+ * \details seqan3::sam_file_input does not support random access. This reader decodes the binary BAM format directly,
+ *          so that several instances can read different regions of the same file in parallel.
+ *          For more information see the [SAM/BAM Format Specification](https://samtools.github.io/hts-specs/SAMv1.pdf#page=15)
+ *          (last access 09.04.2021).
+ */
+class bam_file_reader
+{
+private:
+    bgzf_reader reader;
+    bam_file_header file_header{};
+    std::vector<char> record_buffer{};
+
+public:
+    /*! \brief Opens the BAM file at `path` and reads its header. Throws a seqan3::format_error if the file is not a
+     *         valid BAM file.
+     *
+     * \param[in] path                      - path to the BAM file
+     * \param[in] decompression_threads     - number of threads inflating the BGZF blocks
+     */
+    explicit bam_file_reader(std::filesystem::path const & path, size_t const decompression_threads = 1);
+
+    //! \brief Returns the header of the BAM file.
+    bam_file_header const & header() const;
+
+    //! \brief Moves the read position to the given virtual file offset, which has to point to the start of a record.
+    void seek(uint64_t const virtual_offset);
+
+    /*! \brief Reads the next alignment record into `record`. Returns false if there are no records left.
+     *
+     * \param[out] record - the record to overwrite, its buffers are reused
+     */
+    bool read_record(bam_record & record);
+
+    /*! \brief Reads the next alignment record, but decodes only the fixed fields `ref_id`, `pos`, `mapq` and `flag`.
+     *         Returns false if there are no records left.
+     *
+     * \details The read name, CIGAR string, sequence and SA tag are only decoded by a following call of
+     *          decode_variable_fields(), so that records which do not pass the flag and mapping quality filters are
+     *          skipped cheaply.
+     *
+     * \param[out] record - the record to overwrite, its variable fields keep the values of the previous record
+     */
+    bool read_fixed_fields(bam_record & record);
+
+    /*! \brief Decodes the variable fields of the record last read by read_fixed_fields().
+     *
+     * \param[in,out] record - the record passed to read_fixed_fields()
+     * \param[in]     fields - the fields to decode, the other fields are cleared
+     */
+    void decode_variable_fields(bam_record & record, bam_record_fields const fields = {});
+
+    /*! \brief Decodes the sequence of the record last read by read_fixed_fields(), e.g. if it was skipped by
+     *         decode_variable_fields() and turned out to be needed.
+     *
+     * \param[in,out] record - the record passed to read_fixed_fields()
+     */
+    void decode_sequence(bam_record & record);
+};
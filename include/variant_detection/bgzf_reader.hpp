@@ -0,0 +1,87 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <fstream>                  // for std::ifstream
+#include <memory>                   // for std::unique_ptr
+#include <vector>
+
+/*! \brief Sequential reader for BGZF compressed files (e.g. BAM) with support for random access via virtual file
+ *         offsets.
+ *
+ * \details A BGZF file is a series of concatenated gzip blocks, each holding at most 64 KiB of uncompressed data.
+ *          A virtual file offset combines the offset of a block in the compressed file (upper 48 bits) with an offset
+ *          into the uncompressed data of this block (lower 16 bits). The offsets stored in a BAM index (.bai/.csi)
+ *          are virtual file offsets and can be passed to seek().
+ *          Every instance owns its own file handle, so several readers can work on the same file in parallel.
+ *          With more than one decompression thread, the following blocks are read ahead and inflated in parallel.
+ *          For more information see the [SAM/BAM Format Specification](https://samtools.github.io/hts-specs/SAMv1.pdf#page=13)
+ *          (last access 09.04.2021).
+ */
+class bgzf_reader
+{
+private:
+    struct decompression_pool;
+
+    std::ifstream file{};
+    std::vector<char> compressed_block{};
+    std::vector<char> block{};
+    uint64_t block_address{0};      // offset of the current block in the compressed file
+    uint64_t next_block_address{0}; // offset of the following block in the compressed file
+    size_t block_offset{0};         // read position in the uncompressed data of the current block
+    std::unique_ptr<decompression_pool> pool{};
+
+    /*! \brief Reads the compressed data of the block at `address` into `compressed`. Returns false at the end of the
+     *         file.
+     *
+     * \param[in]  address              - offset of the block in the compressed file
+     * \param[out] compressed           - compressed data of the block
+     * \param[out] uncompressed_size    - size of the uncompressed data of the block
+     * \param[out] block_size           - size of the block in the compressed file
+     */
+    bool read_compressed_block(uint64_t const address,
+                               std::vector<char> & compressed,
+                               uint32_t & uncompressed_size,
+                               uint64_t & block_size);
+
+    //! \brief Reads and inflates the block starting at `next_block_address`. Returns false at the end of the file.
+    bool load_next_block();
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bgzf_reader()                                   = delete;  //!< Deleted.
+    bgzf_reader(bgzf_reader const &)                = delete;  //!< Deleted.
+    bgzf_reader(bgzf_reader &&) noexcept;                      //!< Defaulted.
+    bgzf_reader & operator=(bgzf_reader const &)    = delete;  //!< Deleted.
+    bgzf_reader & operator=(bgzf_reader &&) noexcept;          //!< Defaulted.
+    ~bgzf_reader();                                            //!< Stops the decompression threads.
+
+    /*! \brief Opens the BGZF file at `path`. Throws a std::runtime_error if the file can not be opened.
+     *
+     * \param[in] path      - path to the BGZF file
+     * \param[in] threads   - number of decompression threads, 1 inflates the blocks in the calling thread
+     */
+    explicit bgzf_reader(std::filesystem::path const & path, size_t const threads = 1);
+    //!\}
+
+    /*! \brief Reads `count` uncompressed bytes into `buffer`.
+     *
+     * \param[out] buffer - destination, needs to hold at least `count` bytes
+     * \param[in]  count  - number of bytes to read
+     *
+     * \returns the number of bytes read, which is smaller than `count` only at the end of the file.
+     */
+    size_t read(char * buffer, size_t count);
+
+    /*! \brief Reads exactly `count` uncompressed bytes into `buffer`. Throws a seqan3::format_error if the file ends
+     *         before.
+     */
+    void read_exactly(char * buffer, size_t count);
+
+    //! \brief Returns the virtual file offset of the next byte to be read.
+    uint64_t tell() const;
+
+    //! \brief Moves the read position to the given virtual file offset.
+    void seek(uint64_t const virtual_offset);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+/*! \brief Thread-safe FIFO queue with a maximum number of elements, connecting a producer with several consumers.
+ *
+ * \tparam value_t - type of the queued elements
+ *
+ * \details push() blocks while the queue is full, so a fast producer can not run ahead of the consumers and the
+ *          memory usage stays bounded. pop() blocks while the queue is empty and returns std::nullopt after the queue
+ *          has been closed and drained.
+ */
+template <typename value_t>
+class bounded_queue
+{
+private:
+    std::deque<value_t> elements{};
+    size_t const capacity;
+    bool closed{false};
+    std::mutex mutex{};
+    std::condition_variable not_full{};
+    std::condition_variable not_empty{};
+
+public:
+    //! \brief Constructs an empty queue holding at most `max_size` elements (at least one).
+    explicit bounded_queue(size_t const max_size) : capacity{std::max<size_t>(max_size, 1)}
+    {}
+
+    //! \brief Appends `value`, waits while the queue is full. Returns false if the queue has been closed.
+    bool push(value_t value)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_full.wait(lock, [this] () { return closed || elements.size() < capacity; });
+        if (closed)
+            return false;
+        elements.push_back(std::move(value));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    //! \brief Removes and returns the first element, waits while the queue is empty and open.
+    std::optional<value_t> pop()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_empty.wait(lock, [this] () { return closed || !elements.empty(); });
+        if (elements.empty())
+            return std::nullopt;
+        value_t value{std::move(elements.front())};
+        elements.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return value;
+    }
+
+    //! \brief Closes the queue. Waiting calls return, remaining elements can still be popped.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+};
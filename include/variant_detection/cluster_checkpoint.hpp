@@ -0,0 +1,45 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <span>
+#include <vector>
+
+#include "iGenVar.hpp"              // for cmd_arguments
+#include "structures/cluster.hpp"   // for class Cluster
+
+/*! \brief Writes the clusters of sorted junctions to a binary cluster checkpoint, which can be read again with
+ *         read_cluster_checkpoint().
+ *
+ * \param[in] path      - path of the cluster checkpoint
+ * \param[in] clusters  - the clusters of the junctions
+ * \param[in] junctions - the sorted junctions, which were clustered, in the order of their junction store
+ * \param[in] args      - command line arguments, the parameters of the junction detection and the clustering
+ *                        (**args.min_var_length**, **args.max_overlap**, **args.clustering_method**,
+ *                        **args.hierarchical_clustering_cutoff** and **args.compaction_tolerance**) are recorded
+ *
+ * \details The checkpoint does not copy the junctions: the members of every cluster are stored as indices into the
+ *          junctions (in CSR layout, see compacted_junctions), together with the cached summary of the cluster (see
+ *          Cluster). It therefore belongs to the junction store of the junctions (see write_junction_store()), which
+ *          is recorded by a fingerprint of the junctions.
+ *          Throws a std::runtime_error if the file can not be written or if a member is not one of the junctions.
+ */
+void write_cluster_checkpoint(std::filesystem::path const & path,
+                              std::span<Cluster const> const clusters,
+                              std::span<Junction const> const junctions,
+                              cmd_arguments const & args);
+
+/*! \brief Reads the clusters of a binary cluster checkpoint written by write_cluster_checkpoint().
+ *
+ * \param[in] path      - path of the cluster checkpoint
+ * \param[in] junctions - the junctions of the junction store the checkpoint belongs to
+ * \param[in] args      - command line arguments, a warning is printed if the recorded parameters of the junction
+ *                        detection and the clustering differ from them
+ *
+ * \returns the clusters, whose summaries are restored instead of computed from the members.
+ *
+ * \details Throws a std::runtime_error if the file can not be opened, if it is not a cluster checkpoint of this
+ *          version and byte order or if it does not belong to the junctions, i.e. their number or fingerprint differ.
+ */
+std::vector<Cluster> read_cluster_checkpoint(std::filesystem::path const & path,
+                                             std::span<Junction const> const junctions,
+                                             cmd_arguments const & args);
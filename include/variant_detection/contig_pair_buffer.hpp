@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <functional>   // for std::function
+#include <map>
+#include <unordered_set>
+#include <utility>      // for std::pair
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief Collects the junctions of an alignment file which is analyzed one reference sequence at a time and releases
+ *         them in sorted batches by the pair of sequences of their breakends, as soon as both sequences have been
+ *         analyzed.
+ *
+ * \details The junctions of a pair of sequences (the sequences of the first and the second mate) are mostly detected
+ *          in alignments on one of the two sequences. Thus, the junctions within a sequence are released right after
+ *          the sequence, and the junctions between two sequences (e.g. translocations) are held until the second of
+ *          the two sequences has been analyzed. Junctions arriving after their pair was released (e.g. from a split
+ *          read with a third segment on another sequence) are late. They are released together as one batch by
+ *          finish(). The partitions of the hierarchical clustering never contain junctions of different pairs, so
+ *          without late junctions, the clusters of the batches are the clusters of the whole set of junctions.
+ */
+class contig_pair_buffer
+{
+public:
+    //! \brief Called with each released batch, the junctions may be moved out of it.
+    using batch_callback = std::function<void(std::vector<Junction> &)>;
+
+private:
+    batch_callback on_batch;
+
+    // The junctions which are not released yet by the pair of sequences of their mates.
+    std::map<std::pair<sequence_id_t, sequence_id_t>, std::vector<Junction>> pairs{};
+    std::vector<Junction> late{};
+    size_t num_late{0};
+
+    std::unordered_set<sequence_id_t> seen_seq_ids{};
+
+    // The global junction arena is compacted when it grows beyond this size, see compact_arena().
+    size_t arena_limit{min_arena_compaction_bytes};
+
+    //! \brief Sorts the junctions of the given pairs by the rank of their sequences and releases them.
+    void release(std::vector<std::pair<sequence_id_t, sequence_id_t>> seq_id_pairs);
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    contig_pair_buffer(contig_pair_buffer const &)              = delete; //!< Deleted.
+    contig_pair_buffer(contig_pair_buffer &&)                   = default; //!< Defaulted.
+    contig_pair_buffer & operator=(contig_pair_buffer const &)  = delete; //!< Deleted.
+    contig_pair_buffer & operator=(contig_pair_buffer &&)       = delete; //!< Deleted.
+    ~contig_pair_buffer()                                       = default; //!< Defaulted.
+
+    /*! \brief Constructs an empty buffer.
+     *
+     * \param[in] the_on_batch  - called with each released batch of sorted junctions
+     */
+    explicit contig_pair_buffer(batch_callback the_on_batch);
+    //!\}
+
+    /*! \brief Adds the junctions detected in the alignments of a sequence and releases the pairs of sequences which
+     *         have both been analyzed now. Throws a std::runtime_error if the sequence was added before.
+     *
+     * \param[in] seq_id        - the analyzed sequence
+     * \param[in] junctions     - the junctions detected in its alignments, moved out
+     */
+    void add_sequence(sequence_id_t const seq_id, std::vector<Junction> & junctions);
+
+    //! \brief Releases all remaining junctions: the pairs with a sequence without alignments and the late junctions.
+    void finish();
+
+    /*! \brief Frees the bytes of the released junctions in the global junction arena, once the arena has grown beyond
+     *         twice the bytes of the held junctions (see compact_junction_arena()). Thus, the arena grows with the
+     *         largest sequence and the held junctions between sequences instead of all junctions of the file.
+     *
+     * \details The junctions of released batches must not be used anymore. Must be called between the sequences,
+     *          after add_sequence().
+     */
+    void compact_arena();
+
+    //! \brief Returns the number of junctions which arrived after their pair of sequences was released.
+    size_t num_late_junctions() const
+    {
+        return num_late;
+    }
+};
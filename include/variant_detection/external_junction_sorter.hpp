@@ -0,0 +1,80 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <cstddef>                  // for size_t
+#include <functional>               // for std::function
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief Sorts the junctions of an alignment file within a memory budget by spilling sorted runs to temporary files
+ *         and merging them.
+ *
+ * \details The junctions are collected in memory until they (including their inserted sequences and read names in
+ *          the global junction arena) would exceed the memory budget. Then, they are sorted and written to a
+ *          temporary file with write_junction(), and the junction arena is cleared. Finally, merge() merges the sorted
+ *          runs and passes the junctions in sorted batches of complete partitions (see is_partition_border()) to a
+ *          callback, so the clusters of the batches are the clusters of the whole set of junctions.
+ *          The temporary files are created in a new directory in std::filesystem::temp_directory_path() (e.g.
+ *          `$TMPDIR`), which is removed on destruction.
+ *          While junctions are added, the sorter must own all junctions referring to the junction arena, see
+ *          arena_clear().
+ */
+class external_junction_sorter
+{
+public:
+    //! \brief Called with each merged batch, the junctions may be moved out of it.
+    using batch_callback = std::function<void(std::vector<Junction> &)>;
+
+private:
+    size_t const memory_budget;
+    std::vector<Junction> junctions{};
+
+    std::filesystem::path directory{};
+    std::vector<std::filesystem::path> runs{};
+
+    //! \brief Sorts the junctions in memory, writes them to a new temporary file and clears the junction arena.
+    void spill();
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    external_junction_sorter(external_junction_sorter const &)              = delete; //!< Deleted.
+    external_junction_sorter(external_junction_sorter &&)                   = delete; //!< Deleted.
+    external_junction_sorter & operator=(external_junction_sorter const &)  = delete; //!< Deleted.
+    external_junction_sorter & operator=(external_junction_sorter &&)       = delete; //!< Deleted.
+
+    /*! \brief Constructs an empty sorter.
+     *
+     * \param[in] the_memory_budget - number of bytes of the junctions in memory before they are spilled
+     */
+    explicit external_junction_sorter(size_t const the_memory_budget);
+
+    //! \brief Removes the temporary files.
+    ~external_junction_sorter();
+    //!\}
+
+    /*! \brief Adds junctions and spills them if they exceed the memory budget. Throws a std::runtime_error if a
+     *         temporary file can not be written.
+     *
+     * \param[in] new_junctions - the junctions to add, moved out
+     */
+    void add(std::vector<Junction> & new_junctions);
+
+    /*! \brief Passes all junctions in sorted batches to a callback.
+     *
+     * \param[in] on_batch - called with each sorted batch of complete partitions
+     *
+     * \details If no junctions were spilled, they are sorted in memory and passed as one batch. Otherwise, the runs
+     *          are merged into batches of about half the memory budget, and the junction arena is cleared after
+     *          each batch, so the callback must not keep any junction.
+     */
+    void merge(batch_callback const & on_batch);
+
+    //! \brief Returns the number of sorted runs spilled to temporary files.
+    size_t num_runs() const
+    {
+        return runs.size();
+    }
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int32_t
+#include <functional>   // for std::function
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "structures/junction.hpp"  // for class Junction
+
+/*! \brief A sliding window over the junctions of a coordinate-sorted alignment file, which releases the junctions in
+ *         sorted batches of complete partitions as soon as no later alignment is expected to add a junction to them.
+ *
+ * \details The window is advanced to the position of each alignment before the junctions of the alignment are added.
+ *          Junctions whose first mate lies on the current sequence are kept until their first mate has fallen more
+ *          than `lag` bases behind the current position. Then, they are released up to the last partition border (see
+ *          is_partition_border()) in front of that boundary, so that a released batch never splits a partition.
+ *          Junctions whose first mate lies on another sequence (e.g. translocations) are held in a side store:
+ *          junctions on sequences which have not been reached yet are moved into the window when their sequence is
+ *          reached. Junctions arriving after their part of the genome was released are late. They are released
+ *          together as one batch by finish(). Without late junctions, the batches contain exactly the partitions of
+ *          the whole set of junctions.
+ */
+class junction_window
+{
+public:
+    //! \brief Called with each released batch, the junctions may be moved out of it.
+    using batch_callback = std::function<void(std::vector<Junction> &)>;
+
+private:
+    int32_t const lag;
+    batch_callback on_batch;
+
+    bool started{false};
+    sequence_id_t current_seq_id{};
+    int32_t current_position{};
+    // All junctions on the current sequence in front of the boundary have been released.
+    int64_t boundary{};
+
+    // Junctions on the current sequence by the orientation of their first mate, as the sorted order of the junctions
+    // is by orientation before position. The first `num_sorted` junctions of each vector are sorted.
+    std::array<std::vector<Junction>, 2> window{};
+    std::array<size_t, 2> num_sorted{};
+
+    // Side store: junctions on sequences which have not been reached yet, and late junctions.
+    std::unordered_map<sequence_id_t, std::vector<Junction>> upcoming{};
+    std::vector<Junction> late{};
+    size_t num_late{0};
+
+    std::unordered_set<sequence_id_t> finished_seq_ids{};
+    std::vector<Junction> batch{};
+
+    // The global junction arena is compacted when it grows beyond this size, see compact_arena().
+    size_t arena_limit{min_arena_compaction_bytes};
+
+    //! \brief Releases the junctions on the current sequence up to the last partition border before `new_boundary`.
+    void release(int64_t const new_boundary);
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    junction_window(junction_window const &)                = delete; //!< Deleted.
+    junction_window(junction_window &&)                     = default; //!< Defaulted.
+    junction_window & operator=(junction_window const &)    = delete; //!< Deleted.
+    junction_window & operator=(junction_window &&)         = delete; //!< Deleted.
+    ~junction_window()                                      = default; //!< Defaulted.
+
+    /*! \brief Constructs an empty window.
+     *
+     * \param[in] the_lag       - maximal distance of the first mate of a new junction behind the current position
+     * \param[in] the_on_batch  - called with each released batch of sorted junctions
+     */
+    junction_window(int32_t const the_lag, batch_callback the_on_batch);
+    //!\}
+
+    /*! \brief Moves the window to the position of the next alignment and releases the junctions which have fallen
+     *         behind. Throws a std::runtime_error if the alignments are not sorted by coordinate.
+     *
+     * \param[in] seq_id    - the sequence of the alignment
+     * \param[in] position  - the position of the alignment
+     */
+    void advance(sequence_id_t const seq_id, int32_t const position);
+
+    //! \brief Adds a junction of the current alignment.
+    void add(Junction const & junction);
+
+    //! \brief Releases all remaining junctions: the current sequence, the upcoming sequences and the late junctions.
+    void finish();
+
+    /*! \brief Frees the bytes of the released junctions in the global junction arena, once the arena has grown beyond
+     *         twice the bytes of the held junctions (see compact_junction_arena()). Thus, the arena grows with the
+     *         junctions in the window instead of all junctions of the file.
+     *
+     * \details The junctions of released batches and the junctions passed to add() before must not be used anymore.
+     *          Must be called between alignments, after the junctions of an alignment were added.
+     */
+    void compact_arena();
+
+    //! \brief Returns the number of junctions which arrived after their part of the genome was released.
+    size_t num_late_junctions() const
+    {
+        return num_late;
+    }
+};
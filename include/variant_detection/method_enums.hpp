@@ -36,6 +36,14 @@ enum refinement_methods
     sVirl_refinement_method = 2
 };
 
+//!\brief An enum for the pipeline stages a run can be resumed from.
+enum resume_stages
+{
+    no_resume = 0,
+    resume_from_junctions = 1,
+    resume_from_clusters = 2
+};
+
 /*! \brief Specialise a mapping from an identifying string to the respective value of your type detection_methods. With
  *         the help of this function, you're able to call ./detect_breackends with --method 0 and --method cigar_string
  *         and get the same result.
@@ -53,3 +61,9 @@ std::unordered_map<std::string, clustering_methods> enumeration_names(clustering
  *         --refinement_method no_refinement and get the same result.
  */
 std::unordered_map<std::string, refinement_methods> enumeration_names(refinement_methods);
+
+/*! \brief Specialise a mapping from an identifying string to the respective value of your type resume_stages. With
+ *         the help of this function, you're able to call ./iGenVar with --resume_from 2 and --resume_from clusters and
+ *         get the same result.
+ */
+std::unordered_map<std::string, resume_stages> enumeration_names(resume_stages);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <seqan3/std/filesystem>    // for filesystem
+#include <vector>
+
+#include "iGenVar.hpp"              // for cmd_arguments
+
+//! \brief A combination of parameters of a parameter sweep and the VCF file of its variants.
+struct parameter_combination
+{
+    cmd_arguments args;
+    std::filesystem::path output_file_path;
+};
+
+/*! \brief Returns the parameter combinations of a parameter sweep.
+ *
+ * \param[in] args - command line arguments:\n
+ *                   **args.sweep** - the swept parameters, each given as `name=value1,value2,...`. The parameters
+ *                                    min_var_length, max_var_length, max_tol_inserted_length, max_overlap, min_qual
+ *                                    and hierarchical_clustering_cutoff can be swept.\n
+ *                   **args.sweep_separately** - vary one swept parameter at a time instead of combining all values of
+ *                                               all swept parameters\n
+ *                   **args.sweep_output_directory** - directory of the VCF files of the combinations
+ *
+ * \returns the combinations, sorted by max_overlap, min_var_length and hierarchical_clustering_cutoff.
+ *
+ * \details The parameters, which are not swept, keep their values of `args` in every combination. The VCF file of a
+ *          combination is named after the values of its swept parameters, e.g. `min_var_length_30.vcf` or
+ *          `min_var_length_30.min_qual_2.vcf`. The order of the combinations lets consecutive combinations share
+ *          their junctions and clusters, see detect_variants_in_alignment_file_sweep().
+ *          Throws a std::runtime_error for unknown or repeated parameters and for missing, malformed, negative or
+ *          repeated values.
+ */
+std::vector<parameter_combination> parameter_sweep_combinations(cmd_arguments const & args);
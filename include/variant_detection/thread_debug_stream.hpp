@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iostream>                         // for std::cerr
+
+#include <seqan3/core/debug_stream.hpp>     // for seqan3::debug_stream_type
+
+/*! \brief Debug stream for the messages of the junction detection. Writes to std::cerr by default.
+ *
+ * \details Every thread has its own instance. When junctions are detected on several regions in parallel, each worker
+ *          redirects its instance into a per-region buffer. The buffers are printed in region order afterwards, so
+ *          the messages appear in the same order as in a serial run.
+ */
+inline thread_local seqan3::debug_stream_type<char> thread_debug_stream{std::cerr};
@@ -1,11 +1,17 @@
 #pragma once
 
-#include <seqan3/std/filesystem>    // for filesystem
+#include <seqan3/alphabet/cigar/cigar.hpp>
+#include <seqan3/io/sam_file/sam_flag.hpp>
+#include <seqan3/std/filesystem>                // for filesystem
+#include <functional>                           // for std::function
 #include <map>
+#include <span>
 #include <vector>
 
-#include "iGenVar.hpp"              // for struct cmd_arguments
-#include "structures/junction.hpp"  // for class Junction
+#include "iGenVar.hpp"                          // for struct cmd_arguments
+#include "structures/junction.hpp"              // for class Junction
+#include "variant_detection/bam_reader.hpp"     // for class bam_file_reader and struct bam_record
+#include "variant_detection/bam_index.hpp"      // for class bam_index and struct bam_region
 
 /*! \brief Reads the header of the input file. Checks if input file is sorted and reads the reference sequence
  *         dictionary. Stores the reference sequence lengths in parameter `reference_lengths` and returns the list of
@@ -37,6 +43,58 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
                                               std::map<std::string, int32_t> & references_lengths,
                                               cmd_arguments const & args);
 
+/*! \brief Detects junctions in a single long read alignment record, which passed the filters for unmapped,
+ *         secondary and duplicate alignments and alignments with low mapping quality.
+ *
+ * \param[in]       query_name  - QNAME field of the SAM/BAM file
+ * \param[in]       flag        - FLAG field of the SAM/BAM file
+ * \param[in]       ref_name    - RNAME field of the SAM/BAM file
+ * \param[in]       ref_pos     - POS field of the SAM/BAM file
+ * \param[in]       mapq        - MAPQ field of the SAM/BAM file
+ * \param[in]       cigar       - CIGAR field of the SAM/BAM file
+ * \param[in]       seq         - SEQ field of the SAM/BAM file
+ * \param[in]       sa_tag      - SA tag of the SAM/BAM record, empty if there is none
+ * \param[in]       args        - command line arguments:\n
+ *                                **args.methods** - list of methods for detecting junctions\n
+ *                                **args.min_var_length** - minimum length of variants to detect\n
+ *                                **args.max_overlap** - maximum overlap between alignment segments
+ * \param[in, out]  junctions   - vector for storing junctions
+ */
+void detect_junctions_in_long_read_alignment(std::string const & query_name,
+                                             seqan3::sam_flag const flag,
+                                             std::string const & ref_name,
+                                             int32_t const ref_pos,
+                                             uint8_t const mapq,
+                                             std::vector<seqan3::cigar> & cigar,
+                                             seqan3::dna5_vector const & seq,
+                                             std::string const & sa_tag,
+                                             cmd_arguments const & args,
+                                             std::vector<Junction> & junctions);
+
+/*! \brief Returns the variable fields of long read alignment records, which are needed by the selected detection
+ *         methods.
+ *
+ * \param[in] methods - list of methods for detecting junctions
+ *
+ * \details The cigar string method needs the CIGAR string and the sequence, the split read method additionally needs
+ *          the SA tag. The read pair method and the read depth method do not use any field of long read alignments.
+ */
+bam_record_fields required_long_read_fields(std::vector<detection_methods> const & methods);
+
+/*! \brief Checks if the selected detection methods need the sequence of a long read alignment record, whose CIGAR
+ *         string and SA tag are decoded.
+ *
+ * \param[in] record    - alignment record, the SA tag of supplementary alignments is expected to be empty
+ * \param[in] args      - command line arguments:\n
+ *                        **args.methods** - list of methods for detecting junctions\n
+ *                        **args.min_var_length** - minimum length of variants to detect
+ *
+ * \details The sequence is needed by the cigar string method for insertions of at least `min_var_length` bases, which
+ *          carry the inserted bases, and by the split read method for primary alignments with an SA tag, whose
+ *          junctions carry the bases between the alignment segments.
+ */
+bool needs_query_sequence(bam_record const & record, cmd_arguments const & args);
+
 /*! \brief Detects junctions between distant genomic positions by analyzing a long read alignment file (sam/bam). The
  *         detected junctions are stored in a vector.
  *
@@ -49,14 +107,121 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
  *                         **args.min_var_length** - minimum length of variants to detect
  *                            (expected to be non-negative) - *default: 30 bp*\n
  *                         **args.max_overlap** - maximum overlap between alignment segments
- *                            (expected to be non-negative) - *default: 10 bp*
+ *                            (expected to be non-negative) - *default: 10 bp*\n
+ *                         **args.threads** - number of threads for the junction detection\n
+ *                         **args.decompression_threads** - number of threads for the BAM decompression\n
+ *                         **args.region_size** - size of the regions for the parallel detection
  *
  *
  * \details Detects junctions from the CIGAR strings and supplementary alignment tags of read alignment records.
  *          We filter unmapped alignments, secondary alignments, duplicates and alignments with low mapping quality.
  *          Then, the CIGAR string of all remaining alignments is analyzed.
  *          For primary alignments, also the split read information is analyzed.
+ *          If more than one thread is given and the input is a BAM file with an index (.bai/.csi), the file is
+ *          analyzed region by region in parallel, see detect_junctions_in_long_reads_bam_file_by_regions().
+ *          Other files are analyzed in batches of records in parallel, see
+ *          detect_junctions_in_long_reads_in_batches().
  */
 void detect_junctions_in_long_reads_sam_file(std::vector<Junction> & junctions,
                                              std::map<std::string, int32_t> & references_lengths,
                                              cmd_arguments const & args);
+
+/*! \brief Detects junctions in a long read alignment file (sam/bam) for several sets of detection parameters in a
+ *         single pass over the file.
+ *
+ * \param[in, out]  junctions - one vector of junctions per element of `detection_args`
+ * \param[in, out]  references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in]       detection_args - command line arguments for every set of detection parameters, see
+ *                                   detect_junctions_in_long_reads_sam_file(), which may only differ in
+ *                                   **args.min_var_length** and **args.max_overlap**
+ *
+ * \details The file is read and decoded once, with the fields needed by the smallest minimum variant length. Each good
+ *          alignment is then analyzed with every set of detection parameters, so the junctions of a set are identical
+ *          to the ones of detect_junctions_in_long_reads_sam_file() with its arguments. With more than one thread, the
+ *          alignments are analyzed in parallel like by detect_junctions_in_long_reads_sam_file(), region by region for
+ *          indexed BAM files and in batches otherwise, and each worker analyzes its alignments with every set.
+ */
+void detect_junctions_in_long_reads_sam_file(std::vector<std::vector<Junction>> & junctions,
+                                             std::map<std::string, int32_t> & references_lengths,
+                                             std::span<cmd_arguments const> const detection_args);
+
+//! \brief Called with the sequence id, position and junctions of each alignment, the junctions may be moved out.
+using alignment_callback = std::function<void(sequence_id_t const, int32_t const, std::vector<Junction> &)>;
+
+/*! \brief Detects junctions in a long read alignment file (sam/bam) and passes the junctions of each alignment to a
+ *         callback while reading, e.g. to a junction_window, so that they can be clustered before the whole file is
+ *         read.
+ *
+ * \param[in]       on_alignment - called with the junctions of each good alignment, in the order of the file
+ * \param[in, out]  references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in]       args - command line arguments, see detect_junctions_in_long_reads_sam_file()
+ *
+ * \details The alignments are analyzed serially in the order of the file. The callback is also called for alignments
+ *          without junctions.
+ */
+void detect_junctions_in_long_reads_sam_file(alignment_callback const & on_alignment,
+                                             std::map<std::string, int32_t> & references_lengths,
+                                             cmd_arguments const & args);
+
+/*! \brief Detects junctions in an indexed long read BAM file by splitting the genome into regions, which are analyzed
+ *         in parallel. The detected junctions are stored in a vector.
+ *
+ * \param[in, out]  junctions - a vector of junctions
+ * \param[in, out]  references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in]       args - command line arguments:\n
+ *                         **args.alignment_long_reads_file_path** - long reads input file, path to the bam file\n
+ *                         **args.threads** - number of worker threads\n
+ *                         **args.region_size** - size of the regions, 0 splits the genome by chromosome only\n
+ *                         and the detection parameters of detect_junctions_in_long_reads_sam_file()
+ * \param[in]       index_path - path to the BAI or CSI index of the BAM file
+ *
+ * \details Each region is read from its start offset in the index and contains the alignments starting in it. The
+ *          workers take the next unprocessed region until all regions are done. The junctions and messages of the
+ *          regions are concatenated in region order, so the result is identical to a serial run over the whole file.
+ */
+void detect_junctions_in_long_reads_bam_file_by_regions(std::vector<Junction> & junctions,
+                                                        std::map<std::string, int32_t> & references_lengths,
+                                                        cmd_arguments const & args,
+                                                        std::filesystem::path const & index_path);
+
+//! \brief Called with the sequence id and the junctions of each reference sequence, the junctions may be moved out.
+using chromosome_callback = std::function<void(sequence_id_t const, std::vector<Junction> &)>;
+
+/*! \brief Detects junctions in an indexed long read BAM file one reference sequence at a time and passes the
+ *         junctions of each reference sequence to a callback before the next one is analyzed.
+ *
+ * \param[in, out]  references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in]       args - command line arguments, see detect_junctions_in_long_reads_bam_file_by_regions()
+ * \param[in]       index_path - path to the BAI or CSI index of the BAM file
+ * \param[in]       on_chromosome - called with the junctions of each reference sequence with alignments
+ *
+ * \details The reference sequences are analyzed in the order of the BAM header. The regions of a reference sequence
+ *          are analyzed in parallel, so only the junctions of one reference sequence are held at a time. The
+ *          junctions of a reference sequence are the junctions detected in its alignments, their breakends can lie on
+ *          other reference sequences.
+ */
+void detect_junctions_in_long_reads_bam_file_by_chromosome(std::map<std::string, int32_t> & references_lengths,
+                                                           cmd_arguments const & args,
+                                                           std::filesystem::path const & index_path,
+                                                           chromosome_callback const & on_chromosome);
+
+/*! \brief Detects junctions in a long read alignment file (sam/bam) with a pipeline of one reader and several
+ *         analysis threads. The detected junctions are stored in a vector.
+ *
+ * \param[in, out]  junctions - a vector of junctions
+ * \param[in, out]  references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in]       args - command line arguments:\n
+ *                         **args.threads** - number of analysis threads\n
+ *                         **args.decompression_threads** - number of threads for the BAM decompression\n
+ *                         and the detection parameters of detect_junctions_in_long_reads_sam_file()
+ * \param[in]       batch_size - number of alignment records per batch
+ *
+ * \details The calling thread reads and filters the alignment records and passes them in batches through a bounded
+ *          queue to the analysis threads. Each analysis thread stores the junctions and messages of its batches in
+ *          its own buffer. Afterwards, the buffers are merged by batch index, so the result is identical to a serial
+ *          run.
+ */
+void detect_junctions_in_long_reads_in_batches(std::vector<Junction> & junctions,
+                                               std::map<std::string, int32_t> & references_lengths,
+                                               cmd_arguments const & args,
+                                               size_t const batch_size = 1000);
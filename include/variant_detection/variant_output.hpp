@@ -4,10 +4,36 @@
 
 #include <seqan3/std/filesystem>
 
-#include "iGenVar.hpp"              // for cmd_arguments
-#include "structures/cluster.hpp"   // for class Cluster
+#include "iGenVar.hpp"                                  // for cmd_arguments
+#include "structures/cluster.hpp"                       // for class Cluster
+#include "variant_detection/vcf_record_writer.hpp"      // for class vcf_record_writer
 
 
+/*! \brief Prints the VCF header with the reference sequences and the sample name to the output stream.
+ *
+ * \param[in] references_lengths - reference sequence dictionary parsed from \@SQ header lines
+ * \param[in] args               - command line arguments:\n
+ *                                 **args.vcf_sample_name** - name of the sample for the vcf header line
+ * \param[in, out] out_stream    - output stream
+ */
+void output_vcf_header(std::map<std::string, int32_t> & references_lengths,
+                       cmd_arguments const & args,
+                       std::ostream & out_stream);
+
+/*! \brief Detects genomic variants from junction clusters and appends their VCF records to a vcf_record_writer,
+ *         without the header. See find_and_output_variants() for the parameters.
+ *
+ * \details The records are written to the stream of the writer when its buffer is full or flushed, so a writer can
+ *          collect the records of many calls, e.g. of the batches of the streaming mode.
+ */
+void output_variants(std::vector<Cluster> const & clusters, cmd_arguments const & args, vcf_record_writer & writer);
+
+/*! \brief Detects genomic variants from junction clusters and prints their VCF records to the output stream, without
+ *         the header. See find_and_output_variants() for the parameters.
+ */
+//!\overload
+void output_variants(std::vector<Cluster> const & clusters, cmd_arguments const & args, std::ostream & out_stream);
+
 /*! \brief Detects genomic variants from junction clusters and prints them to output stream in VCF format.
  *
  * \param[in] references_lengths - reference sequence dictionary parsed from \@SQ header lines
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int32_t, uint64_t
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/*! \brief Writes the structural variant records of iGenVar in VCF format into a reusable buffer, which is written to
+ *         the output stream in large blocks.
+ *
+ * \details The records have a fixed schema: ID, REF, FILTER, FORMAT and the genotype are constant, ALT is the
+ *          symbolic allele of the SV type and the INFO field holds END, SVLEN and SVTYPE in this order. The numbers
+ *          are formatted with std::to_chars directly into the buffer, so no strings are built per record. The output
+ *          is byte-identical to the one of variant_record::print() with these fields.
+ *          The buffer is written to the stream when it is full, on flush() and on destruction. Other output to the
+ *          same stream therefore has to be written while the buffer is empty, e.g. the VCF header before the first
+ *          record.
+ */
+class vcf_record_writer
+{
+private:
+    std::ostream & out_stream;
+    std::vector<char> buffer;
+    size_t buffer_used{0};
+
+public:
+    //! \brief The default size of the buffer, which is written to the stream at once.
+    static constexpr size_t default_buffer_size = 1 << 20;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    vcf_record_writer(vcf_record_writer const &)                = delete; //!< Deleted.
+    vcf_record_writer(vcf_record_writer &&)                     = delete; //!< Deleted.
+    vcf_record_writer & operator=(vcf_record_writer const &)    = delete; //!< Deleted.
+    vcf_record_writer & operator=(vcf_record_writer &&)         = delete; //!< Deleted.
+
+    /*! \brief Creates a writer with an empty buffer.
+     *
+     * \param[in, out] out_stream  - the output stream the records are written to
+     * \param[in]      buffer_size - size of the buffer, larger records grow it
+     */
+    vcf_record_writer(std::ostream & out_stream, size_t const buffer_size = default_buffer_size);
+
+    //! \brief Writes the remaining records to the stream.
+    ~vcf_record_writer();
+    //!\}
+
+    /*! \brief Appends a structural variant record to the buffer.
+     *
+     * \param[in] chrom   - the sequence name of the variant
+     * \param[in] pos     - the 1-based position of the variant
+     * \param[in] sv_type - the SV type, e.g. DEL, which gives the symbolic ALT allele and the SVTYPE
+     * \param[in] qual    - the quality of the variant, printed like a float by a std::ostream
+     * \param[in] end     - the END of the variant
+     * \param[in] sv_len  - the SVLEN of the variant
+     */
+    void write_record(std::string_view const chrom,
+                      uint64_t const pos,
+                      std::string_view const sv_type,
+                      float const qual,
+                      int32_t const end,
+                      int32_t const sv_len);
+
+    //! \brief Writes the buffered records to the stream and empties the buffer.
+    void flush();
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*! \brief Runs `task(i)` for all task indices in `task_order` on `threads` threads with work stealing.
+ *
+ * \tparam task_t - type of the callable, invoked with a task index
+ *
+ * \param[in] task_order    - the task indices in the order in which they should be started, e.g. largest first
+ * \param[in] threads       - number of threads, 1 runs all tasks in the calling thread in the given order
+ * \param[in] task          - the callable, which has to be safe to invoke concurrently for different indices
+ *
+ * \details The tasks are dealt round-robin to one deque per thread, so that every thread starts with a share of the
+ *          first (largest) tasks. A thread takes its next task from the front of its own deque and, when that is
+ *          empty, steals from the back of the deques of the other threads. If a task throws, no further tasks are
+ *          started and the first exception is rethrown after all threads have finished.
+ */
+template <typename task_t>
+void run_with_work_stealing(std::vector<size_t> const & task_order, size_t const threads, task_t && task)
+{
+    if (threads <= 1 || task_order.size() <= 1)
+    {
+        for (size_t const index : task_order)
+            task(index);
+        return;
+    }
+
+    struct task_deque
+    {
+        std::mutex mutex{};
+        std::deque<size_t> indices{};
+    };
+    size_t const num_workers = std::min(threads, task_order.size());
+    std::vector<task_deque> deques(num_workers);
+    for (size_t i = 0; i < task_order.size(); ++i)
+        deques[i % num_workers].indices.push_back(task_order[i]);
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error{};
+    std::mutex error_mutex{};
+
+    // Returns the next task of worker `own`, stolen from another worker if its own deque is empty.
+    auto next_task = [&] (size_t const own) -> std::optional<size_t>
+    {
+        for (size_t offset = 0; offset < num_workers; ++offset)
+        {
+            task_deque & victim = deques[(own + offset) % num_workers];
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            if (victim.indices.empty())
+                continue;
+            size_t index{};
+            if (offset == 0)
+            {
+                index = victim.indices.front();
+                victim.indices.pop_front();
+            }
+            else
+            {
+                index = victim.indices.back();
+                victim.indices.pop_back();
+            }
+            return index;
+        }
+        return std::nullopt;
+    };
+
+    auto work = [&] (size_t const own)
+    {
+        while (!failed.load(std::memory_order_relaxed))
+        {
+            std::optional<size_t> const index = next_task(own);
+            if (!index)
+                return;
+            try
+            {
+                task(*index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers{};
+    for (size_t i = 1; i < num_workers; ++i)
+        workers.emplace_back(work, i);
+    work(0);
+    for (std::thread & worker : workers)
+        worker.join();
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -1,5 +1,6 @@
 #include "iGenVar.hpp"
 
+#include <algorithm>
 #include <map>
 
 #include <seqan3/contrib/stream/bgzf_stream_util.hpp>       // for bgzf_thread_count
@@ -8,6 +9,14 @@
 #include "modules/clustering/hierarchical_clustering_method.hpp"    // for the hierarchical clustering method
 #include "modules/clustering/simple_clustering_method.hpp"          // for the simple clustering method
 #include "structures/cluster.hpp"                                   // for class Cluster
+#include "structures/junction_sort.hpp"                             // for sort_junctions()
+#include "structures/junction_store.hpp"                            // for class junction_store
+#include "variant_detection/bam_index.hpp"                          // for bam_index::find_index_file()
+#include "variant_detection/cluster_checkpoint.hpp"                 // for write_cluster_checkpoint()
+#include "variant_detection/contig_pair_buffer.hpp"                 // for class contig_pair_buffer
+#include "variant_detection/external_junction_sorter.hpp"           // for class external_junction_sorter
+#include "variant_detection/junction_window.hpp"                    // for class junction_window
+#include "variant_detection/parameter_sweep.hpp"                    // for parameter_sweep_combinations()
 #include "variant_detection/variant_detection.hpp"                  // for detect_junctions_in_long_reads_sam_file()
 #include "variant_detection/variant_output.hpp"                     // for find_and_output_variants()
 
@@ -47,8 +56,18 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
 
     // Options - Other parameters:
     parser.add_option(args.threads, 't', "threads",
+                      "Specify the number of threads used for the junction detection and the clustering. Indexed long "
+                      "read BAM files are split into regions, which are analyzed in parallel. Otherwise, batches of "
+                      "alignments are analyzed in parallel. The partitions of the hierarchical clustering are "
+                      "clustered in parallel.",
+                      seqan3::option_spec::standard);
+    parser.add_option(args.decompression_threads, '\0', "decompression_threads",
                       "Specify the number of decompression threads used for reading BAM files.",
                       seqan3::option_spec::standard);
+    parser.add_option(args.region_size, 'g', "region_size",
+                      "Specify the size of the regions for the parallel analysis of indexed long read BAM files. "
+                      "0 splits the genome by chromosome only. This value needs to be non-negative.",
+                      seqan3::option_spec::advanced);
 
     // Options - Optional output:
     parser.add_option(args.junctions_file_path, 'a', "junctions",
@@ -59,6 +78,33 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
                       "The path of the optional cluster output file. If no path is given, clusters will not be output.",
                       seqan3::option_spec::advanced,
                       seqan3::output_file_validator{seqan3::output_file_open_options::open_or_create});
+    parser.add_option(args.junction_store_path, '\0', "junction_store",
+                      "The path of the optional binary junction store. If a path is given, the sorted junctions are "
+                      "stored with their reference sequences, so that they can be clustered again with "
+                      "--input_junction_store without analyzing the alignment files.",
+                      seqan3::option_spec::advanced,
+                      seqan3::output_file_validator{seqan3::output_file_open_options::open_or_create});
+    parser.add_option(args.input_junction_store_path, '\0', "input_junction_store",
+                      "Cluster the junctions of a binary junction store written with --junction_store instead of "
+                      "detecting junctions in alignment files, so that only the partitioning, the clustering and the "
+                      "output are run.",
+                      seqan3::option_spec::advanced,
+                      seqan3::input_file_validator{});
+    parser.add_option(args.cluster_checkpoint_path, '\0', "cluster_checkpoint",
+                      "The path of the optional binary cluster checkpoint. If a path is given, the members of the "
+                      "clusters are stored as indices into the junction store of --junction_store or "
+                      "--input_junction_store together with the summaries of the clusters, so that the output can be "
+                      "repeated with --resume_from clusters.",
+                      seqan3::option_spec::advanced,
+                      seqan3::output_file_validator{seqan3::output_file_open_options::open_or_create});
+    parser.add_option(args.resume_from, '\0', "resume_from",
+                      "Resume a previous run from its junction store, given with --input_junction_store, and its "
+                      "cluster checkpoint, given with --cluster_checkpoint, instead of analyzing the alignment files. "
+                      "Value must be one of [0,none,1,junctions,2,clusters]. From junctions, the stored junctions are "
+                      "clustered again. From clusters, only the variants of the stored clusters are output, so that "
+                      "e.g. --min_qual, --max_var_length or --max_tol_inserted_length can be changed without "
+                      "clustering.",
+                      seqan3::option_spec::advanced);
 
     // Options - Methods:
     parser.add_option(args.methods, 'd', "method",
@@ -105,46 +151,52 @@ void initialize_argument_parser(seqan3::argument_parser & parser, cmd_arguments
                       "Specify the distance cutoff for the hierarchical clustering. "
                       "This value needs to be non-negative.",
                       seqan3::option_spec::advanced);
-}
-
-void detect_variants_in_alignment_file(cmd_arguments const & args)
-{
-    // Store junctions
-    std::vector<Junction> junctions{};
-    std::map<std::string, int32_t> references_lengths{};
-
-    // short reads
-    if (args.alignment_short_reads_file_path != "")
-    {
-        seqan3::debug_stream << "Detect junctions in short reads...\n";
-        detect_junctions_in_short_reads_sam_file(junctions, references_lengths, args);
-    }
-
-    // long reads
-    if (args.alignment_long_reads_file_path != "")
-    {
-        seqan3::debug_stream << "Detect junctions in long reads...\n";
-        detect_junctions_in_long_reads_sam_file(junctions, references_lengths, args);
-    }
-
-    std::sort(junctions.begin(), junctions.end());
+    parser.add_option(args.compaction_tolerance, '\0', "compaction_tolerance",
+                      "Specify the tolerance for collapsing nearly identical junctions before the hierarchical "
+                      "clustering. Junctions whose mate positions and inserted sizes each differ by at most this value "
+                      "from a representative are clustered as one weighted junction. 0 collapses identical junctions "
+                      "only, which does not change the clusters. This value needs to be non-negative.",
+                      seqan3::option_spec::advanced);
 
-    if (args.junctions_file_path != "")
-    {
-        std::ofstream junctions_file{args.junctions_file_path};
-        if (!junctions_file.good() || !junctions_file.is_open())
-        {
-            throw std::runtime_error{"Could not open file '" + args.junctions_file_path.string() + "' for writing."};
-        }
-        for (Junction const & junction : junctions)
-        {
-            junctions_file << junction << "\n";
-        }
-        junctions_file.close();
-    }
+    // Options - Memory usage:
+    parser.add_flag(args.streaming, '\0', "streaming",
+                    "Cluster the junctions of a long read file while reading it and output their variants right "
+                    "away, so that the memory grows with the coverage instead of the genome size. The junctions are "
+                    "detected by a single thread and the VCF records are sorted by the order of the alignment file.",
+                    seqan3::option_spec::advanced);
+    parser.add_flag(args.by_chromosome, '\0', "by_chromosome",
+                    "Analyze an indexed long read BAM file one chromosome at a time: detect, cluster and output the "
+                    "variants of a chromosome before the next one is read, so that the memory is bounded by the "
+                    "largest chromosome instead of the genome size. The VCF records are sorted by the order of the "
+                    "BAM header.",
+                    seqan3::option_spec::advanced);
+    parser.add_option(args.max_memory, '\0', "max_memory",
+                      "Specify the memory budget in MiB for the junctions. If the junctions exceed it, they are "
+                      "sorted and spilled to temporary files in TMPDIR, which are merged for the clustering. The long "
+                      "read junctions are then detected by a single thread. 0 keeps all junctions in memory. This "
+                      "value needs to be non-negative.",
+                      seqan3::option_spec::advanced);
 
-    seqan3::debug_stream << "Start clustering...\n";
+    // Options - Parameter sweep:
+    parser.add_option(args.sweep, '\0', "sweep",
+                      "Sweep a parameter over a list of values, given as name=value1,value2,..., and output the "
+                      "variants of every parameter combination to an own VCF file in --sweep_output_directory. The "
+                      "long read file is read only once. This option can be given multiple times. The parameters "
+                      "min_var_length, max_var_length, max_tol_inserted_length, max_overlap, min_qual and "
+                      "hierarchical_clustering_cutoff can be swept.",
+                      seqan3::option_spec::advanced);
+    parser.add_flag(args.sweep_separately, '\0', "sweep_separately",
+                    "Vary one swept parameter at a time, while the other parameters keep their given values, instead "
+                    "of combining all values of all swept parameters.",
+                    seqan3::option_spec::advanced);
+    parser.add_option(args.sweep_output_directory, '\0', "sweep_output_directory",
+                      "The directory of the VCF files of the parameter sweep. It is created if it does not exist.",
+                      seqan3::option_spec::advanced);
+}
 
+// Clusters the junctions with the selected clustering method.
+std::vector<Cluster> cluster_junctions(std::vector<Junction> junctions, cmd_arguments const & args)
+{
     std::vector<Cluster> clusters;
     switch (args.clustering_method)
     {
@@ -152,7 +204,10 @@ void detect_variants_in_alignment_file(cmd_arguments const & args)
             clusters = simple_clustering_method(junctions);
             break;
         case 1: // hierarchical clustering
-            clusters = hierarchical_clustering_method(junctions, args.hierarchical_clustering_cutoff);
+            clusters = hierarchical_clustering_method(std::move(junctions),
+                                                      args.hierarchical_clustering_cutoff,
+                                                      args.threads,
+                                                      args.compaction_tolerance);
             break;
         case 2: // self-balancing_binary_tree,
             seqan3::debug_stream << "The self-balancing binary tree clustering method is not yet implemented\n";
@@ -161,9 +216,14 @@ void detect_variants_in_alignment_file(cmd_arguments const & args)
             seqan3::debug_stream << "The candidate selection based on voting clustering method is not yet implemented\n";
             break;
     }
+    return clusters;
+}
 
-    seqan3::debug_stream << "Done with clustering. Found " << clusters.size() << " junction clusters.\n";
-
+// Outputs the clusters and their variants.
+void output_clusters_and_variants(std::vector<Cluster> const & clusters,
+                                  std::map<std::string, int32_t> & references_lengths,
+                                  cmd_arguments const & args)
+{
     if (args.clusters_file_path != "")
     {
         std::ofstream clusters_file{args.clusters_file_path};
@@ -194,6 +254,351 @@ void detect_variants_in_alignment_file(cmd_arguments const & args)
     find_and_output_variants(references_lengths, clusters, args, args.output_file_path);
 }
 
+// Outputs the sorted junctions, clusters them and outputs the clusters and their variants.
+void cluster_and_output_junctions(std::vector<Junction> junctions,
+                                  std::map<std::string, int32_t> & references_lengths,
+                                  cmd_arguments const & args)
+{
+    if (args.junctions_file_path != "")
+    {
+        std::ofstream junctions_file{args.junctions_file_path};
+        if (!junctions_file.good() || !junctions_file.is_open())
+        {
+            throw std::runtime_error{"Could not open file '" + args.junctions_file_path.string() + "' for writing."};
+        }
+        for (Junction const & junction : junctions)
+        {
+            junctions_file << junction << "\n";
+        }
+        junctions_file.close();
+    }
+
+    seqan3::debug_stream << "Start clustering...\n";
+
+    std::vector<Cluster> clusters{};
+    if (args.cluster_checkpoint_path != "")
+    {
+        // The members are looked up in the clustered junctions.
+        clusters = cluster_junctions(junctions, args);
+        write_cluster_checkpoint(args.cluster_checkpoint_path, clusters, junctions, args);
+    }
+    else
+    {
+        clusters = cluster_junctions(std::move(junctions), args);
+    }
+
+    seqan3::debug_stream << "Done with clustering. Found " << clusters.size() << " junction clusters.\n";
+
+    output_clusters_and_variants(clusters, references_lengths, args);
+}
+
+void detect_variants_in_alignment_file(cmd_arguments const & args)
+{
+    // Store junctions
+    std::vector<Junction> junctions{};
+    std::map<std::string, int32_t> references_lengths{};
+
+    // short reads
+    if (args.alignment_short_reads_file_path != "")
+    {
+        seqan3::debug_stream << "Detect junctions in short reads...\n";
+        detect_junctions_in_short_reads_sam_file(junctions, references_lengths, args);
+    }
+
+    // long reads
+    if (args.alignment_long_reads_file_path != "")
+    {
+        seqan3::debug_stream << "Detect junctions in long reads...\n";
+        detect_junctions_in_long_reads_sam_file(junctions, references_lengths, args);
+    }
+
+    sort_junctions(junctions, args.threads);
+
+    if (args.junction_store_path != "")
+    {
+        write_junction_store(args.junction_store_path, junctions, references_lengths);
+    }
+
+    cluster_and_output_junctions(std::move(junctions), references_lengths, args);
+}
+
+void detect_variants_in_junction_store(cmd_arguments const & args)
+{
+    seqan3::debug_stream << "Load junctions from the junction store...\n";
+    // The junctions refer to the inserted sequences and read names in the mapped store.
+    junction_store const store{args.input_junction_store_path};
+    std::map<std::string, int32_t> references_lengths = store.references_lengths();
+    if (args.resume_from == resume_from_clusters)
+    {
+        seqan3::debug_stream << "Load clusters from the cluster checkpoint...\n";
+        std::vector<Cluster> const clusters = read_cluster_checkpoint(args.cluster_checkpoint_path,
+                                                                      store.junctions(),
+                                                                      args);
+        output_clusters_and_variants(clusters, references_lengths, args);
+        return;
+    }
+    cluster_and_output_junctions(store.junctions(), references_lengths, args);
+}
+
+// Opens an output file, throws if it can not be opened for writing.
+void open_output_file(std::ofstream & file, std::filesystem::path const & path)
+{
+    file.open(path);
+    if (!file.good() || !file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for writing."};
+    }
+}
+
+// Clusters batches of sorted junctions one after the other and outputs their junctions, clusters and variants right
+// away. The output files are opened on construction, as the batches are written while reading.
+class batch_output
+{
+private:
+    std::map<std::string, int32_t> & references_lengths;
+    cmd_arguments const & args;
+    std::ofstream junctions_file{};
+    std::ofstream clusters_file{};
+    std::ofstream vcf_file{};
+    std::ostream & out_stream;
+    // Collects the records of all batches and writes them in large blocks, after the header.
+    vcf_record_writer writer;
+    bool header_written{false};
+
+public:
+    size_t num_clusters{0};
+
+    batch_output(std::map<std::string, int32_t> & the_references_lengths, cmd_arguments const & the_args) :
+        references_lengths{the_references_lengths},
+        args{the_args},
+        out_stream{args.output_file_path.empty() ? std::cout : vcf_file},
+        writer{out_stream}
+    {
+        if (args.junctions_file_path != "")
+            open_output_file(junctions_file, args.junctions_file_path);
+        if (args.clusters_file_path != "")
+            open_output_file(clusters_file, args.clusters_file_path);
+        if (!args.output_file_path.empty())
+            open_output_file(vcf_file, args.output_file_path);
+    }
+
+    void operator()(std::vector<Junction> & junctions)
+    {
+        if (junctions_file.is_open())
+        {
+            for (Junction const & junction : junctions)
+                junctions_file << junction << "\n";
+        }
+        std::vector<Cluster> const clusters = cluster_junctions(std::move(junctions), args);
+        num_clusters += clusters.size();
+        if (clusters_file.is_open())
+        {
+            for (Cluster const & cluster : clusters)
+                clusters_file << cluster << "\n";
+        }
+        // The reference sequence dictionary is known once the first batch was detected.
+        if (!header_written)
+        {
+            output_vcf_header(references_lengths, args, out_stream);
+            header_written = true;
+        }
+        output_variants(clusters, args, writer);
+    }
+
+    // Writes the header if there was no batch and the remaining records.
+    void finish()
+    {
+        if (!header_written)
+            output_vcf_header(references_lengths, args, out_stream);
+        header_written = true;
+        writer.flush();
+    }
+};
+
+void detect_variants_in_alignment_file_streaming(cmd_arguments const & args)
+{
+    std::map<std::string, int32_t> references_lengths{};
+    batch_output output{references_lengths, args};
+
+    // Each released batch of sorted junctions is clustered and output right away.
+    junction_window window{args.max_var_length + args.max_overlap, [&] (std::vector<Junction> & junctions)
+    {
+        output(junctions);
+    }};
+
+    seqan3::debug_stream << "Detect and cluster junctions in long reads...\n";
+    detect_junctions_in_long_reads_sam_file([&] (sequence_id_t const seq_id,
+                                                 int32_t const position,
+                                                 std::vector<Junction> & junctions)
+    {
+        window.advance(seq_id, position);
+        for (Junction const & junction : junctions)
+            window.add(junction);
+        // Frees the inserted sequences and read names of the junctions which were output already.
+        window.compact_arena();
+    }, references_lengths, args);
+    window.finish();
+    output.finish();
+
+    seqan3::debug_stream << "Done with clustering. Found " << output.num_clusters << " junction clusters. "
+                         << window.num_late_junctions() << " junctions arrived after their region was clustered "
+                         << "and were clustered separately.\n";
+}
+
+void detect_variants_in_alignment_file_by_chromosome(cmd_arguments const & args)
+{
+    std::filesystem::path index_path{};
+    if (args.alignment_long_reads_file_path.extension() == ".bam")
+        index_path = bam_index::find_index_file(args.alignment_long_reads_file_path);
+    if (index_path.empty())
+    {
+        throw std::runtime_error{"The chromosome-wise mode needs a BAM file with an index (.bai/.csi)."};
+    }
+
+    std::map<std::string, int32_t> references_lengths{};
+    batch_output output{references_lengths, args};
+
+    // The junctions within a chromosome are clustered and output right after it, the ones between two chromosomes
+    // once both chromosomes have been analyzed.
+    contig_pair_buffer buffer{[&] (std::vector<Junction> & junctions)
+    {
+        output(junctions);
+    }};
+
+    seqan3::debug_stream << "Detect and cluster junctions in long reads chromosome by chromosome...\n";
+    detect_junctions_in_long_reads_bam_file_by_chromosome(references_lengths, args, index_path,
+                                                          [&] (sequence_id_t const seq_id,
+                                                               std::vector<Junction> & junctions)
+    {
+        buffer.add_sequence(seq_id, junctions);
+        // Frees the inserted sequences and read names of the junctions which were output already.
+        buffer.compact_arena();
+    });
+    buffer.finish();
+    output.finish();
+
+    seqan3::debug_stream << "Done with clustering. Found " << output.num_clusters << " junction clusters. "
+                         << buffer.num_late_junctions() << " junctions arrived after their chromosomes were "
+                         << "clustered and were clustered separately.\n";
+}
+
+void detect_variants_in_alignment_file_with_memory_limit(cmd_arguments const & args)
+{
+    std::map<std::string, int32_t> references_lengths{};
+    batch_output output{references_lengths, args};
+    external_junction_sorter sorter{static_cast<size_t>(args.max_memory) << 20};
+
+    // short reads
+    if (args.alignment_short_reads_file_path != "")
+    {
+        seqan3::debug_stream << "Detect junctions in short reads...\n";
+        std::vector<Junction> junctions{};
+        detect_junctions_in_short_reads_sam_file(junctions, references_lengths, args);
+        sorter.add(junctions);
+    }
+
+    // long reads
+    if (args.alignment_long_reads_file_path != "")
+    {
+        seqan3::debug_stream << "Detect junctions in long reads...\n";
+        detect_junctions_in_long_reads_sam_file([&] (sequence_id_t const,
+                                                     int32_t const,
+                                                     std::vector<Junction> & junctions)
+        {
+            sorter.add(junctions);
+        }, references_lengths, args);
+    }
+
+    seqan3::debug_stream << "Start clustering...\n";
+    if (sorter.num_runs() > 0)
+        seqan3::debug_stream << "The junctions were spilled to " << sorter.num_runs() << " temporary files.\n";
+
+    // The merged junctions are clustered in batches of complete partitions.
+    sorter.merge([&] (std::vector<Junction> & junctions)
+    {
+        output(junctions);
+    });
+    output.finish();
+
+    seqan3::debug_stream << "Done with clustering. Found " << output.num_clusters << " junction clusters.\n";
+}
+
+void detect_variants_in_alignment_file_sweep(cmd_arguments const & args)
+{
+    std::vector<parameter_combination> const combinations = parameter_sweep_combinations(args);
+
+    // Each distinct pair of min_var_length and max_overlap needs its own junctions.
+    auto same_junctions = [] (cmd_arguments const & lhs, cmd_arguments const & rhs)
+    {
+        return lhs.min_var_length == rhs.min_var_length && lhs.max_overlap == rhs.max_overlap;
+    };
+    std::vector<cmd_arguments> detection_args{};
+    for (parameter_combination const & combination : combinations)
+    {
+        if (detection_args.empty() || !same_junctions(detection_args.back(), combination.args))
+            detection_args.push_back(combination.args);
+    }
+
+    seqan3::debug_stream << "Detect junctions in long reads for " << detection_args.size()
+                         << " sets of detection parameters...\n";
+    std::vector<std::vector<Junction>> junctions(detection_args.size());
+    std::map<std::string, int32_t> references_lengths{};
+    if (detection_args.size() == 1)
+        detect_junctions_in_long_reads_sam_file(junctions[0], references_lengths, detection_args[0]);
+    else
+        detect_junctions_in_long_reads_sam_file(junctions, references_lengths, detection_args);
+    for (std::vector<Junction> & set_junctions : junctions)
+        sort_junctions(set_junctions, args.threads);
+
+    seqan3::debug_stream << "Start clustering and output of " << combinations.size() << " parameter combinations...\n";
+    std::filesystem::create_directories(args.sweep_output_directory);
+
+    // The combinations are sorted by their junctions and clustering cutoffs. The junctions of each set are clustered at
+    // all of their cutoffs at once, which shares the distance matrices and dendrograms of the partitions.
+    size_t junctions_index = 0;
+    for (size_t begin = 0; begin < combinations.size(); ++junctions_index)
+    {
+        size_t end = begin + 1;
+        while (end < combinations.size() && same_junctions(combinations[begin].args, combinations[end].args))
+            ++end;
+        std::vector<double> clustering_cutoffs{};
+        std::vector<size_t> cutoff_indices{};
+        for (size_t i = begin; i < end; ++i)
+        {
+            double const cutoff = combinations[i].args.hierarchical_clustering_cutoff;
+            if (clustering_cutoffs.empty() || clustering_cutoffs.back() != cutoff)
+                clustering_cutoffs.push_back(cutoff);
+            cutoff_indices.push_back(clustering_cutoffs.size() - 1);
+        }
+
+        std::vector<std::vector<Cluster>> clusters{};
+        if (args.clustering_method == hierarchical_clustering)
+        {
+            clusters = hierarchical_clustering_method(std::move(junctions[junctions_index]),
+                                                      clustering_cutoffs,
+                                                      args.threads,
+                                                      args.compaction_tolerance);
+        }
+        else
+        {
+            // The other clustering methods do not depend on the cutoff.
+            clusters.push_back(cluster_junctions(std::move(junctions[junctions_index]), combinations[begin].args));
+            std::ranges::fill(cutoff_indices, 0);
+        }
+        for (size_t i = begin; i < end; ++i)
+        {
+            find_and_output_variants(references_lengths,
+                                     clusters[cutoff_indices[i - begin]],
+                                     combinations[i].args,
+                                     combinations[i].output_file_path);
+        }
+        begin = end;
+    }
+
+    seqan3::debug_stream << "Done with the parameter sweep. Wrote " << combinations.size() << " VCF files to "
+                         << args.sweep_output_directory.string() << ".\n";
+}
+
 int main(int argc, char ** argv)
 {
     seqan3::argument_parser myparser{"iGenVar", argc, argv};    // initialise myparser
@@ -212,7 +617,8 @@ int main(int argc, char ** argv)
     }
 
     // Check if we have at least one input file.
-    if (args.alignment_short_reads_file_path == "" && args.alignment_long_reads_file_path == "")
+    if (args.alignment_short_reads_file_path == "" && args.alignment_long_reads_file_path == "" &&
+        args.input_junction_store_path == "" && args.resume_from == no_resume)
     {
         seqan3::debug_stream << "[Error] You need to input at least one sam/bam file.\n"
                              << "Please use -i or -input_short_reads to pass a short read file "
@@ -262,8 +668,129 @@ int main(int argc, char ** argv)
         seqan3::debug_stream << "[Error] You gave a negative hierarchical_clustering_cutoff parameter.\n";
         return -1;
     }
+    if (args.compaction_tolerance < 0)
+    {
+        seqan3::debug_stream << "[Error] You gave a negative compaction_tolerance parameter.\n";
+        return -1;
+    }
+    if (args.threads < 1 || args.decompression_threads < 1)
+    {
+        seqan3::debug_stream << "[Error] You need to specify at least one thread.\n";
+        return -1;
+    }
+    if (args.region_size < 0)
+    {
+        seqan3::debug_stream << "[Error] You gave a negative region_size parameter.\n";
+        return -1;
+    }
+
+    if (args.streaming && args.alignment_short_reads_file_path != "")
+    {
+        seqan3::debug_stream << "[Error] The streaming mode supports long read files only.\n";
+        return -1;
+    }
+    if (args.by_chromosome && args.alignment_short_reads_file_path != "")
+    {
+        seqan3::debug_stream << "[Error] The chromosome-wise mode supports long read files only.\n";
+        return -1;
+    }
+    if (args.streaming && args.by_chromosome)
+    {
+        seqan3::debug_stream << "[Error] The streaming mode and the chromosome-wise mode can not be combined.\n";
+        return -1;
+    }
+    if (args.max_memory < 0)
+    {
+        seqan3::debug_stream << "[Error] You gave a negative max_memory parameter.\n";
+        return -1;
+    }
+    if (args.max_memory > 0 && (args.streaming || args.by_chromosome))
+    {
+        seqan3::debug_stream << "[Error] The memory limit can not be combined with the streaming mode or the "
+                                "chromosome-wise mode.\n";
+        return -1;
+    }
+
+    if ((args.input_junction_store_path != "" || args.resume_from != no_resume) &&
+        (args.alignment_short_reads_file_path != "" || args.alignment_long_reads_file_path != ""))
+    {
+        seqan3::debug_stream << "[Error] A junction store can not be combined with alignment files.\n";
+        return -1;
+    }
+    if ((args.junction_store_path != "" || args.input_junction_store_path != "" ||
+         args.cluster_checkpoint_path != "" || args.resume_from != no_resume) &&
+        (args.streaming || args.by_chromosome || args.max_memory > 0))
+    {
+        seqan3::debug_stream << "[Error] The junction store can not be combined with the streaming mode, the "
+                                "chromosome-wise mode or the memory limit.\n";
+        return -1;
+    }
+    if (args.resume_from != no_resume && (args.input_junction_store_path == "" || args.junction_store_path != ""))
+    {
+        seqan3::debug_stream << "[Error] A resumed run needs the junction store of the previous run, please use "
+                                "--input_junction_store instead of --junction_store.\n";
+        return -1;
+    }
+    if (args.resume_from == resume_from_clusters && args.cluster_checkpoint_path == "")
+    {
+        seqan3::debug_stream << "[Error] A run resumed from clusters needs the cluster checkpoint of the previous "
+                                "run, please use --cluster_checkpoint.\n";
+        return -1;
+    }
+    // The checkpoint is read, so its validator for output files does not check that it exists.
+    if (args.resume_from == resume_from_clusters && !std::filesystem::exists(args.cluster_checkpoint_path))
+    {
+        seqan3::debug_stream << "[Error] The cluster checkpoint '" << args.cluster_checkpoint_path.string()
+                             << "' of the previous run does not exist.\n";
+        return -1;
+    }
+    if (args.cluster_checkpoint_path != "" && args.junction_store_path == "" && args.input_junction_store_path == "")
+    {
+        seqan3::debug_stream << "[Error] The cluster checkpoint needs a junction store, please use --junction_store "
+                                "or --input_junction_store.\n";
+        return -1;
+    }
+
+    if (!args.sweep.empty())
+    {
+        if (args.alignment_long_reads_file_path == "" || args.alignment_short_reads_file_path != "" ||
+            args.streaming || args.by_chromosome || args.max_memory > 0 || args.junction_store_path != "" ||
+            args.input_junction_store_path != "" || args.cluster_checkpoint_path != "")
+        {
+            seqan3::debug_stream << "[Error] The parameter sweep supports long read files only and can not be "
+                                    "combined with the streaming mode, the chromosome-wise mode, the memory limit, "
+                                    "the junction store or the cluster checkpoint.\n";
+            return -1;
+        }
+        if (args.sweep_output_directory == "")
+        {
+            seqan3::debug_stream << "[Error] The parameter sweep needs an output directory, please use "
+                                    "--sweep_output_directory.\n";
+            return -1;
+        }
+        try
+        {
+            parameter_sweep_combinations(args);
+        }
+        catch (std::runtime_error const & error)
+        {
+            seqan3::debug_stream << "[Error] " << error.what() << '\n';
+            return -1;
+        }
+    }
 
-    detect_variants_in_alignment_file(args);
+    if (!args.sweep.empty())
+        detect_variants_in_alignment_file_sweep(args);
+    else if (args.input_junction_store_path != "")
+        detect_variants_in_junction_store(args);
+    else if (args.streaming)
+        detect_variants_in_alignment_file_streaming(args);
+    else if (args.by_chromosome)
+        detect_variants_in_alignment_file_by_chromosome(args);
+    else if (args.max_memory > 0)
+        detect_variants_in_alignment_file_with_memory_limit(args);
+    else
+        detect_variants_in_alignment_file(args);
 
     return 0;
 }
@@ -0,0 +1,167 @@
+#include "modules/clustering/average_linkage.hpp"
+
+#include <algorithm>        // for std::stable_sort
+#include <limits>           // for std::numeric_limits
+#include <numeric>          // for std::iota
+
+namespace
+{
+enum cluster_state : uint8_t
+{
+    active,         // may still be merged
+    finished,       // no other cluster is closer than the cutoff
+    merged          // merged into another cluster
+};
+
+// Position of the distance of the objects i < j in the condensed distance matrix.
+inline size_t condensed_index(size_t const num_objects, size_t const i, size_t const j)
+{
+    return num_objects * i - i * (i + 1) / 2 + j - i - 1;
+}
+} // namespace
+
+void average_linkage(size_t const num_objects,
+                     double const clustering_cutoff,
+                     average_linkage_buffers & buffers,
+                     std::span<uint32_t const> const weights)
+{
+    std::vector<double> & distances = buffers.distances;
+    std::vector<uint32_t> & sizes = buffers.sizes;
+    std::vector<uint8_t> & states = buffers.states;
+    std::vector<uint32_t> & chain = buffers.chain;
+    std::vector<linkage_merge> & merges = buffers.merges;
+    merges.clear();
+    if (weights.empty())
+        sizes.assign(num_objects, 1);
+    else
+        sizes.assign(weights.begin(), weights.end());
+    states.assign(num_objects, active);
+    chain.clear();
+
+    auto distance = [&] (size_t const i, size_t const j) -> double &
+    {
+        return i < j ? distances[condensed_index(num_objects, i, j)] : distances[condensed_index(num_objects, j, i)];
+    };
+
+    uint32_t constexpr no_cluster = std::numeric_limits<uint32_t>::max();
+    uint32_t next_start = 0;
+    while (true)
+    {
+        if (chain.empty())
+        {
+            while (next_start < num_objects && states[next_start] != active)
+                ++next_start;
+            if (next_start == num_objects)
+                break;
+            chain.push_back(next_start);
+        }
+
+        uint32_t const current = chain.back();
+        uint32_t const previous = chain.size() > 1 ? chain[chain.size() - 2] : no_cluster;
+        // On ties the previous cluster of the chain stays the nearest neighbor, so that the chain terminates.
+        uint32_t nearest = no_cluster;
+        double nearest_distance = clustering_cutoff;
+        if (previous != no_cluster)
+        {
+            nearest = previous;
+            nearest_distance = distance(current, previous);
+        }
+        for (uint32_t other = next_start; other < num_objects; ++other)
+        {
+            if (other == current || states[other] != active)
+                continue;
+            double const other_distance = distance(current, other);
+            if (other_distance < nearest_distance)
+            {
+                nearest = other;
+                nearest_distance = other_distance;
+            }
+        }
+
+        if (nearest == no_cluster)
+        {
+            // Merges of other clusters only average the distances to this one, which stay at least the cutoff.
+            states[current] = finished;
+            chain.pop_back();
+        }
+        else if (nearest == previous)
+        {
+            chain.pop_back();
+            chain.pop_back();
+            uint32_t const kept = std::min(current, previous);
+            uint32_t const removed = std::max(current, previous);
+            merges.push_back(linkage_merge{kept, removed, nearest_distance});
+            // Average distance of the union to the other active clusters (Lance-Williams update).
+            double const kept_weight = static_cast<double>(sizes[kept]) / (sizes[kept] + sizes[removed]);
+            double const removed_weight = static_cast<double>(sizes[removed]) / (sizes[kept] + sizes[removed]);
+            for (uint32_t other = next_start; other < num_objects; ++other)
+            {
+                if (other == kept || other == removed || states[other] != active)
+                    continue;
+                distance(kept, other) = kept_weight * distance(kept, other) + removed_weight * distance(removed, other);
+            }
+            sizes[kept] += sizes[removed];
+            states[removed] = merged;
+        }
+        else
+        {
+            chain.push_back(nearest);
+        }
+    }
+
+    // The nearest neighbor chain finds the merges out of order.
+    std::stable_sort(merges.begin(), merges.end(), [] (linkage_merge const & lhs, linkage_merge const & rhs)
+    {
+        return lhs.height < rhs.height;
+    });
+
+    // Objects connected by merges get the same label. The merged clusters point to the ones they were merged into.
+    std::vector<uint32_t> & parents = buffers.parents;
+    parents.resize(num_objects);
+    std::iota(parents.begin(), parents.end(), 0);
+    for (linkage_merge const & merge : merges)
+        parents[merge.rhs] = merge.lhs;
+    buffers.labels.resize(num_objects);
+    int num_labels = 0;
+    for (uint32_t object = 0; object < num_objects; ++object)
+    {
+        // The parent of an object has a smaller index, so it is labeled already.
+        buffers.labels[object] = parents[object] == object ? num_labels++ : buffers.labels[parents[object]];
+    }
+}
+
+std::vector<int> cut_dendrogram(size_t const num_objects,
+                                std::span<linkage_merge const> const merges,
+                                double const clustering_cutoff)
+{
+    // Every set of connected objects is represented by its smallest object.
+    std::vector<uint32_t> roots(num_objects);
+    std::iota(roots.begin(), roots.end(), 0);
+    auto find_root = [&] (uint32_t object)
+    {
+        while (roots[object] != object)
+        {
+            roots[object] = roots[roots[object]];
+            object = roots[object];
+        }
+        return object;
+    };
+    for (linkage_merge const & merge : merges)
+    {
+        if (merge.height >= clustering_cutoff)
+            continue;
+        uint32_t const lhs_root = find_root(merge.lhs);
+        uint32_t const rhs_root = find_root(merge.rhs);
+        roots[std::max(lhs_root, rhs_root)] = std::min(lhs_root, rhs_root);
+    }
+
+    std::vector<int> labels(num_objects);
+    int num_labels = 0;
+    for (uint32_t object = 0; object < num_objects; ++object)
+    {
+        // The root of an object has a smaller index, so it is labeled already.
+        uint32_t const root = find_root(object);
+        labels[object] = root == object ? num_labels++ : labels[root];
+    }
+    return labels;
+}
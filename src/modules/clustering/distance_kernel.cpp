@@ -0,0 +1,130 @@
+#include "modules/clustering/distance_kernel.hpp"
+
+#include <cstdlib>          // for std::abs
+
+#if defined(__x86_64__) || defined(__i386__)
+#define IGENVAR_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Distances of junction i to the junctions i+1..n-1, written to `out`. The vectorized kernels compute the same sums of
+// absolute int32 differences in several lanes at once and fall back to this loop for the last junctions.
+void distance_row_scalar(junction_coordinates const & coordinates, size_t const i, size_t const j_begin, double * out)
+{
+    size_t const num_junctions = coordinates.mate1_positions.size();
+    for (size_t j = j_begin; j < num_junctions; ++j)
+    {
+        *out++ = std::abs(coordinates.mate1_positions[j] - coordinates.mate1_positions[i]) +
+                 std::abs(coordinates.mate2_positions[j] - coordinates.mate2_positions[i]) +
+                 std::abs(coordinates.inserted_sizes[j] - coordinates.inserted_sizes[i]);
+    }
+}
+
+#ifdef IGENVAR_X86_KERNELS
+// SSE2 has no absolute value of int32, it is computed as (x ^ sign) - sign.
+inline __m128i abs_difference_sse2(int32_t const * values, size_t const j, __m128i const reference)
+{
+    __m128i const difference = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const *>(values + j)),
+                                             reference);
+    __m128i const sign = _mm_srai_epi32(difference, 31);
+    return _mm_sub_epi32(_mm_xor_si128(difference, sign), sign);
+}
+
+void distance_row_sse2(junction_coordinates const & coordinates, size_t const i, double * out)
+{
+    size_t const num_junctions = coordinates.mate1_positions.size();
+    __m128i const mate1 = _mm_set1_epi32(coordinates.mate1_positions[i]);
+    __m128i const mate2 = _mm_set1_epi32(coordinates.mate2_positions[i]);
+    __m128i const inserted = _mm_set1_epi32(coordinates.inserted_sizes[i]);
+    size_t j = i + 1;
+    for (; j + 4 <= num_junctions; j += 4, out += 4)
+    {
+        __m128i const distance = _mm_add_epi32(
+            _mm_add_epi32(abs_difference_sse2(coordinates.mate1_positions.data(), j, mate1),
+                          abs_difference_sse2(coordinates.mate2_positions.data(), j, mate2)),
+            abs_difference_sse2(coordinates.inserted_sizes.data(), j, inserted));
+        _mm_storeu_pd(out, _mm_cvtepi32_pd(distance));
+        _mm_storeu_pd(out + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(distance, 0xEE)));
+    }
+    distance_row_scalar(coordinates, i, j, out);
+}
+
+__attribute__((target("avx2")))
+inline __m256i abs_difference_avx2(int32_t const * values, size_t const j, __m256i const reference)
+{
+    return _mm256_abs_epi32(_mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + j)),
+                                             reference));
+}
+
+__attribute__((target("avx2")))
+void distance_row_avx2(junction_coordinates const & coordinates, size_t const i, double * out)
+{
+    size_t const num_junctions = coordinates.mate1_positions.size();
+    __m256i const mate1 = _mm256_set1_epi32(coordinates.mate1_positions[i]);
+    __m256i const mate2 = _mm256_set1_epi32(coordinates.mate2_positions[i]);
+    __m256i const inserted = _mm256_set1_epi32(coordinates.inserted_sizes[i]);
+    size_t j = i + 1;
+    for (; j + 8 <= num_junctions; j += 8, out += 8)
+    {
+        __m256i const distance = _mm256_add_epi32(
+            _mm256_add_epi32(abs_difference_avx2(coordinates.mate1_positions.data(), j, mate1),
+                             abs_difference_avx2(coordinates.mate2_positions.data(), j, mate2)),
+            abs_difference_avx2(coordinates.inserted_sizes.data(), j, inserted));
+        _mm256_storeu_pd(out, _mm256_cvtepi32_pd(_mm256_castsi256_si128(distance)));
+        _mm256_storeu_pd(out + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(distance, 1)));
+    }
+    distance_row_scalar(coordinates, i, j, out);
+}
+#endif
+} // namespace
+
+distance_kernel best_distance_kernel()
+{
+#ifdef IGENVAR_X86_KERNELS
+    static distance_kernel const kernel = __builtin_cpu_supports("avx2") ? distance_kernel::avx2
+                                                                         : distance_kernel::sse2;
+    return kernel;
+#else
+    return distance_kernel::scalar;
+#endif
+}
+
+void load_coordinates(std::span<Junction const> const partition, junction_coordinates & coordinates)
+{
+    coordinates.mate1_positions.resize(partition.size());
+    coordinates.mate2_positions.resize(partition.size());
+    coordinates.inserted_sizes.resize(partition.size());
+    for (size_t i = 0; i < partition.size(); ++i)
+    {
+        coordinates.mate1_positions[i] = partition[i].get_mate1().position;
+        coordinates.mate2_positions[i] = partition[i].get_mate2().position;
+        coordinates.inserted_sizes[i] = partition[i].inserted_size();
+    }
+}
+
+void condensed_distances(junction_coordinates const & coordinates,
+                         std::vector<double> & distances,
+                         distance_kernel const kernel)
+{
+    size_t const num_junctions = coordinates.mate1_positions.size();
+    distances.resize(num_junctions * (num_junctions - (num_junctions > 0)) / 2);
+    double * out = distances.data();
+    for (size_t i = 0; i < num_junctions; out += num_junctions - i - 1, ++i)
+    {
+        switch (kernel)
+        {
+#ifdef IGENVAR_X86_KERNELS
+            case distance_kernel::avx2:
+                distance_row_avx2(coordinates, i, out);
+                break;
+            case distance_kernel::sse2:
+                distance_row_sse2(coordinates, i, out);
+                break;
+#endif
+            default:
+                distance_row_scalar(coordinates, i, i + 1, out);
+        }
+    }
+}
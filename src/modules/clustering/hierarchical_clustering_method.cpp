@@ -1,96 +1,94 @@
 #include "modules/clustering/hierarchical_clustering_method.hpp"
 
+#include <algorithm>                                              // for std::sort, std::is_sorted
+#include <iterator>                                               // for std::back_inserter
 #include <limits>                                                 // for infinity
-#include <random>                                                 // for random_device
+#include <numeric>                                                // for std::iota
+#include <utility>                                                // for std::pair
 
-#include <seqan3/core/debug_stream.hpp>
+#include "modules/clustering/average_linkage.hpp"                 // for average_linkage, cut_dendrogram
+#include "modules/clustering/distance_kernel.hpp"                 // for condensed_distances
+#include "modules/clustering/junction_compaction.hpp"             // for compact_junctions
+#include "modules/clustering/sparse_average_linkage.hpp"          // for sparse_average_linkage
+#include "structures/junction_sort.hpp"                           // for breakend_sort_key, sort_junction_indices
+#include "variant_detection/work_stealing_pool.hpp"               // for run_with_work_stealing
 
-#include "fastcluster.h"                                          // for hclust_fast
-
-std::vector<std::vector<Junction>> partition_junctions(std::vector<Junction> const & junctions)
+std::vector<std::span<Junction>> partition_junctions(std::vector<Junction> & junctions)
 {
-    // Partition based on mate 1
-    std::vector<Junction> current_partition{};
-    std::vector<std::vector<Junction>> current_partition_splitted;
-    std::vector<std::vector<Junction>> final_partitions{};
-
-    for (Junction const & junction : junctions)
+    // Partition based on mate 1: the junctions are sorted by mate 1, so its partitions are contiguous already
+    std::vector<std::span<Junction>> final_partitions{};
+    size_t partition_begin = 0;
+    for (size_t i = 1; i <= junctions.size(); ++i)
     {
-        if (current_partition.empty())
-        {
-            current_partition.push_back(junction);
-        }
-        else
+        if (i == junctions.size() || is_partition_border(junctions[i - 1].get_mate1(), junctions[i].get_mate1()))
         {
-            if (junction.get_mate1().seq_name != current_partition.back().get_mate1().seq_name ||
-                junction.get_mate1().orientation != current_partition.back().get_mate1().orientation ||
-                abs(junction.get_mate1().position - current_partition.back().get_mate1().position) > 50)
+            // Partition based on mate 2
+            std::span<Junction> const current_partition{junctions.data() + partition_begin, i - partition_begin};
+            for (std::span<Junction> const partition : split_partition_based_on_mate2(current_partition))
             {
-                // Partition based on mate 2
-                std::sort(current_partition.begin(), current_partition.end(), [](Junction const & a, Junction const & b) {
-                    return a.get_mate2() < b.get_mate2();
-                });
-                current_partition_splitted = split_partition_based_on_mate2(current_partition);
-                for (std::vector<Junction> partition : current_partition_splitted)
-                {
-                    final_partitions.push_back(partition);
-                }
-                current_partition.clear();
+                final_partitions.push_back(partition);
             }
-            current_partition.push_back(junction);
-        }
-    }
-    if (!current_partition.empty())
-    {
-        std::sort(current_partition.begin(), current_partition.end(), [](Junction a, Junction b) {
-            return a.get_mate2() < b.get_mate2();
-        });
-        current_partition_splitted = split_partition_based_on_mate2(current_partition);
-        for (std::vector<Junction> partition : current_partition_splitted)
-        {
-            final_partitions.push_back(partition);
+            partition_begin = i;
         }
     }
     return final_partitions;
 }
 
-std::vector<std::vector<Junction>> split_partition_based_on_mate2(std::vector<Junction> const & partition)
+std::vector<std::span<Junction>> split_partition_based_on_mate2(std::span<Junction> const partition)
 {
-    std::vector<Junction> current_partition{};
-    std::vector<std::vector<Junction>> splitted_partition{};
-
-    for (Junction const & junction : partition)
+    // Sort the indices of the junctions by the packed keys of their second mates and split them where the second
+    // mates are too far apart
+    std::vector<std::pair<uint64_t, size_t>> mate2_keys(partition.size());
+    for (size_t i = 0; i < partition.size(); ++i)
+    {
+        mate2_keys[i] = {breakend_sort_key(partition[i].get_mate2()), i};
+    }
+    std::sort(mate2_keys.begin(), mate2_keys.end());
+    std::vector<size_t> order(partition.size());
+    for (size_t i = 0; i < partition.size(); ++i)
+    {
+        order[i] = mate2_keys[i].second;
+    }
+    std::vector<size_t> split_positions{0};
+    for (size_t i = 1; i < order.size(); ++i)
     {
-        if (current_partition.empty())
+        if (is_partition_border(partition[order[i - 1]].get_mate2(), partition[order[i]].get_mate2()))
         {
-            current_partition.push_back(junction);
+            split_positions.push_back(i);
         }
-        else
+    }
+    split_positions.push_back(order.size());
+
+    // Sort the junctions of each sub-partition and apply the order, unless the partition is sorted already
+    for (size_t k = 0; k + 1 < split_positions.size(); ++k)
+    {
+        sort_junction_indices(partition,
+                              std::span{order}.subspan(split_positions[k], split_positions[k + 1] - split_positions[k]));
+    }
+    if (!std::is_sorted(order.begin(), order.end()))
+    {
+        std::vector<Junction> reordered{};
+        reordered.reserve(partition.size());
+        for (size_t const index : order)
         {
-            if (junction.get_mate2().seq_name != current_partition.back().get_mate2().seq_name ||
-                junction.get_mate2().orientation != current_partition.back().get_mate2().orientation ||
-                abs(junction.get_mate2().position - current_partition.back().get_mate2().position) > 50)
-            {
-                std::sort(current_partition.begin(), current_partition.end());
-                splitted_partition.push_back(current_partition);
-                current_partition.clear();
-            }
-            current_partition.push_back(junction);
+            reordered.push_back(std::move(partition[index]));
         }
+        std::move(reordered.begin(), reordered.end(), partition.begin());
     }
-    if (!current_partition.empty())
+
+    std::vector<std::span<Junction>> splitted_partition{};
+    for (size_t k = 0; k + 1 < split_positions.size(); ++k)
     {
-        std::sort(current_partition.begin(), current_partition.end());
-        splitted_partition.push_back(current_partition);
+        splitted_partition.push_back(partition.subspan(split_positions[k], split_positions[k + 1] - split_positions[k]));
     }
     return splitted_partition;
 }
 
 int junction_distance(Junction const & lhs, Junction const & rhs)
 {
-    if ((lhs.get_mate1().seq_name == rhs.get_mate1().seq_name) &&
+    if ((lhs.get_mate1().seq_id == rhs.get_mate1().seq_id) &&
         (lhs.get_mate1().orientation == rhs.get_mate1().orientation) &&
-        (lhs.get_mate2().seq_name == rhs.get_mate2().seq_name) &&
+        (lhs.get_mate2().seq_id == rhs.get_mate2().seq_id) &&
         (lhs.get_mate2().orientation == rhs.get_mate2().orientation))
     {
         // Reference:                      ................
@@ -99,7 +97,7 @@ int junction_distance(Junction const & lhs, Junction const & rhs)
         // Distance = 1 (distance A-C) + 2 (distance B-D) + 3 (absolute insertion size difference)
         return (std::abs(lhs.get_mate1().position - rhs.get_mate1().position) +
                 std::abs(lhs.get_mate2().position - rhs.get_mate2().position) +
-                std::abs((int)(lhs.get_inserted_sequence().size() - rhs.get_inserted_sequence().size())));
+                std::abs((int)(lhs.inserted_size() - rhs.inserted_size())));
     }
     else
     {
@@ -107,77 +105,104 @@ int junction_distance(Junction const & lhs, Junction const & rhs)
     }
 }
 
-inline std::vector<Junction> subsample_partition(std::vector<Junction> const & partition, uint16_t const sample_size)
+// Partitions with up to this many distinct junctions are clustered with the full distance matrix, larger ones with the
+// sparse average linkage, whose memory does not grow quadratically with the partition size.
+constexpr size_t max_dense_partition_size = 200;
+
+// Stores the coordinates and the weights of the representatives of the compacted junctions of one partition.
+void load_representatives(std::span<Junction const> const partition,
+                          compacted_junctions const & compacted,
+                          junction_coordinates & coordinates,
+                          std::vector<uint32_t> & weights)
 {
-    assert(partition.size() >= sample_size);
-    std::vector<Junction> subsample{};
-    std::sample(partition.begin(), partition.end(), std::back_inserter(subsample),
-                sample_size, std::mt19937{std::random_device{}()});
-    return subsample;
+    coordinates.mate1_positions.resize(compacted.size());
+    coordinates.mate2_positions.resize(compacted.size());
+    coordinates.inserted_sizes.resize(compacted.size());
+    weights.resize(compacted.size());
+    for (size_t i = 0; i < compacted.size(); ++i)
+    {
+        Junction const & representative = partition[compacted.representative(i)];
+        coordinates.mate1_positions[i] = representative.get_mate1().position;
+        coordinates.mate2_positions[i] = representative.get_mate2().position;
+        coordinates.inserted_sizes[i] = representative.inserted_size();
+        weights[i] = compacted.weight(i);
+    }
 }
 
-std::vector<Cluster> hierarchical_clustering_method(std::vector<Junction> const & junctions,
-                                                    double clustering_cutoff)
+// Clusters the junctions of one partition at every cutoff and appends the clusters of the cutoff k to `clusters[k]`.
+// The junctions are moved into the clusters of a single cutoff and copied for several cutoffs.
+void cluster_partition(std::span<Junction> const partition,
+                       std::span<double const> const clustering_cutoffs,
+                       int32_t const compaction_tolerance,
+                       std::span<std::vector<Cluster>> const clusters)
 {
-    auto partitions = partition_junctions(junctions);
-    std::vector<Cluster> clusters{};
-    // Set the maximum partition size that is still feasible to cluster in reasonable time
-    // A trade-off between reducing runtime and keeping as many junctions as possible has to be made
-    const size_t max_partition_size = 200;
-    for (std::vector<Junction> & partition : partitions)
-    {
-        size_t partition_size = partition.size();
-        if (partition_size < 2)
-        {
-            clusters.emplace_back(std::move(partition));
-            continue;
-        }
-        if (partition_size > max_partition_size)
+    bool const move_junctions = clustering_cutoffs.size() == 1;
+    auto take_junction = [&] (Junction & junction) -> Junction
+    {
+        if (move_junctions)
+            return std::move(junction);
+        return junction;
+    };
+    double const max_cutoff = *std::max_element(clustering_cutoffs.begin(), clustering_cutoffs.end());
+    size_t const partition_size = partition.size();
+    // Nothing is merged, not even identical junctions, as the cutoff is exclusive.
+    if (partition_size < 2 || max_cutoff <= 0)
+    {
+        for (std::vector<Cluster> & cutoff_clusters : clusters)
         {
-            seqan3::debug_stream << "A partition exceeds the maximum size ("
-                                 << partition_size
-                                 << ">"
-                                 << max_partition_size
-                                 << ") and has to be subsampled. Representative partition member:\n["
-                                 << partition[0].get_mate1()
-                                 << "] -> ["
-                                 << partition[0].get_mate2()
-                                 << "]\n";
-            partition = subsample_partition(partition, max_partition_size);
-            partition_size = max_partition_size;
-        }
-        // Compute condensed distance matrix (upper triangle of the full distance matrix)
-        std::vector<double> distmat ((partition_size * (partition_size - 1)) / 2);
-        int k, i, j;
-        for (i = k = 0; i < partition_size; ++i) {
-            for (j = i + 1; j< partition_size; ++j) {
-                // Compute distance between junctions i and j
-                distmat[k] = junction_distance(partition[i], partition[j]);
-                ++k;
-            }
+            for (Junction & junction : partition)
+                cutoff_clusters.emplace_back(std::vector<Junction>{take_junction(junction)});
         }
+        return;
+    }
+
+    // Collapse identical junctions into weighted representatives, which are clustered instead of the junctions. A
+    // representative of weight k starts as a cluster of k junctions at distance 0, so the clusters do not change.
+    compacted_junctions const compacted = compact_junctions(partition, compaction_tolerance);
+    thread_local junction_coordinates coordinates{};
+    thread_local std::vector<uint32_t> weights{};
+    load_representatives(partition, compacted, coordinates, weights);
+
+    // Buffers of the average linkage, reused for all partitions clustered by the same thread.
+    thread_local average_linkage_buffers buffers{};
+    if (compacted.size() > max_dense_partition_size)
+    {
+        // Fill labels[i] with cluster label of representative i and the merges, without the quadratic distance matrix.
+        buffers.labels = sparse_average_linkage(coordinates, weights, max_cutoff, buffers.merges);
+    }
+    else
+    {
+        // Compute condensed distance matrix (upper triangle of the full distance matrix) of the representatives, with
+        // the fastest kernel supported by the CPU
+        condensed_distances(coordinates, buffers.distances);
 
-        // Perform hierarchical clustering
-        // `height` is filled with cluster distance for each step
-        // `merge` contains dendrogram
-        std::vector<int> merge (2 * (partition_size - 1));
-        std::vector<double> height (partition_size - 1);
-        hclust_fast(partition_size, distmat.data(), HCLUST_METHOD_AVERAGE, merge.data(), height.data());
+        // Perform hierarchical clustering and fill labels[i] with cluster label of representative i.
+        // Clustering is stopped before the first merge with cluster distance >= the largest cutoff
+        average_linkage(compacted.size(), max_cutoff, buffers, weights);
+    }
 
-        // Fill labels[i] with cluster label of junction i.
-        // Clustering is stopped at step with cluster distance >= clustering_cutoff
-        std::vector<int> labels (partition_size);
-        cutree_cdist(partition_size, merge.data(), height.data(), clustering_cutoff, labels.data());
+    // The dendrogram up to the largest cutoff is cut at every other cutoff.
+    for (size_t k = 0; k < clustering_cutoffs.size(); ++k)
+    {
+        if (clustering_cutoffs[k] <= 0)
+        {
+            for (Junction & junction : partition)
+                clusters[k].emplace_back(std::vector<Junction>{take_junction(junction)});
+            continue;
+        }
+        std::vector<int> cut_labels{};
+        if (clustering_cutoffs[k] != max_cutoff)
+            cut_labels = cut_dendrogram(compacted.size(), buffers.merges, clustering_cutoffs[k]);
+        std::vector<int> const & labels = clustering_cutoffs[k] == max_cutoff ? buffers.labels : cut_labels;
 
+        // The members of a representative get its label.
         std::unordered_map<int, std::vector<Junction>> label_to_junctions{};
-        for (int i = 0; i < partition_size; ++i)
+        for (size_t i = 0; i < compacted.size(); ++i)
         {
-            if (label_to_junctions.find(labels[i]) != label_to_junctions.end())
+            std::vector<Junction> & cluster_junctions = label_to_junctions[labels[i]];
+            for (uint32_t const member : compacted.members_of(i))
             {
-                label_to_junctions[labels[i]].push_back(std::move(partition[i]));
-            }
-            else{
-                label_to_junctions.emplace(labels[i], std::vector{std::move(partition[i])});
+                cluster_junctions.push_back(take_junction(partition[member]));
             }
         }
 
@@ -185,9 +210,66 @@ std::vector<Cluster> hierarchical_clustering_method(std::vector<Junction> const
         for (auto & [lab, jun] : label_to_junctions )
         {
             std::sort(jun.begin(), jun.end());
-            clusters.emplace_back(jun);
+            clusters[k].emplace_back(std::move(jun));
         }
     }
-    std::sort(clusters.begin(), clusters.end());
+}
+
+// Clusters the partitions in parallel at every cutoff and returns the sorted clusters of each cutoff.
+std::vector<std::vector<Cluster>> cluster_partitions(std::vector<std::span<Junction>> const & partitions,
+                                                     std::span<double const> const clustering_cutoffs,
+                                                     size_t const threads,
+                                                     int32_t const compaction_tolerance)
+{
+    // The partitions are independent of each other. The largest ones are started first, so that they don't delay the
+    // end of the parallel clustering.
+    std::vector<size_t> partition_order(partitions.size());
+    std::iota(partition_order.begin(), partition_order.end(), 0);
+    std::stable_sort(partition_order.begin(), partition_order.end(), [&] (size_t const a, size_t const b)
+    {
+        return partitions[a].size() > partitions[b].size();
+    });
+    size_t const num_cutoffs = clustering_cutoffs.size();
+    std::vector<std::vector<Cluster>> partition_clusters(partitions.size() * num_cutoffs);
+    run_with_work_stealing(partition_order, threads, [&] (size_t const index)
+    {
+        cluster_partition(partitions[index],
+                          clustering_cutoffs,
+                          compaction_tolerance,
+                          std::span{partition_clusters}.subspan(index * num_cutoffs, num_cutoffs));
+    });
+
+    // Merge the clusters in the order of the partitions, so that the result does not depend on the number of threads.
+    std::vector<std::vector<Cluster>> clusters(num_cutoffs);
+    for (size_t k = 0; k < num_cutoffs; ++k)
+    {
+        for (size_t index = 0; index < partitions.size(); ++index)
+        {
+            std::vector<Cluster> & current_clusters = partition_clusters[index * num_cutoffs + k];
+            std::move(current_clusters.begin(), current_clusters.end(), std::back_inserter(clusters[k]));
+        }
+        std::sort(clusters[k].begin(), clusters[k].end());
+    }
     return clusters;
 }
+
+std::vector<Cluster> hierarchical_clustering_method(std::vector<Junction> junctions,
+                                                    double clustering_cutoff,
+                                                    size_t const threads,
+                                                    int32_t const compaction_tolerance)
+{
+    auto partitions = partition_junctions(junctions);
+    std::span<double const> const clustering_cutoffs{&clustering_cutoff, 1};
+    return std::move(cluster_partitions(partitions, clustering_cutoffs, threads, compaction_tolerance)[0]);
+}
+
+std::vector<std::vector<Cluster>> hierarchical_clustering_method(std::vector<Junction> junctions,
+                                                                 std::vector<double> const & clustering_cutoffs,
+                                                                 size_t const threads,
+                                                                 int32_t const compaction_tolerance)
+{
+    if (clustering_cutoffs.empty())
+        return {};
+    auto partitions = partition_junctions(junctions);
+    return cluster_partitions(partitions, clustering_cutoffs, threads, compaction_tolerance);
+}
@@ -0,0 +1,89 @@
+#include "modules/clustering/junction_compaction.hpp"
+
+#include <algorithm>    // for std::sort
+#include <cstdlib>      // for std::abs
+#include <tuple>
+
+#include "structures/junction_sort.hpp"     // for breakend_sort_key
+
+compacted_junctions compact_junctions(std::span<Junction const> const junctions, int32_t const tolerance)
+{
+    compacted_junctions compacted{};
+    compacted.members.reserve(junctions.size());
+
+    // Sort the junctions by their breakends and inserted sizes, the index breaks ties.
+    std::vector<std::tuple<uint64_t, uint64_t, int32_t, uint32_t>> keys{};
+    keys.reserve(junctions.size());
+    for (uint32_t i = 0; i < junctions.size(); ++i)
+    {
+        keys.emplace_back(breakend_sort_key(junctions[i].get_mate1()),
+                          breakend_sort_key(junctions[i].get_mate2()),
+                          static_cast<int32_t>(junctions[i].inserted_size()),
+                          i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    if (tolerance <= 0)
+    {
+        // Identical junctions are neighbors in sorted order.
+        for (size_t k = 0; k < keys.size(); ++k)
+        {
+            if (k > 0 && std::tie(std::get<0>(keys[k]), std::get<1>(keys[k]), std::get<2>(keys[k])) !=
+                         std::tie(std::get<0>(keys[k - 1]), std::get<1>(keys[k - 1]), std::get<2>(keys[k - 1])))
+            {
+                compacted.member_offsets.push_back(k);
+            }
+            compacted.members.push_back(std::get<3>(keys[k]));
+        }
+        if (!keys.empty())
+            compacted.member_offsets.push_back(keys.size());
+        return compacted;
+    }
+
+    // Every junction, which is not a member yet, becomes a representative and collects the following junctions in
+    // reach. They have the same sequence name and orientation of the first mate and a close first mate position.
+    std::vector<bool> assigned(keys.size(), false);
+    for (size_t k = 0; k < keys.size(); ++k)
+    {
+        if (assigned[k])
+            continue;
+        Junction const & representative = junctions[std::get<3>(keys[k])];
+        compacted.members.push_back(std::get<3>(keys[k]));
+        for (size_t l = k + 1; l < keys.size(); ++l)
+        {
+            Junction const & junction = junctions[std::get<3>(keys[l])];
+            if (junction.get_mate1().seq_id != representative.get_mate1().seq_id ||
+                junction.get_mate1().orientation != representative.get_mate1().orientation ||
+                junction.get_mate1().position - representative.get_mate1().position > tolerance)
+            {
+                break;
+            }
+            if (!assigned[l] &&
+                junction.get_mate2().seq_id == representative.get_mate2().seq_id &&
+                junction.get_mate2().orientation == representative.get_mate2().orientation &&
+                std::abs(junction.get_mate2().position - representative.get_mate2().position) <= tolerance &&
+                std::abs(std::get<2>(keys[l]) - std::get<2>(keys[k])) <= tolerance)
+            {
+                assigned[l] = true;
+                compacted.members.push_back(std::get<3>(keys[l]));
+            }
+        }
+        compacted.member_offsets.push_back(compacted.members.size());
+    }
+    return compacted;
+}
+
+compacted_junctions compact_equal_junctions(std::span<Junction const> const junctions)
+{
+    compacted_junctions compacted{};
+    compacted.members.reserve(junctions.size());
+    for (uint32_t i = 0; i < junctions.size(); ++i)
+    {
+        if (i > 0 && junctions[i] != junctions[compacted.members[compacted.member_offsets.back()]])
+            compacted.member_offsets.push_back(i);
+        compacted.members.push_back(i);
+    }
+    if (!junctions.empty())
+        compacted.member_offsets.push_back(junctions.size());
+    return compacted;
+}
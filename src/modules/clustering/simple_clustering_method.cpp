@@ -2,27 +2,24 @@
 
 #include <seqan3/core/debug_stream.hpp>
 
+#include "modules/clustering/junction_compaction.hpp"   // for compact_equal_junctions
+
 std::vector<Cluster> simple_clustering_method(std::vector<Junction> const & junctions)
 {
     std::vector<Cluster> clusters{};
     if (junctions.size() > 0)
     {
-        std::vector<Junction> current_cluster_members = {junctions[0]};
-        size_t i = 1;
-        while (i < junctions.size())
+        // Equal neighbors are collapsed into weighted representatives, each of which becomes one cluster.
+        compacted_junctions const compacted = compact_equal_junctions(junctions);
+        clusters.reserve(compacted.size());
+        for (size_t i = 0; i < compacted.size(); ++i)
         {
-            if (junctions[i] == current_cluster_members.back())
-            {
-                current_cluster_members.push_back(junctions[i]);
-            }
-            else
-            {
-                clusters.emplace_back(std::move(current_cluster_members));
-                current_cluster_members = {junctions[i]};
-            }
-            ++i;
+            std::vector<Junction> members{};
+            members.reserve(compacted.weight(i));
+            for (uint32_t const member : compacted.members_of(i))
+                members.push_back(junctions[member]);
+            clusters.emplace_back(std::move(members));
         }
-        clusters.emplace_back(std::move(current_cluster_members));
     }
     else
     {
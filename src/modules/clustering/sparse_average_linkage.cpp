@@ -0,0 +1,426 @@
+#include "modules/clustering/sparse_average_linkage.hpp"
+
+#include <algorithm>        // for std::sort, std::lower_bound, std::find_if
+#include <array>
+#include <bit>              // for std::bit_width
+#include <cstdlib>          // for std::abs
+#include <limits>           // for std::numeric_limits
+#include <numeric>          // for std::iota
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+// Distinct junction of a partition: mate positions and inserted size, and the number of identical junctions.
+struct weighted_point
+{
+    std::array<int32_t, 3> coordinates;
+    int64_t weight;
+};
+
+// Number of junctions at each coordinate of one dimension, sorted by the coordinate.
+using marginal_entries = std::vector<std::pair<int32_t, int64_t>>;
+
+// Runs with fewer coordinates are always traversed completely and need no prefix sums.
+constexpr size_t min_indexed_run_size = 16;
+
+// Sorted part of a marginal with the prefix sums of the numbers of junctions and of their coordinates, so that the
+// distance sum to a single coordinate is found by a binary search.
+struct marginal_run
+{
+    marginal_entries entries{};
+    std::vector<int64_t> count_prefix{};
+    std::vector<int64_t> coordinate_prefix{};
+
+    explicit marginal_run(marginal_entries the_entries) : entries{std::move(the_entries)}
+    {
+        if (entries.size() < min_indexed_run_size)
+            return;
+        count_prefix.resize(entries.size() + 1);
+        coordinate_prefix.resize(entries.size() + 1);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            count_prefix[i + 1] = count_prefix[i] + entries[i].second;
+            coordinate_prefix[i + 1] = coordinate_prefix[i] + entries[i].second * entries[i].first;
+        }
+    }
+
+    // Sum of the distances of the coordinate to all coordinates of the run.
+    int64_t distance_sum(int32_t const coordinate) const
+    {
+        size_t const smaller = std::lower_bound(entries.begin(),
+                                                entries.end(),
+                                                coordinate,
+                                                [] (auto const & entry, int32_t const value)
+                                                {
+                                                    return entry.first < value;
+                                                }) - entries.begin();
+        int64_t const smaller_count = count_prefix[smaller];
+        int64_t const smaller_sum = coordinate_prefix[smaller];
+        return (coordinate * smaller_count - smaller_sum) +
+               (coordinate_prefix.back() - smaller_sum - coordinate * (count_prefix.back() - smaller_count));
+    }
+};
+
+/* The marginal of a cluster in one dimension, as sorted runs of decreasing size. A merge appends the runs of the
+ * smaller cluster and only merges runs of similar sizes, so that every coordinate is copied O(log n) times in total
+ * instead of on every merge, and a marginal has O(log n) runs.
+ */
+using marginal = std::vector<marginal_run>;
+
+// Sum of the distances of all pairs of coordinates of two runs.
+int64_t run_distance_sum(marginal_run const & lhs, marginal_run const & rhs)
+{
+    marginal_entries const & smaller = lhs.entries.size() <= rhs.entries.size() ? lhs.entries : rhs.entries;
+    marginal_run const & larger = lhs.entries.size() <= rhs.entries.size() ? rhs : lhs;
+    // The coordinates of a much smaller run are looked up in the larger run, e.g. for the merges with single points.
+    if (larger.entries.size() >= min_indexed_run_size &&
+        smaller.size() * std::bit_width(larger.entries.size()) < larger.entries.size())
+    {
+        int64_t sum = 0;
+        for (auto const & [coordinate, count] : smaller)
+            sum += count * larger.distance_sum(coordinate);
+        return sum;
+    }
+
+    // Otherwise, both runs are traversed once.
+    int64_t sum = 0;
+    int64_t lhs_count = 0, lhs_coordinate_sum = 0;
+    int64_t rhs_count = 0, rhs_coordinate_sum = 0;
+    auto lhs_it = lhs.entries.begin();
+    auto rhs_it = rhs.entries.begin();
+    while (lhs_it != lhs.entries.end() || rhs_it != rhs.entries.end())
+    {
+        // Every coordinate contributes its distance to all smaller coordinates of the other run.
+        if (rhs_it == rhs.entries.end() || (lhs_it != lhs.entries.end() && lhs_it->first <= rhs_it->first))
+        {
+            auto const [coordinate, count] = *lhs_it++;
+            sum += count * (coordinate * rhs_count - rhs_coordinate_sum);
+            lhs_count += count;
+            lhs_coordinate_sum += count * coordinate;
+        }
+        else
+        {
+            auto const [coordinate, count] = *rhs_it++;
+            sum += count * (coordinate * lhs_count - lhs_coordinate_sum);
+            rhs_count += count;
+            rhs_coordinate_sum += count * coordinate;
+        }
+    }
+    return sum;
+}
+
+// Sum of the distances of all pairs of coordinates of two marginals.
+int64_t marginal_distance_sum(marginal const & lhs, marginal const & rhs)
+{
+    int64_t sum = 0;
+    for (marginal_run const & lhs_run : lhs)
+        for (marginal_run const & rhs_run : rhs)
+            sum += run_distance_sum(lhs_run, rhs_run);
+    return sum;
+}
+
+marginal_entries merge_entries(marginal_entries const & lhs, marginal_entries const & rhs)
+{
+    marginal_entries merged{};
+    merged.reserve(lhs.size() + rhs.size());
+    auto lhs_it = lhs.begin();
+    auto rhs_it = rhs.begin();
+    while (lhs_it != lhs.end() || rhs_it != rhs.end())
+    {
+        if (rhs_it == rhs.end() || (lhs_it != lhs.end() && lhs_it->first < rhs_it->first))
+            merged.push_back(*lhs_it++);
+        else if (lhs_it == lhs.end() || rhs_it->first < lhs_it->first)
+            merged.push_back(*rhs_it++);
+        else
+        {
+            merged.emplace_back(lhs_it->first, lhs_it->second + rhs_it->second);
+            ++lhs_it;
+            ++rhs_it;
+        }
+    }
+    return merged;
+}
+
+// Inserts the run into the marginal, whose runs are sorted by decreasing size.
+void insert_run(marginal & runs, marginal_run && run)
+{
+    auto const position = std::find_if(runs.begin(), runs.end(), [&] (marginal_run const & other)
+    {
+        return other.entries.size() < run.entries.size();
+    });
+    runs.insert(position, std::move(run));
+}
+
+// Moves the runs of `merged` into `kept`. Adjacent runs are merged until every run is more than twice as large as the
+// next one.
+void merge_marginals(marginal & kept, marginal && merged)
+{
+    for (marginal_run & run : merged)
+        insert_run(kept, std::move(run));
+    for (size_t i = 1; i < kept.size(); )
+    {
+        if (kept[i - 1].entries.size() > 2 * kept[i].entries.size())
+        {
+            ++i;
+            continue;
+        }
+        marginal_run run{merge_entries(kept[i - 1].entries, kept[i].entries)};
+        kept.erase(kept.begin() + i - 1, kept.begin() + i + 1);
+        insert_run(kept, std::move(run));
+        i = 1;
+    }
+}
+
+struct linkage_cluster
+{
+    int64_t weight{};                               // number of junctions
+    bool finished{false};                           // no other cluster is closer than the cutoff
+    std::vector<uint32_t> points{};
+    std::array<marginal, 3> marginals{};
+    // Adjacent clusters and the sum of the distances between all pairs of their junctions.
+    std::unordered_map<uint32_t, int64_t> neighbors{};
+};
+
+// Sum of the distances between all pairs of junctions of two clusters. The distance is the sum of the differences of
+// the single coordinates, so it can be summed up per coordinate.
+int64_t distance_sum(linkage_cluster const & lhs, linkage_cluster const & rhs)
+{
+    int64_t sum = 0;
+    for (size_t dimension = 0; dimension < 3; ++dimension)
+        sum += marginal_distance_sum(lhs.marginals[dimension], rhs.marginals[dimension]);
+    return sum;
+}
+} // namespace
+
+std::vector<int> sparse_average_linkage(std::span<Junction const> const partition, double const clustering_cutoff)
+{
+    junction_coordinates coordinates{};
+    load_coordinates(partition, coordinates);
+    return sparse_average_linkage(coordinates, {}, clustering_cutoff);
+}
+
+std::vector<int> sparse_average_linkage(junction_coordinates const & coordinates,
+                                        std::span<uint32_t const> const weights,
+                                        double const clustering_cutoff)
+{
+    std::vector<linkage_merge> merges{};
+    return sparse_average_linkage(coordinates, weights, clustering_cutoff, merges);
+}
+
+std::vector<int> sparse_average_linkage(junction_coordinates const & coordinates,
+                                        std::span<uint32_t const> const weights,
+                                        double const clustering_cutoff,
+                                        std::vector<linkage_merge> & merges)
+{
+    merges.clear();
+    size_t const num_objects = coordinates.mate1_positions.size();
+    std::vector<int> labels(num_objects);
+    // Nothing is merged, not even identical junctions, as the cutoff is exclusive.
+    if (clustering_cutoff <= 0 || num_objects == 0)
+    {
+        std::iota(labels.begin(), labels.end(), 0);
+        return labels;
+    }
+
+    // Collapse identical junctions into weighted points, sorted by their coordinates. The coordinates are relative to
+    // the first junction to keep the distance sums small.
+    int32_t const mate1_offset = coordinates.mate1_positions[0];
+    int32_t const mate2_offset = coordinates.mate2_positions[0];
+    std::vector<std::tuple<int32_t, int32_t, int32_t, uint32_t>> keys{};
+    keys.reserve(num_objects);
+    for (uint32_t i = 0; i < num_objects; ++i)
+    {
+        keys.emplace_back(coordinates.mate1_positions[i] - mate1_offset,
+                          coordinates.mate2_positions[i] - mate2_offset,
+                          coordinates.inserted_sizes[i],
+                          i);
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<weighted_point> points{};
+    std::vector<uint32_t> point_of_junction(num_objects);
+    // The first junction of every point stands for the point in the merges.
+    std::vector<uint32_t> first_junction_of_point{};
+    for (auto const & [mate1_position, mate2_position, inserted_size, junction] : keys)
+    {
+        std::array<int32_t, 3> const point_coordinates{mate1_position, mate2_position, inserted_size};
+        if (points.empty() || points.back().coordinates != point_coordinates)
+        {
+            points.push_back(weighted_point{point_coordinates, 0});
+            first_junction_of_point.push_back(junction);
+        }
+        else
+        {
+            merges.push_back(linkage_merge{first_junction_of_point.back(), junction, 0.0});
+        }
+        points.back().weight += weights.empty() ? 1 : weights[junction];
+        point_of_junction[junction] = points.size() - 1;
+    }
+
+    std::vector<linkage_cluster> clusters(points.size());
+    for (uint32_t i = 0; i < points.size(); ++i)
+    {
+        clusters[i].weight = points[i].weight;
+        clusters[i].points.push_back(i);
+        for (size_t dimension = 0; dimension < 3; ++dimension)
+            clusters[i].marginals[dimension].emplace_back(marginal_entries{{points[i].coordinates[dimension],
+                                                                             points[i].weight}});
+    }
+    // Find the pairs of points closer than the cutoff. The points are sorted by the position of the first mate, which
+    // alone differs by less than the cutoff for all of them.
+    auto for_each_close_pair = [&] (auto && callback)
+    {
+        for (uint32_t i = 0; i < points.size(); ++i)
+        {
+            for (uint32_t j = i + 1;
+                 j < points.size() && points[j].coordinates[0] - points[i].coordinates[0] < clustering_cutoff;
+                 ++j)
+            {
+                int64_t distance = 0;
+                for (size_t dimension = 0; dimension < 3; ++dimension)
+                    distance += std::abs(points[i].coordinates[dimension] - points[j].coordinates[dimension]);
+                if (distance < clustering_cutoff)
+                    callback(i, j, distance);
+            }
+        }
+    };
+    // The neighbors are counted first to allocate the hash maps only once.
+    std::vector<uint32_t> num_neighbors(points.size());
+    for_each_close_pair([&] (uint32_t const i, uint32_t const j, int64_t)
+    {
+        ++num_neighbors[i];
+        ++num_neighbors[j];
+    });
+    for (uint32_t i = 0; i < points.size(); ++i)
+        clusters[i].neighbors.reserve(num_neighbors[i]);
+    for_each_close_pair([&] (uint32_t const i, uint32_t const j, int64_t const distance)
+    {
+        int64_t const sum = points[i].weight * points[j].weight * distance;
+        clusters[i].neighbors.emplace(j, sum);
+        clusters[j].neighbors.emplace(i, sum);
+    });
+
+    auto average_distance = [&] (uint32_t const lhs, uint32_t const rhs, int64_t const sum)
+    {
+        return static_cast<double>(sum) / (static_cast<double>(clusters[lhs].weight) * clusters[rhs].weight);
+    };
+
+    // Merges the clusters `lhs` and `rhs`. The larger one absorbs the smaller one, its neighbors and marginals are
+    // updated in place.
+    auto merge_clusters = [&] (uint32_t const lhs, uint32_t const rhs)
+    {
+        bool const lhs_larger = clusters[lhs].points.size() >= clusters[rhs].points.size();
+        uint32_t const kept_id = lhs_larger ? lhs : rhs;
+        uint32_t const merged_id = lhs_larger ? rhs : lhs;
+        linkage_cluster & kept = clusters[kept_id];
+        linkage_cluster & merged = clusters[merged_id];
+
+        // The distance sum of the union to a neighbor is the sum of the distance sums of both parts.
+        kept.neighbors.erase(merged_id);
+        for (auto & [neighbor, sum] : kept.neighbors)
+        {
+            auto const it = merged.neighbors.find(neighbor);
+            sum += it != merged.neighbors.end() ? it->second : distance_sum(merged, clusters[neighbor]);
+        }
+        for (auto const & [neighbor, sum] : merged.neighbors)
+        {
+            if (neighbor == kept_id)
+                continue;
+            auto const [it, inserted] = kept.neighbors.try_emplace(neighbor, sum);
+            if (inserted)
+                it->second += distance_sum(kept, clusters[neighbor]);
+        }
+        for (auto const & [neighbor, sum] : kept.neighbors)
+        {
+            clusters[neighbor].neighbors.erase(merged_id);
+            clusters[neighbor].neighbors.insert_or_assign(kept_id, sum);
+        }
+
+        kept.weight += merged.weight;
+        kept.points.insert(kept.points.end(), merged.points.begin(), merged.points.end());
+        for (size_t dimension = 0; dimension < 3; ++dimension)
+            merge_marginals(kept.marginals[dimension], std::move(merged.marginals[dimension]));
+        merged = linkage_cluster{};
+    };
+
+    // Average linkage is reducible, so merging reciprocal nearest neighbors in any order yields the same clusters as
+    // merging the globally closest pair first (nearest neighbor chain). A cluster whose nearest neighbor is not closer
+    // than the cutoff is finished, as merges of other clusters only average its distances to them.
+    uint32_t constexpr no_cluster = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> chain{};
+    uint32_t next_start = 0;
+    while (true)
+    {
+        if (chain.empty())
+        {
+            while (next_start < clusters.size() &&
+                   (clusters[next_start].points.empty() || clusters[next_start].finished))
+            {
+                ++next_start;
+            }
+            if (next_start == clusters.size())
+                break;
+            chain.push_back(next_start);
+        }
+
+        uint32_t const current = chain.back();
+        uint32_t const previous = chain.size() > 1 ? chain[chain.size() - 2] : no_cluster;
+        linkage_cluster & current_cluster = clusters[current];
+        // On ties the previous cluster of the chain stays the nearest neighbor, so that the chain terminates.
+        uint32_t nearest = no_cluster;
+        double nearest_distance = clustering_cutoff;
+        if (previous != no_cluster)
+        {
+            nearest = previous;
+            nearest_distance = average_distance(current, previous, current_cluster.neighbors.at(previous));
+        }
+        for (auto const & [neighbor, sum] : current_cluster.neighbors)
+        {
+            double const distance = average_distance(current, neighbor, sum);
+            if (distance < nearest_distance ||
+                (distance == nearest_distance && nearest != previous && neighbor < nearest))
+            {
+                nearest = neighbor;
+                nearest_distance = distance;
+            }
+        }
+
+        if (nearest == no_cluster)
+        {
+            // Finished clusters are never merged again, so they are removed from the neighbors of the others.
+            current_cluster.finished = true;
+            for (auto const & [neighbor, sum] : current_cluster.neighbors)
+                clusters[neighbor].neighbors.erase(current);
+            current_cluster.neighbors = {};
+            chain.pop_back();
+        }
+        else if (nearest == previous)
+        {
+            chain.pop_back();
+            chain.pop_back();
+            merges.push_back(linkage_merge{first_junction_of_point[current],
+                                           first_junction_of_point[previous],
+                                           nearest_distance});
+            merge_clusters(current, previous);
+        }
+        else
+        {
+            chain.push_back(nearest);
+        }
+    }
+
+    // Number the remaining clusters consecutively.
+    std::vector<int> point_labels(points.size());
+    int label = 0;
+    for (linkage_cluster const & cluster : clusters)
+    {
+        if (cluster.points.empty())
+            continue;
+        for (uint32_t const point : cluster.points)
+            point_labels[point] = label;
+        ++label;
+    }
+    for (size_t i = 0; i < num_objects; ++i)
+        labels[i] = point_labels[point_of_junction[i]];
+    return labels;
+}
@@ -1,10 +1,10 @@
 #include <seqan3/alphabet/cigar/cigar.hpp>
 #include <seqan3/alphabet/nucleotide/dna5.hpp>
-#include <seqan3/core/debug_stream.hpp>
 #include <seqan3/io/sequence_file/output.hpp>
 
-#include "structures/breakend.hpp"  // for class Breakend
-#include "structures/junction.hpp"  // for class Junction
+#include "structures/breakend.hpp"                      // for class Breakend
+#include "structures/junction.hpp"                      // for class Junction
+#include "variant_detection/thread_debug_stream.hpp"    // for thread_debug_stream
 
 using seqan3::operator""_cigar_operation;
 using seqan3::operator""_dna5;
@@ -20,6 +20,7 @@ void analyze_cigar(std::string const & read_name,
     // Step through CIGAR string and store current position in reference and read
     int32_t pos_ref = query_start_pos;
     int32_t pos_read = 0;
+    sequence_id_t const chromosome_id = intern_sequence_name(chromosome);
 
     for (seqan3::cigar & pair : cigar_string)
     {
@@ -37,11 +38,11 @@ void analyze_cigar(std::string const & read_name,
             {
                 // Insertions cause one junction from the insertion location to the next base
                 auto inserted_bases = query_sequence | seqan3::views::slice(pos_read, pos_read + length);
-                Junction new_junction{Breakend{chromosome, pos_ref - 1, strand::forward},
-                                      Breakend{chromosome, pos_ref, strand::forward},
+                Junction new_junction{Breakend{chromosome_id, pos_ref - 1, strand::forward},
+                                      Breakend{chromosome_id, pos_ref, strand::forward},
                                       inserted_bases,
                                       read_name};
-                seqan3::debug_stream << "INS: " << new_junction << "\n";
+                thread_debug_stream << "INS: " << new_junction << "\n";
                 junctions.push_back(std::move(new_junction));
             }
             pos_read += length;
@@ -51,11 +52,11 @@ void analyze_cigar(std::string const & read_name,
             if (length >= min_length)
             {
                 // Deletions cause one junction from its start to its end
-                Junction new_junction{Breakend{chromosome, pos_ref - 1, strand::forward},
-                                      Breakend{chromosome, pos_ref + length, strand::forward},
+                Junction new_junction{Breakend{chromosome_id, pos_ref - 1, strand::forward},
+                                      Breakend{chromosome_id, pos_ref + length, strand::forward},
                                       ""_dna5,
                                       read_name};
-                seqan3::debug_stream << "DEL: " << new_junction << "\n";
+                thread_debug_stream << "DEL: " << new_junction << "\n";
                 junctions.push_back(std::move(new_junction));
             }
             pos_ref += length;
@@ -66,7 +67,7 @@ void analyze_cigar(std::string const & read_name,
         }
         else // other possible cigar operations: H, N, P
         {
-            // seqan3::debug_stream << "Unhandled operation " << operation << std::endl;
+            // thread_debug_stream << "Unhandled operation " << operation << std::endl;
         }
 
     }
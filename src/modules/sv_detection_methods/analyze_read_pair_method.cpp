@@ -1,6 +1,6 @@
-#include <seqan3/core/debug_stream.hpp>
+#include "variant_detection/thread_debug_stream.hpp"  // for thread_debug_stream
 
 void analyze_read_pair()
 {
-    seqan3::debug_stream << "The read pair method is not yet implemented.\n";
+    thread_debug_stream << "The read pair method is not yet implemented.\n";
 }
@@ -1,6 +1,10 @@
 #include "modules/sv_detection_methods/analyze_sa_tag_method.hpp"
 
-#include <seqan3/core/debug_stream.hpp>
+#include <array>
+#include <cctype>                                       // for std::isspace and std::isdigit
+#include <charconv>                                     // for std::from_chars
+
+#include "variant_detection/thread_debug_stream.hpp"    // for thread_debug_stream
 
 using seqan3::operator""_dna5;
 
@@ -14,45 +18,130 @@ void split_string(std::string const & str, Container & cont, char const delim)
     }
 }
 
-void retrieve_aligned_segments(std::string const & sa_string, std::vector<AlignedSegment> & aligned_segments)
+template void split_string(std::string const & str, std::vector<std::string> & cont, char const delim);
+
+namespace
+{
+/* Calls `callback(token)` for each substring of `str` separated by `delim`. Like splitting with std::getline, an empty
+ * substring behind the last delimiter is dropped.
+ */
+template <typename callback_t>
+inline void for_each_token(std::string_view str, char const delim, callback_t && callback)
 {
-    std::vector<std::string> sa_tags{};
-    split_string(sa_string, sa_tags, ';');
-    for (std::string sa_tag : sa_tags)
+    while (!str.empty())
     {
-        std::vector<std::string> fields {};
-        split_string(sa_tag, fields, ',');
-        if (fields.size() == 6)
-        {
-            std::string ref_name = fields[0];
-            // Decrement by 1 because position in SA tag is stored as string and 1-based unlike other coordinates
-            int32_t pos = std::stoi(fields[1]) - 1;
-            strand orientation;
-            if (fields[2] == "+")
-            {
-                orientation = strand::forward;
-            }
-            else if (fields[2] == "-")
-            {
-                orientation = strand::reverse;
-            }
-            else
-            {
-                continue;
-            }
-            std::string cigar_field = fields[3];
-            std::vector<seqan3::cigar> cigar_vector = std::get<0>(seqan3::detail::parse_cigar(cigar_field));
-            int32_t mapq = std::stoi(fields[4]);
-            aligned_segments.push_back(AlignedSegment{orientation, ref_name, pos, mapq, cigar_vector});
-        }
-        else
-        {
-            seqan3::debug_stream << "Your SA tag has a wrong format (wrong amount of parameters): " << sa_tag << '\n';
-        }
+        size_t const end = str.find(delim);
+        callback(str.substr(0, end));
+        if (end == std::string_view::npos)
+            break;
+        str.remove_prefix(end + 1);
     }
 }
 
-void analyze_aligned_segments(std::vector<AlignedSegment> const & aligned_segments,
+/* Parses a decimal number like std::stoi: leading white space and a sign are allowed, characters behind the number
+ * are ignored. Returns false if there is no number or it does not fit into an int32_t.
+ */
+inline bool parse_number(std::string_view field, int32_t & value)
+{
+    while (!field.empty() && std::isspace(static_cast<unsigned char>(field.front())))
+        field.remove_prefix(1);
+    if (field.size() > 1 && field[0] == '+' && std::isdigit(static_cast<unsigned char>(field[1])))
+        field.remove_prefix(1);
+    return std::from_chars(field.data(), field.data() + field.size(), value).ec == std::errc{};
+}
+
+/* Parses a CIGAR string into `cigar`, reusing its memory. Returns false if an operation has no length, the string ends
+ * with a length or contains an unknown operation.
+ */
+inline bool parse_cigar_string(std::string_view field, std::vector<seqan3::cigar> & cigar)
+{
+    static constexpr std::string_view cigar_operations{"MIDNSHP=X"};
+    cigar.clear();
+    char const * current = field.data();
+    char const * const end = field.data() + field.size();
+    while (current != end)
+    {
+        uint32_t length{};
+        auto const [operation_ptr, error] = std::from_chars(current, end, length);
+        if (error != std::errc{} || operation_ptr == end ||
+            cigar_operations.find(*operation_ptr) == std::string_view::npos)
+            return false;
+        seqan3::cigar::operation operation{};
+        operation.assign_char(*operation_ptr);
+        cigar.push_back(seqan3::cigar{length, operation});
+        current = operation_ptr + 1;
+    }
+    return true;
+}
+} // namespace
+
+bool parse_aligned_segment(std::string_view const sa_entry, AlignedSegment & aligned_segment)
+{
+    std::array<std::string_view, 6> fields{};
+    size_t num_fields = 0;
+    for_each_token(sa_entry, ',', [&] (std::string_view const field)
+    {
+        if (num_fields < fields.size())
+            fields[num_fields] = field;
+        ++num_fields;
+    });
+    if (num_fields != fields.size())
+    {
+        thread_debug_stream << "Your SA tag has a wrong format (wrong amount of parameters): " << sa_entry << '\n';
+        return false;
+    }
+
+    strand orientation{};
+    if (fields[2] == "+")
+    {
+        orientation = strand::forward;
+    }
+    else if (fields[2] == "-")
+    {
+        orientation = strand::reverse;
+    }
+    else
+    {
+        return false;
+    }
+    // The CIGAR string is parsed into a buffer of this thread, whose memory is reused for all segments.
+    thread_local std::vector<seqan3::cigar> cigar{};
+    int32_t pos{};
+    int32_t mapq{};
+    if (!parse_number(fields[1], pos) ||
+        !parse_cigar_string(fields[3], cigar) ||
+        !parse_number(fields[4], mapq))
+    {
+        thread_debug_stream << "Your SA tag has a wrong format (invalid position, CIGAR string or mapping quality): "
+                            << sa_entry << '\n';
+        return false;
+    }
+    // Decrement by 1 because position in SA tag is 1-based unlike other coordinates
+    aligned_segment.assign(orientation, fields[0], pos - 1, mapq, cigar);
+    return true;
+}
+
+size_t parse_sa_tag(std::string_view const sa_string,
+                    std::vector<AlignedSegment> & aligned_segments,
+                    size_t const first)
+{
+    size_t next = first;
+    for_each_token(sa_string, ';', [&] (std::string_view const sa_entry)
+    {
+        if (next == aligned_segments.size())
+            aligned_segments.emplace_back();
+        if (parse_aligned_segment(sa_entry, aligned_segments[next]))
+            ++next;
+    });
+    return next;
+}
+
+void retrieve_aligned_segments(std::string_view const sa_string, std::vector<AlignedSegment> & aligned_segments)
+{
+    aligned_segments.resize(parse_sa_tag(sa_string, aligned_segments, aligned_segments.size()));
+}
+
+void analyze_aligned_segments(std::span<AlignedSegment const> const aligned_segments,
                               std::vector<Junction> & junctions,
                               seqan3::dna5_vector const & query_sequence,
                               std::string const & read_name,
@@ -61,20 +150,20 @@ void analyze_aligned_segments(std::vector<AlignedSegment> const & aligned_segmen
 {
     for (size_t i = 1; i < aligned_segments.size(); i++)
     {
-        AlignedSegment current = aligned_segments[i-1];
-        AlignedSegment next = aligned_segments[i];
+        AlignedSegment const & current = aligned_segments[i-1];
+        AlignedSegment const & next = aligned_segments[i];
         int32_t distance_on_read = next.get_query_start() - current.get_query_end();
         // Check that the overlap between two consecutive alignment segments
         // of the read is lower than the given threshold
         if (distance_on_read >= -max_overlap)
         {
             int32_t mate1_pos;
-            if (current.orientation == strand::forward)
+            if (current.get_orientation() == strand::forward)
                 mate1_pos = current.get_reference_end();
             else
                 mate1_pos = current.get_reference_start();
             int32_t mate2_pos;
-            if (next.orientation == strand::forward)
+            if (next.get_orientation() == strand::forward)
             {
                 // Correct position of mate 2 for overlapping alignment segments:
                 // Trim alignment of `next` segment at the start to remove overlap
@@ -97,16 +186,16 @@ void analyze_aligned_segments(std::vector<AlignedSegment> const & aligned_segmen
             // map to different reference sequences (e.g. translocation, interspersed duplication),
             // have a large distance on the reference (e.g. deletion, inversion, tandem duplication), or
             // have a large distance on the read (e.g. insertion)
-            if (current.ref_name != next.ref_name ||
+            if (current.get_ref_name() != next.get_ref_name() ||
                 std::abs(distance_on_ref) >= min_length ||
                 distance_on_read >= min_length)
             {
-                Breakend mate1{current.ref_name,
+                Breakend mate1{current.get_ref_name(),
                                mate1_pos,
-                               current.orientation};
-                Breakend mate2{next.ref_name,
+                               current.get_orientation()};
+                Breakend mate2{next.get_ref_name(),
                                mate2_pos,
-                               next.orientation};
+                               next.get_orientation()};
                 if (distance_on_read < 0)
                 {
                     // No inserted sequence between overlapping alignment segments
@@ -117,7 +206,7 @@ void analyze_aligned_segments(std::vector<AlignedSegment> const & aligned_segmen
                     auto inserted_bases = query_sequence | seqan3::views::slice(current.get_query_end(), next.get_query_start());
                     junctions.emplace_back(mate1, mate2, inserted_bases, read_name);
                 }
-                seqan3::debug_stream << "BND: " << junctions.back() << "\n";
+                thread_debug_stream << "BND: " << junctions.back() << "\n";
             }
         }
     }
@@ -134,13 +223,19 @@ void analyze_sa_tag(std::string const & query_name,
                     cmd_arguments const & args,
                     std::vector<Junction> & junctions)
 {
-
-    std::vector<AlignedSegment> aligned_segments{};
-    strand strand = (hasFlagReverseComplement(flag) ? strand::reverse : strand::forward);
-    aligned_segments.push_back(AlignedSegment{strand, ref_name, pos, mapq, cigar});
-    retrieve_aligned_segments(sa_tag, aligned_segments);
-    std::sort(aligned_segments.begin(), aligned_segments.end());
-    analyze_aligned_segments(aligned_segments,
+    // The segments are parsed into a buffer of this thread, whose memory is reused for all reads.
+    thread_local std::vector<AlignedSegment> aligned_segments{};
+    if (aligned_segments.empty())
+        aligned_segments.emplace_back();
+    AlignedSegment & primary_segment = aligned_segments[0];
+    primary_segment.assign(hasFlagReverseComplement(flag) ? strand::reverse : strand::forward,
+                           ref_name,
+                           pos,
+                           mapq,
+                           cigar);
+    size_t const num_segments = parse_sa_tag(sa_tag, aligned_segments, 1);
+    std::sort(aligned_segments.begin(), aligned_segments.begin() + num_segments);
+    analyze_aligned_segments(std::span<AlignedSegment const>{aligned_segments.data(), num_segments},
                              junctions,
                              seq,
                              query_name,
@@ -1,133 +1,80 @@
 #include "structures/aligned_segment.hpp"
 
+#include <array>
+
 #include <seqan3/alphabet/cigar/cigar.hpp>
 
-int32_t AlignedSegment::get_reference_start() const
+namespace
 {
-    return pos;
-}
+// Effect of a CIGAR operation on the coordinates of an aligned segment.
+struct cigar_operation_properties
+{
+    bool consumes_reference{false};     // M, D, N, X, =
+    bool consumes_query{false};         // M, S, I, X, =
+    bool soft_clip{false};              // S
+    bool aligned_query{false};          // M, I, X, =: ends the soft clip at the start of the alignment
+};
 
-int32_t AlignedSegment::get_reference_end() const
+// Properties of the CIGAR operations indexed by their rank.
+constexpr auto cigar_operation_table = [] ()
 {
-    int32_t current_pos = pos;
-    for (auto [element_length, element_operation] : cig)
+    std::array<cigar_operation_properties, seqan3::alphabet_size<seqan3::cigar::operation>> table{};
+    for (size_t rank = 0; rank < table.size(); ++rank)
     {
-        switch(element_operation.to_char())
+        seqan3::cigar::operation operation{};
+        operation.assign_rank(rank);
+        switch (operation.to_char())
         {
-            case 'M':
-            case 'D':
-            case 'N':
-            case 'X':
-            case '=':
-                current_pos += element_length;
+            case 'M': case 'X': case '=':
+                table[rank] = {true, true, false, true};
                 break;
             case 'I':
+                table[rank] = {false, true, false, true};
+                break;
             case 'S':
-            case 'H':
-            case 'P': // do nothing
+                table[rank] = {false, true, true, false};
                 break;
-            default:
-                std::cerr << "The default case was accidentally triggered by the following element, which is no part of"
-                             " a CIGAR string: "
-                          << element_operation.to_char() << '\n';
+            case 'D': case 'N':
+                table[rank] = {true, false, false, false};
+                break;
+            default: // H, P: do nothing
                 break;
         }
     }
-    // Decrement by 1 to jump back to the last aligned base
-    return current_pos - 1;
-}
-
-int32_t AlignedSegment::get_left_soft_clip() const
-{
-    int32_t left_soft_clip = 0;
-    for (auto [element_length, element_operation] : cig)
-    {
-        if(element_operation.to_char() == 'S')
-        {
-            left_soft_clip += element_length;
-        }
-        else if(element_operation.to_char() == 'M' ||
-                element_operation.to_char() == '=' ||
-                element_operation.to_char() == 'X' ||
-                element_operation.to_char() == 'I')
-        {
-            break;
-        }
-    }
-    return left_soft_clip;
-}
+    return table;
+}();
+} // namespace
 
-int32_t AlignedSegment::get_right_soft_clip() const
+void AlignedSegment::update_coordinates()
 {
-    int32_t right_soft_clip = 0;
-    for (auto [element_length, element_operation] : std::views::reverse(cig))
+    int32_t reference_length = 0;
+    bool aligned_query_seen = false;
+    left_soft_clip = 0;
+    right_soft_clip = 0;
+    query_length = 0;
+    for (seqan3::cigar const & element : cig)
     {
-        if(element_operation.to_char() == 'S')
+        using seqan3::get;
+        int32_t const length = get<0>(element);
+        cigar_operation_properties const & properties = cigar_operation_table[seqan3::to_rank(get<1>(element))];
+        if (properties.consumes_reference)
+            reference_length += length;
+        if (properties.consumes_query)
+            query_length += length;
+        if (properties.aligned_query)
         {
-            right_soft_clip += element_length;
+            aligned_query_seen = true;
+            right_soft_clip = 0;    // only soft clips behind the last aligned base belong to the right soft clip
         }
-        else if(element_operation.to_char() == 'M' ||
-                element_operation.to_char() == '=' ||
-                element_operation.to_char() == 'X' ||
-                element_operation.to_char() == 'I')
+        else if (properties.soft_clip)
         {
-            break;
+            if (!aligned_query_seen)
+                left_soft_clip += length;
+            right_soft_clip += length;
         }
     }
-    return right_soft_clip;
-}
-
-int32_t AlignedSegment::get_query_start() const
-{
-    if (orientation == strand::forward)
-    {
-        return get_left_soft_clip();
-    }
-    else
-    {
-        return get_right_soft_clip();
-    }
-}
-
-int32_t AlignedSegment::get_query_length() const
-{
-    int32_t current_length = 0;
-    for (auto [element_length, element_operation] : cig)
-    {
-        switch(element_operation.to_char())
-        {
-            case 'M':
-            case 'S':
-            case 'I':
-            case 'X':
-            case '=':
-                current_length += element_length;
-                break;
-            case 'D':
-            case 'N':
-            case 'H':
-            case 'P': // do nothing
-                break;
-            default:
-                std::cerr << "The default case was accidentally triggered by the following element, which is no part of"
-                             " a CIGAR string: "
-                          << element_operation.to_char() << '\n';
-                break;
-        }
-    }
-    return current_length;
-}
-
-int32_t AlignedSegment::get_query_end() const
-{
-    if (orientation == strand::forward)
-    {
-        return get_query_length() - get_right_soft_clip();
-    }
-    else
-    {
-        return get_query_length() - get_left_soft_clip();
-    }
+    // Decrement by 1 to jump back to the last aligned base
+    reference_end = pos + reference_length - 1;
 }
 
 bool operator<(AlignedSegment const & lhs, AlignedSegment const & rhs)
@@ -136,14 +83,14 @@ bool operator<(AlignedSegment const & lhs, AlignedSegment const & rhs)
             ? lhs.get_query_start() < rhs.get_query_start()
             : lhs.get_query_end() != rhs.get_query_end()
                 ? lhs.get_query_end() < rhs.get_query_end()
-                : lhs.mapq < rhs.mapq;
+                : lhs.get_mapq() < rhs.get_mapq();
 }
 
 bool operator==(AlignedSegment const & lhs, AlignedSegment const & rhs)
 {
-    return lhs.orientation == rhs.orientation &&
-           lhs.ref_name == rhs.ref_name &&
-           lhs.pos == rhs.pos &&
-           lhs.mapq == rhs.mapq &&
-           lhs.cig == rhs.cig;
+    return lhs.get_orientation() == rhs.get_orientation() &&
+           lhs.get_ref_name() == rhs.get_ref_name() &&
+           lhs.get_reference_start() == rhs.get_reference_start() &&
+           lhs.get_mapq() == rhs.get_mapq() &&
+           lhs.get_cigar() == rhs.get_cigar();
 }
@@ -5,18 +5,20 @@
 /*! \brief Compares two breakends.
  *
  * Breakends are compared in the following order:
- * 1. by the chromosome name
+ * 1. by the chromosome name (using the rank of the name in the sequence dictionary)
  * 2. by the orientation
  * 3. by their position
  */
 bool operator<(Breakend const & lhs, Breakend const & rhs)
 {
-    return std::tie(lhs.seq_name, lhs.orientation, lhs.position) < std::tie(rhs.seq_name, rhs.orientation, rhs.position);
+    if (lhs.seq_id != rhs.seq_id)
+        return sequence_rank(lhs.seq_id) < sequence_rank(rhs.seq_id);
+    return std::tie(lhs.orientation, lhs.position) < std::tie(rhs.orientation, rhs.position);
 }
 
 bool operator==(Breakend const & lhs, Breakend const & rhs)
 {
-    return (lhs.seq_name == rhs.seq_name) &&
+    return (lhs.seq_id == rhs.seq_id) &&
            (lhs.position == rhs.position) &&
            (lhs.orientation == rhs.orientation);
 }
@@ -1,88 +1,57 @@
 #include "structures/cluster.hpp"
 
+#include <algorithm>    // for std::is_sorted, std::min, std::max
 #include <cmath>        // for std::round
 #include <stdexcept>    // for std::runtime_error
 
-size_t Cluster::get_cluster_size() const
+Cluster::Cluster(std::vector<Junction> the_members) : members{std::move(the_members)}
 {
-    return members.size();
+    for (size_t i = 0; i < members.size(); ++i)
+        add_to_summary(members[i], i + 1);
 }
 
-Breakend Cluster::get_average_mate1() const
+void Cluster::add_member(Junction const & junction)
 {
-    std::string seq_name{};
-    uint64_t sum_positions = 0;
-    strand orientation{};
-    // Iterate through members of the cluster
-    for (uint32_t i = 0; i < members.size(); ++i)
-    {
-        Breakend mate1 = members[i].get_mate1();
-        if (i == 0)
-        {
-            seq_name = mate1.seq_name;
-            orientation = mate1.orientation;
-        }
-        else
-        {
-            // Make sure that all members of the cluster have matching sequence names and orientations
-            if (mate1.seq_name != seq_name ||
-                mate1.orientation != orientation)
-            {
-                throw std::runtime_error("Junctions with incompatible breakends were clustered together (different seq_name or orientation).");
-            }
-        }
-        // Add up breakend positions aross all members
-        sum_positions += mate1.position;
-    }
-    int32_t average_position = std::round(static_cast<double>(sum_positions) / members.size());
-    Breakend average_breakend{seq_name, average_position, orientation};
-    return average_breakend;
+    add_to_summary(junction, members.size() + 1);
+    members.push_back(junction);
 }
 
-Breakend Cluster::get_average_mate2() const
+void Cluster::add_to_summary(Junction const & junction, size_t const num_members)
 {
-    std::string seq_name{};
-    uint64_t sum_positions = 0;
-    strand orientation{};
-    // Iterate through members of the cluster
-    for (uint32_t i = 0; i < members.size(); ++i)
+    Breakend const & mate1 = junction.get_mate1();
+    Breakend const & mate2 = junction.get_mate2();
+    int32_t const inserted_size = junction.inserted_size();
+    if (num_members == 1)
     {
-        Breakend mate2 = members[i].get_mate2();
-        if (i == 0)
-        {
-            seq_name = mate2.seq_name;
-            orientation = mate2.orientation;
-        }
-        else
-        {
-            // Make sure that all members of the cluster have matching sequence types, names and orientations
-            if (mate2.seq_name != seq_name ||
-                mate2.orientation != orientation)
-            {
-                throw std::runtime_error("Junctions with incompatible breakends were clustered together (different seq_name or orientation).");
-            }
-        }
-        // Add up breakend positions aross all members
-        sum_positions += mate2.position;
+        average_mate1 = mate1;
+        average_mate2 = mate2;
+        min_inserted_size = inserted_size;
+        max_inserted_size = inserted_size;
     }
-    int32_t average_position = std::round(static_cast<double>(sum_positions) / members.size());
-    Breakend average_breakend{seq_name, average_position, orientation};
-    return average_breakend;
-}
-
-int32_t Cluster::get_average_inserted_sequence_size() const
-{
-    uint64_t sum_sizes = 0;
-    // Iterate through members of the cluster
-    for (size_t i = 0; i < members.size(); ++i)
+    // Make sure that all members of the cluster have matching sequence names and orientations
+    else if (mate1.seq_id != average_mate1.seq_id ||
+             mate1.orientation != average_mate1.orientation ||
+             mate2.seq_id != average_mate2.seq_id ||
+             mate2.orientation != average_mate2.orientation)
+    {
+        throw std::runtime_error("Junctions with incompatible breakends were clustered together (different seq_name or orientation).");
+    }
+    else
     {
-        sum_sizes += members[i].get_inserted_sequence().size();
+        min_inserted_size = std::min(min_inserted_size, inserted_size);
+        max_inserted_size = std::max(max_inserted_size, inserted_size);
     }
-    int32_t average_size = std::round(static_cast<double>(sum_sizes) / members.size());
-    return average_size;
+
+    // Add up breakend positions and inserted sequence sizes across all members
+    sum_mate1_positions += mate1.position;
+    sum_mate2_positions += mate2.position;
+    sum_inserted_sizes += inserted_size;
+    average_mate1.position = std::round(static_cast<double>(sum_mate1_positions) / num_members);
+    average_mate2.position = std::round(static_cast<double>(sum_mate2_positions) / num_members);
+    average_inserted_size = std::round(static_cast<double>(sum_inserted_sizes) / num_members);
 }
 
-std::vector<Junction> Cluster::get_members() const
+std::vector<Junction> const & Cluster::get_members() const
 {
     return members;
 }
@@ -98,9 +67,19 @@ bool operator<(Cluster const & lhs, Cluster const & rhs)
 
 bool operator==(Cluster const & lhs, Cluster const & rhs)
 {
-    std::vector<Junction> lhs_members = lhs.get_members();
-    std::sort(lhs_members.begin(), lhs_members.end());
-    std::vector<Junction> rhs_members = rhs.get_members();
-    std::sort(rhs_members.begin(), rhs_members.end());
-    return (lhs_members == rhs_members);
+    std::vector<Junction> const & lhs_members = lhs.get_members();
+    std::vector<Junction> const & rhs_members = rhs.get_members();
+    if (lhs_members.size() != rhs_members.size())
+        return false;
+    // The members of clusters built by the clustering methods are sorted already, only unsorted members are copied.
+    if (std::is_sorted(lhs_members.begin(), lhs_members.end()) &&
+        std::is_sorted(rhs_members.begin(), rhs_members.end()))
+    {
+        return lhs_members == rhs_members;
+    }
+    std::vector<Junction> lhs_sorted = lhs_members;
+    std::sort(lhs_sorted.begin(), lhs_sorted.end());
+    std::vector<Junction> rhs_sorted = rhs_members;
+    std::sort(rhs_sorted.begin(), rhs_sorted.end());
+    return (lhs_sorted == rhs_sorted);
 }
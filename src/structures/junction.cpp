@@ -1,40 +1,149 @@
 #include "structures/junction.hpp"
 
-Breakend Junction::get_mate1() const
+#include <algorithm>  // for std::min
+#include <cstring>    // for std::memcpy
+#include <stdexcept>  // for std::runtime_error
+#include <string>
+
+seqan3::dna5_vector Junction::get_inserted_sequence() const
 {
-    return mate1;
+    seqan3::dna5_vector sequence(inserted_length);
+    for (size_t i = 0; i < inserted_length; ++i)
+        sequence[i].assign_rank(inserted_base_rank(i));
+    return sequence;
 }
 
-Breakend Junction::get_mate2() const
+bool operator<(Junction const & lhs, Junction const & rhs)
 {
-    return mate2;
+    if (lhs.mate1 != rhs.mate1)
+        return lhs.mate1 < rhs.mate1;
+    if (lhs.mate2 != rhs.mate2)
+        return lhs.mate2 < rhs.mate2;
+    // Compare the inserted sequences lexicographically without unpacking them.
+    size_t const common_length = std::min(lhs.inserted_length, rhs.inserted_length);
+    for (size_t i = 0; i < common_length; ++i)
+    {
+        uint8_t const lhs_rank = lhs.inserted_base_rank(i);
+        uint8_t const rhs_rank = rhs.inserted_base_rank(i);
+        if (lhs_rank != rhs_rank)
+            return lhs_rank < rhs_rank;
+    }
+    return lhs.inserted_length < rhs.inserted_length;
 }
 
-seqan3::dna5_vector Junction::get_inserted_sequence() const
+bool operator==(Junction const & lhs, Junction const & rhs)
 {
-    return inserted_sequence;
+    if (lhs.mate1 != rhs.mate1 || lhs.mate2 != rhs.mate2 || lhs.inserted_length != rhs.inserted_length)
+        return false;
+    for (size_t i = 0; i < lhs.inserted_length; ++i)
+    {
+        if (lhs.inserted_base_rank(i) != rhs.inserted_base_rank(i))
+            return false;
+    }
+    return true;
 }
 
-std::string Junction::get_read_name() const
+bool operator!=(Junction const & lhs, Junction const & rhs)
 {
-    return read_name;
+    return !(lhs == rhs);
 }
 
-bool operator<(Junction const & lhs, Junction const & rhs)
+namespace
 {
-    return lhs.get_mate1() != rhs.get_mate1()
-           ? lhs.get_mate1() < rhs.get_mate1()
-           : lhs.get_mate2() != rhs.get_mate2()
-             ? lhs.get_mate2() < rhs.get_mate2()
-             : lhs.get_inserted_sequence() < rhs.get_inserted_sequence();
+// Size of the fixed part of a junction written by write_junction().
+constexpr size_t binary_breakend_size = sizeof(sequence_id_t) + sizeof(int32_t) + sizeof(strand);
+constexpr size_t binary_junction_size = 2 * binary_breakend_size + 2 * sizeof(uint32_t);
+
+char * write_binary_breakend(char * out, Breakend const & breakend)
+{
+    std::memcpy(out, &breakend.seq_id, sizeof(sequence_id_t));
+    std::memcpy(out + sizeof(sequence_id_t), &breakend.position, sizeof(int32_t));
+    std::memcpy(out + sizeof(sequence_id_t) + sizeof(int32_t), &breakend.orientation, sizeof(strand));
+    return out + binary_breakend_size;
 }
 
-bool operator==(Junction const & lhs, Junction const & rhs)
+char const * read_binary_breakend(char const * in, Breakend & breakend)
 {
-    return (lhs.get_mate1() == rhs.get_mate1()) && (lhs.get_mate2() == rhs.get_mate2()) && (lhs.get_inserted_sequence() == rhs.get_inserted_sequence());
+    std::memcpy(&breakend.seq_id, in, sizeof(sequence_id_t));
+    std::memcpy(&breakend.position, in + sizeof(sequence_id_t), sizeof(int32_t));
+    std::memcpy(&breakend.orientation, in + sizeof(sequence_id_t) + sizeof(int32_t), sizeof(strand));
+    return in + binary_breakend_size;
 }
+} // namespace
 
-bool operator!=(Junction const & lhs, Junction const & rhs)
+void write_junction(std::ostream & stream, Junction const & junction)
 {
-    return !(lhs == rhs);
+    char buffer[binary_junction_size];
+    char * out = write_binary_breakend(buffer, junction.mate1);
+    out = write_binary_breakend(out, junction.mate2);
+    std::memcpy(out, &junction.inserted_length, sizeof(uint32_t));
+    std::memcpy(out + sizeof(uint32_t), &junction.read_name_length, sizeof(uint32_t));
+    stream.write(buffer, binary_junction_size);
+    if (junction.inserted_length > 0)
+        stream.write(arena_data(junction.inserted_bases), (junction.inserted_length + 1) / 2);
+    stream.write(junction.get_read_name().data(), junction.read_name_length);
+}
+
+bool read_junction(std::istream & stream, Junction & junction)
+{
+    char buffer[binary_junction_size];
+    stream.read(buffer, binary_junction_size);
+    if (stream.gcount() == 0)
+        return false;
+    if (static_cast<size_t>(stream.gcount()) != binary_junction_size)
+        throw std::runtime_error{"A binary junction is truncated."};
+
+    char const * in = read_binary_breakend(buffer, junction.mate1);
+    in = read_binary_breakend(in, junction.mate2);
+    std::memcpy(&junction.inserted_length, in, sizeof(uint32_t));
+    std::memcpy(&junction.read_name_length, in + sizeof(uint32_t), sizeof(uint32_t));
+
+    if (junction.inserted_length > 0)
+    {
+        size_t const packed_length = (junction.inserted_length + 1) / 2;
+        stream.read(arena_allocate(packed_length, junction.inserted_bases), packed_length);
+    }
+    // Consecutive junctions of a read share the stored read name.
+    thread_local std::string read_name{};
+    read_name.resize(junction.read_name_length);
+    stream.read(read_name.data(), junction.read_name_length);
+    if (!stream)
+        throw std::runtime_error{"A binary junction is truncated."};
+    junction.read_name = arena_store_read_name(read_name);
+    return true;
+}
+
+void compact_junction_arena(std::span<std::span<Junction> const> const junction_groups)
+{
+    // The bytes are copied out of the arena first, as the junctions may refer to any chunk.
+    std::string bytes{};
+    for (std::span<Junction> const junctions : junction_groups)
+    {
+        for (Junction const & junction : junctions)
+        {
+            bytes += junction.packed_inserted_sequence();
+            bytes += junction.get_read_name();
+        }
+    }
+    arena_clear();
+
+    size_t offset = 0;
+    for (std::span<Junction> const junctions : junction_groups)
+    {
+        for (Junction & junction : junctions)
+        {
+            size_t const packed_size = (junction.inserted_length + 1) / 2;
+            if (packed_size > 0)
+            {
+                char * data = arena_allocate(packed_size, junction.inserted_bases);
+                std::memcpy(data, bytes.data() + offset, packed_size);
+            }
+            offset += packed_size;
+            // Consecutive junctions of a read share their read name again.
+            if (junction.read_name_length > 0)
+                junction.read_name = arena_store_read_name(std::string_view{bytes}.substr(offset,
+                                                                                          junction.read_name_length));
+            offset += junction.read_name_length;
+        }
+    }
 }
@@ -0,0 +1,146 @@
+#include "structures/junction_arena.hpp"
+
+#include <algorithm>    // for std::min, std::max
+#include <atomic>
+#include <cstring>      // for std::memcpy
+#include <memory>       // for std::unique_ptr
+#include <stdexcept>    // for std::runtime_error
+
+namespace
+{
+// Size of a regular chunk, longer byte sequences get a chunk of their own.
+constexpr size_t chunk_size = 1 << 20;
+// Maximal number of chunks, i.e. at least 64 GiB of inserted sequences and read names.
+constexpr size_t max_chunks = 1 << 16;
+
+/* The chunk directory has a fixed size, so that readers can access it without locking while other threads add
+ * chunks. The chunks are only freed by arena_clear().
+ */
+struct chunk_directory
+{
+    std::unique_ptr<std::atomic<char *>[]> chunks{new std::atomic<char *>[max_chunks]{}};
+    // Chunks of external memory are not freed.
+    std::unique_ptr<std::atomic<bool>[]> external{new std::atomic<bool>[max_chunks]{}};
+    std::atomic<uint32_t> num_chunks{0};
+    std::atomic<size_t> allocated_bytes{0};
+    // Incremented by arena_clear(), so that the threads do not continue their freed chunks.
+    std::atomic<uint32_t> generation{0};
+
+    // Adds a new chunk of at least `size` bytes and returns its index.
+    uint32_t add_chunk(size_t const size, char * & data)
+    {
+        uint32_t const index = num_chunks.fetch_add(1, std::memory_order_relaxed);
+        if (index >= max_chunks)
+            throw std::runtime_error{"The junction arena is full."};
+        data = new char[size];
+        chunks[index].store(data, std::memory_order_release);
+        allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        return index;
+    }
+
+    // Adds `count` consecutive chunks of external memory and returns the index of the first one.
+    uint32_t add_external_chunks(char const * data, size_t const count)
+    {
+        uint32_t const first = num_chunks.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > max_chunks)
+            throw std::runtime_error{"The junction arena is full."};
+        for (size_t i = 0; i < count; ++i)
+        {
+            external[first + i].store(true, std::memory_order_relaxed);
+            chunks[first + i].store(const_cast<char *>(data) + i * external_chunk_size, std::memory_order_release);
+        }
+        return first;
+    }
+
+    // Frees all chunks.
+    void clear()
+    {
+        for (uint32_t index = 0; index < std::min<uint32_t>(num_chunks, max_chunks); ++index)
+        {
+            char * const data = chunks[index].exchange(nullptr);
+            if (!external[index].exchange(false))
+                delete[] data;
+        }
+        num_chunks = 0;
+        allocated_bytes = 0;
+        ++generation;
+    }
+};
+
+chunk_directory & directory()
+{
+    static chunk_directory instance{};
+    return instance;
+}
+
+// The chunk currently filled by a thread.
+struct thread_chunk
+{
+    uint32_t generation{};
+    uint32_t index{};
+    char * data{nullptr};
+    size_t used{0};
+    size_t capacity{0};
+};
+} // namespace
+
+char * arena_allocate(size_t const size, arena_reference & reference)
+{
+    thread_local thread_chunk current{};
+    if (size > chunk_size / 2)
+    {
+        // Large sequences get their own chunk, so that the chunk of the thread is not wasted.
+        char * data{};
+        reference = arena_reference{directory().add_chunk(size, data), 0};
+        return data;
+    }
+    uint32_t const generation = directory().generation.load(std::memory_order_relaxed);
+    if (current.data == nullptr || current.generation != generation || current.used + size > current.capacity)
+    {
+        current.generation = generation;
+        current.index = directory().add_chunk(chunk_size, current.data);
+        current.used = 0;
+        current.capacity = chunk_size;
+    }
+    reference = arena_reference{current.index, static_cast<uint32_t>(current.used)};
+    char * data = current.data + current.used;
+    current.used += size;
+    return data;
+}
+
+char const * arena_data(arena_reference const reference)
+{
+    return directory().chunks[reference.chunk].load(std::memory_order_acquire) + reference.offset;
+}
+
+arena_reference arena_store_read_name(std::string_view const read_name)
+{
+    thread_local arena_reference last_reference{};
+    thread_local std::string_view last_name{};
+    thread_local uint32_t last_generation{};
+    uint32_t const generation = directory().generation.load(std::memory_order_relaxed);
+    if (last_name.data() == nullptr || last_generation != generation || last_name != read_name)
+    {
+        last_generation = generation;
+        char * data = arena_allocate(read_name.size(), last_reference);
+        std::memcpy(data, read_name.data(), read_name.size());
+        last_name = std::string_view{data, read_name.size()};
+    }
+    return last_reference;
+}
+
+uint32_t arena_add_external(char const * data, size_t const size)
+{
+    return directory().add_external_chunks(data, std::max<size_t>((size + external_chunk_size - 1) / external_chunk_size,
+                                                                  1));
+}
+
+size_t arena_allocated_bytes()
+{
+    return directory().allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void arena_clear()
+{
+    directory().clear();
+}
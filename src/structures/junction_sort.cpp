@@ -0,0 +1,170 @@
+#include "structures/junction_sort.hpp"
+
+#include <algorithm>    // for std::sort, std::stable_sort, std::copy, std::min
+#include <array>
+#include <numeric>      // for std::iota
+#include <thread>
+#include <tuple>        // for std::tie, std::tuple_size_v
+#include <utility>      // for std::swap
+#include <vector>
+
+namespace
+{
+// Number of bases of the inserted sequence in the sort key, with three bits per base.
+constexpr size_t key_bases = 21;
+// Inputs smaller than this are sorted by comparison, the radix sort needs several passes over the whole input.
+constexpr size_t min_radix_size = 4096;
+// Each thread of the radix sort gets at least this many keys.
+constexpr size_t min_keys_per_thread = 1 << 16;
+
+struct sort_entry
+{
+    // Most significant word first: the first mate, the second mate and the first bases of the inserted sequence.
+    std::array<uint64_t, 3> key;
+    size_t index;
+};
+
+bool operator<(sort_entry const & lhs, sort_entry const & rhs)
+{
+    return std::tie(lhs.key, lhs.index) < std::tie(rhs.key, rhs.index);
+}
+
+// Runs `work(t)` for t in [0, num_threads) in parallel.
+template <typename work_t>
+void run_in_parallel(size_t const num_threads, work_t && work)
+{
+    std::vector<std::thread> workers{};
+    for (size_t t = 1; t < num_threads; ++t)
+        workers.emplace_back(work, t);
+    work(0);
+    for (std::thread & worker : workers)
+        worker.join();
+}
+
+// Stable LSD radix sort of the entries by one word of their keys, one byte per pass.
+void radix_sort_word(std::span<sort_entry> const entries,
+                     std::span<sort_entry> const buffer,
+                     size_t const w,
+                     size_t const threads)
+{
+    size_t const n = entries.size();
+    size_t const num_threads = std::max<size_t>(std::min(threads, n / min_keys_per_thread), 1);
+    auto chunk_begin = [&] (size_t const t) { return n * t / num_threads; };
+
+    // Bytes which are equal in all keys do not change the order.
+    uint64_t varying_bits{0};
+    for (sort_entry const & entry : entries)
+        varying_bits |= entry.key[w] ^ entries[0].key[w];
+
+    std::span<sort_entry> source = entries;
+    std::span<sort_entry> target = buffer;
+    std::vector<std::array<size_t, 256>> counts(num_threads);
+    for (size_t shift = 0; shift < 64; shift += 8)
+    {
+        if (((varying_bits >> shift) & 0xFF) == 0)
+            continue;
+
+        run_in_parallel(num_threads, [&] (size_t const t)
+        {
+            counts[t].fill(0);
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i)
+                ++counts[t][(source[i].key[w] >> shift) & 0xFF];
+        });
+        // The entries of a digit are placed in the order of the threads, which keeps the sort stable.
+        size_t offset = 0;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+            for (size_t t = 0; t < num_threads; ++t)
+            {
+                size_t const count = counts[t][digit];
+                counts[t][digit] = offset;
+                offset += count;
+            }
+        }
+        run_in_parallel(num_threads, [&] (size_t const t)
+        {
+            for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); ++i)
+                target[counts[t][(source[i].key[w] >> shift) & 0xFF]++] = source[i];
+        });
+        std::swap(source, target);
+    }
+    if (source.data() != entries.data())
+        std::copy(source.begin(), source.end(), entries.begin());
+}
+
+// Sorts the entries, whose keys are equal in the words before `w`. Most junctions are told apart by their first mate,
+// so the radix sort runs on one word at a time and only the runs of equal words are sorted by the next ones.
+void sort_entries(std::span<sort_entry> const entries,
+                  std::span<sort_entry> const buffer,
+                  size_t const w,
+                  size_t const threads)
+{
+    if (entries.size() < min_radix_size)
+    {
+        std::sort(entries.begin(), entries.end());
+        return;
+    }
+
+    radix_sort_word(entries, buffer, w, threads);
+    // The entries with equal keys keep the order of their indices.
+    if (w + 1 == std::tuple_size_v<decltype(sort_entry::key)>)
+        return;
+    for (size_t begin = 0, end = 0; begin < entries.size(); begin = end)
+    {
+        end = begin + 1;
+        while (end < entries.size() && entries[end].key[w] == entries[begin].key[w])
+            ++end;
+        if (end - begin > 1)
+            sort_entries(entries.subspan(begin, end - begin), buffer.subspan(begin, end - begin), w + 1, threads);
+    }
+}
+} // namespace
+
+void sort_junction_indices(std::span<Junction const> const junctions,
+                           std::span<size_t> const indices,
+                           size_t const threads)
+{
+    // The entries refer to the positions in `indices`, which break ties, so the order is stable.
+    std::vector<sort_entry> entries(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        Junction const & junction = junctions[indices[i]];
+        entries[i] = sort_entry{{breakend_sort_key(junction.get_mate1()),
+                                 breakend_sort_key(junction.get_mate2()),
+                                 junction.inserted_sequence_prefix(key_bases)},
+                                i};
+    }
+    std::vector<sort_entry> buffer(entries.size());
+    sort_entries(entries, buffer, 0, threads);
+
+    std::vector<size_t> const unsorted_indices(indices.begin(), indices.end());
+    for (size_t i = 0; i < entries.size(); ++i)
+        indices[i] = unsorted_indices[entries[i].index];
+
+    // Equal keys of junctions with more inserted bases than the key holds are sorted by the whole junctions.
+    for (size_t begin = 0, end = 0; begin < entries.size(); begin = end)
+    {
+        end = begin + 1;
+        while (end < entries.size() && entries[end].key == entries[begin].key)
+            ++end;
+        if (end - begin > 1 && (entries[begin].key[2] & 0x7) != 0)
+        {
+            std::stable_sort(indices.begin() + begin, indices.begin() + end, [&] (size_t const a, size_t const b)
+            {
+                return junctions[a] < junctions[b];
+            });
+        }
+    }
+}
+
+void sort_junctions(std::span<Junction> const junctions, size_t const threads)
+{
+    std::vector<size_t> order(junctions.size());
+    std::iota(order.begin(), order.end(), 0);
+    sort_junction_indices(junctions, order, threads);
+
+    std::vector<Junction> sorted(junctions.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        sorted[i] = std::move(junctions[order[i]]);
+    std::move(sorted.begin(), sorted.end(), junctions.begin());
+}
@@ -0,0 +1,303 @@
+#include "structures/junction_store.hpp"
+
+#include <array>
+#include <cstring>          // for std::memcpy
+#include <fstream>
+#include <stdexcept>        // for std::runtime_error
+#include <string_view>
+#include <unordered_map>
+
+#include <fcntl.h>          // for open
+#include <sys/mman.h>       // for mmap, munmap
+#include <sys/stat.h>       // for fstat
+#include <unistd.h>         // for close
+
+namespace
+{
+constexpr std::array<char, 8> store_magic{'i', 'G', 'V', 'j', 'u', 'n', 'c', '\0'};
+constexpr uint32_t store_version = 1;
+// Written in the native byte order, so that a store of another byte order is detected.
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+enum section : size_t
+{
+    contig_lengths_section,         // int32_t per contig, -1 for contigs without \@SQ line
+    contig_name_offsets_section,    // uint64_t per contig and the end of the last name, into contig_names
+    contig_names_section,           // the names of the contigs
+    mate1_contigs_section,          // uint32_t per junction, index of the contig of the first mate
+    mate1_positions_section,        // int32_t per junction
+    mate2_contigs_section,          // uint32_t per junction
+    mate2_positions_section,        // int32_t per junction
+    orientations_section,           // uint8_t per junction, bit 0 for the first mate and bit 1 for the second mate
+    inserted_lengths_section,       // uint32_t per junction, number of bases
+    inserted_offsets_section,       // uint64_t per junction, into inserted_bases
+    inserted_bases_section,         // packed inserted sequences, two bases per byte
+    read_name_lengths_section,      // uint32_t per junction
+    read_name_offsets_section,      // uint64_t per junction, into read_names
+    read_names_section,             // the read names, shared by consecutive junctions of a read
+    num_sections
+};
+
+struct store_header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_junctions;
+    uint64_t num_contigs;
+    // Begin of every section in the file and the end of the last section. Sections are aligned to 8 bytes.
+    std::array<uint64_t, num_sections + 1> section_offsets;
+};
+
+template <typename value_t>
+std::string_view as_bytes(std::vector<value_t> const & values)
+{
+    return std::string_view{reinterpret_cast<char const *>(values.data()), values.size() * sizeof(value_t)};
+}
+
+constexpr uint64_t align(uint64_t const offset)
+{
+    return (offset + 7) / 8 * 8;
+}
+} // namespace
+
+void write_junction_store(std::filesystem::path const & path,
+                          std::span<Junction const> const junctions,
+                          std::map<std::string, int32_t> const & references_lengths)
+{
+    // The contigs are the reference sequences and the sequences of the junctions without \@SQ line.
+    std::vector<int32_t> lengths{};
+    std::vector<uint64_t> name_offsets{0};
+    std::string names{};
+    std::unordered_map<sequence_id_t, uint32_t> contig_of_seq_id{};
+    auto add_contig = [&] (sequence_id_t const seq_id, int32_t const length)
+    {
+        auto const [it, inserted] = contig_of_seq_id.emplace(seq_id, lengths.size());
+        if (inserted)
+        {
+            lengths.push_back(length);
+            names += sequence_name(seq_id);
+            name_offsets.push_back(names.size());
+        }
+        return it->second;
+    };
+    for (auto const & [name, length] : references_lengths)
+        add_contig(intern_sequence_name(name), length);
+
+    size_t const n = junctions.size();
+    std::vector<uint32_t> mate1_contig_column(n), mate2_contig_column(n);
+    std::vector<int32_t> mate1_position_column(n), mate2_position_column(n);
+    std::vector<uint8_t> orientation_column(n);
+    std::vector<uint32_t> inserted_length_column(n), read_name_length_column(n);
+    std::vector<uint64_t> inserted_offset_column(n), read_name_offset_column(n);
+    std::string inserted_pool{};
+    std::string read_name_pool{};
+    for (size_t i = 0; i < n; ++i)
+    {
+        Junction const & junction = junctions[i];
+        mate1_contig_column[i] = add_contig(junction.get_mate1().seq_id, -1);
+        mate1_position_column[i] = junction.get_mate1().position;
+        mate2_contig_column[i] = add_contig(junction.get_mate2().seq_id, -1);
+        mate2_position_column[i] = junction.get_mate2().position;
+        orientation_column[i] = (junction.get_mate1().orientation == strand::reverse) |
+                                (junction.get_mate2().orientation == strand::reverse) << 1;
+
+        inserted_length_column[i] = junction.inserted_size();
+        inserted_offset_column[i] = inserted_pool.size();
+        inserted_pool += junction.packed_inserted_sequence();
+
+        std::string_view const read_name = junction.get_read_name();
+        read_name_length_column[i] = read_name.size();
+        if (i > 0 && read_name == junctions[i - 1].get_read_name())
+        {
+            read_name_offset_column[i] = read_name_offset_column[i - 1];
+        }
+        else
+        {
+            read_name_offset_column[i] = read_name_pool.size();
+            read_name_pool += read_name;
+        }
+    }
+
+    std::array<std::string_view, num_sections> sections{};
+    sections[contig_lengths_section] = as_bytes(lengths);
+    sections[contig_name_offsets_section] = as_bytes(name_offsets);
+    sections[contig_names_section] = names;
+    sections[mate1_contigs_section] = as_bytes(mate1_contig_column);
+    sections[mate1_positions_section] = as_bytes(mate1_position_column);
+    sections[mate2_contigs_section] = as_bytes(mate2_contig_column);
+    sections[mate2_positions_section] = as_bytes(mate2_position_column);
+    sections[orientations_section] = as_bytes(orientation_column);
+    sections[inserted_lengths_section] = as_bytes(inserted_length_column);
+    sections[inserted_offsets_section] = as_bytes(inserted_offset_column);
+    sections[inserted_bases_section] = inserted_pool;
+    sections[read_name_lengths_section] = as_bytes(read_name_length_column);
+    sections[read_name_offsets_section] = as_bytes(read_name_offset_column);
+    sections[read_names_section] = read_name_pool;
+
+    store_header header{store_magic, store_version, byte_order_mark, n, lengths.size(), {}};
+    uint64_t offset = align(sizeof(store_header));
+    for (size_t s = 0; s < num_sections; ++s)
+    {
+        header.section_offsets[s] = offset;
+        offset = align(offset + sections[s].size());
+    }
+    header.section_offsets[num_sections] = offset;
+
+    std::ofstream store_file{path, std::ios::binary};
+    if (!store_file.good() || !store_file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for writing."};
+    }
+    char const padding[8]{};
+    store_file.write(reinterpret_cast<char const *>(&header), sizeof(store_header));
+    store_file.write(padding, header.section_offsets[0] - sizeof(store_header));
+    for (size_t s = 0; s < num_sections; ++s)
+    {
+        store_file.write(sections[s].data(), sections[s].size());
+        store_file.write(padding, header.section_offsets[s + 1] - header.section_offsets[s] - sections[s].size());
+    }
+    if (!store_file)
+    {
+        throw std::runtime_error{"Could not write the junction store '" + path.string() + "'."};
+    }
+}
+
+junction_store::junction_store(std::filesystem::path const & path)
+{
+    int const file_descriptor = open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for reading."};
+    }
+    struct stat file_status{};
+    if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size >= static_cast<off_t>(sizeof(store_header)))
+    {
+        file_size = file_status.st_size;
+        void * const mapped = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (mapped != MAP_FAILED)
+            data = static_cast<char const *>(mapped);
+    }
+    close(file_descriptor);
+    if (data == nullptr)
+    {
+        throw std::runtime_error{"The file '" + path.string() + "' is not a junction store."};
+    }
+
+    store_header header{};
+    std::memcpy(&header, data, sizeof(store_header));
+    auto const invalid = [&] (std::string const & reason)
+    {
+        munmap(const_cast<char *>(data), file_size);
+        return std::runtime_error{"The file '" + path.string() + "' is not a valid junction store: " + reason + "."};
+    };
+    if (header.magic != store_magic)
+        throw invalid("unknown file format");
+    if (header.byte_order != byte_order_mark)
+        throw invalid("written with another byte order");
+    if (header.version != store_version)
+        throw invalid("version " + std::to_string(header.version) + " instead of " + std::to_string(store_version));
+    num_junctions = header.num_junctions;
+    size_t const num_contigs = header.num_contigs;
+
+    // Every section has to fit into the file and has to have the size of its column.
+    auto const section_size = [&] (section const s)
+    {
+        return header.section_offsets[s + 1] - header.section_offsets[s];
+    };
+    for (size_t s = 0; s < num_sections; ++s)
+    {
+        if (header.section_offsets[s] % 8 != 0 || header.section_offsets[s] > header.section_offsets[s + 1])
+            throw invalid("corrupted section offsets");
+    }
+    if (header.section_offsets[0] < sizeof(store_header) || header.section_offsets[num_sections] > file_size)
+        throw invalid("truncated file");
+    auto const column = [&] <typename value_t> (section const s, size_t const num_values, value_t const *& values)
+    {
+        if (section_size(s) < num_values * sizeof(value_t))
+            throw invalid("truncated column");
+        values = reinterpret_cast<value_t const *>(data + header.section_offsets[s]);
+    };
+
+    int32_t const * lengths{};
+    uint64_t const * name_offsets{};
+    column(contig_lengths_section, num_contigs, lengths);
+    column(contig_name_offsets_section, num_contigs + 1, name_offsets);
+    column(mate1_contigs_section, num_junctions, mate1_contigs);
+    column(mate1_positions_section, num_junctions, mate1_positions);
+    column(mate2_contigs_section, num_junctions, mate2_contigs);
+    column(mate2_positions_section, num_junctions, mate2_positions);
+    column(orientations_section, num_junctions, orientations);
+    column(inserted_lengths_section, num_junctions, inserted_lengths);
+    column(inserted_offsets_section, num_junctions, inserted_offsets);
+    column(read_name_lengths_section, num_junctions, read_name_lengths);
+    column(read_name_offsets_section, num_junctions, read_name_offsets);
+
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        if (mate1_contigs[i] >= num_contigs || mate2_contigs[i] >= num_contigs)
+            throw invalid("corrupted contigs of the junctions");
+        if (inserted_offsets[i] + (inserted_lengths[i] + 1) / 2 > section_size(inserted_bases_section) ||
+            read_name_offsets[i] + read_name_lengths[i] > section_size(read_names_section))
+            throw invalid("corrupted inserted sequences or read names");
+    }
+
+    // The contigs are added to the global sequence dictionary at once.
+    char const * const names = data + header.section_offsets[contig_names_section];
+    std::vector<std::string_view> contig_name_views{};
+    for (size_t contig = 0; contig < num_contigs; ++contig)
+    {
+        if (name_offsets[contig] > name_offsets[contig + 1] ||
+            name_offsets[contig + 1] > section_size(contig_names_section))
+            throw invalid("corrupted contig names");
+        contig_name_views.emplace_back(names + name_offsets[contig], name_offsets[contig + 1] - name_offsets[contig]);
+    }
+    intern_sequence_names(contig_name_views);
+    for (size_t contig = 0; contig < num_contigs; ++contig)
+    {
+        seq_ids.push_back(intern_sequence_name(contig_name_views[contig]));
+        if (lengths[contig] >= 0)
+            store_references_lengths.emplace(contig_name_views[contig], lengths[contig]);
+    }
+
+    // The junctions refer to the pools in place.
+    if (section_size(inserted_bases_section) > 0)
+        inserted_bases_chunk = arena_add_external(data + header.section_offsets[inserted_bases_section],
+                                                  section_size(inserted_bases_section));
+    if (section_size(read_names_section) > 0)
+        read_names_chunk = arena_add_external(data + header.section_offsets[read_names_section],
+                                              section_size(read_names_section));
+}
+
+junction_store::~junction_store()
+{
+    munmap(const_cast<char *>(data), file_size);
+}
+
+Junction junction_store::junction(size_t const i) const
+{
+    Junction junction{};
+    junction.mate1 = Breakend{seq_ids[mate1_contigs[i]],
+                              mate1_positions[i],
+                              (orientations[i] & 1) ? strand::reverse : strand::forward};
+    junction.mate2 = Breakend{seq_ids[mate2_contigs[i]],
+                              mate2_positions[i],
+                              (orientations[i] & 2) ? strand::reverse : strand::forward};
+    junction.inserted_length = inserted_lengths[i];
+    junction.inserted_bases = arena_reference{
+        static_cast<uint32_t>(inserted_bases_chunk + inserted_offsets[i] / external_chunk_size),
+        static_cast<uint32_t>(inserted_offsets[i] % external_chunk_size)};
+    junction.read_name_length = read_name_lengths[i];
+    junction.read_name = arena_reference{
+        static_cast<uint32_t>(read_names_chunk + read_name_offsets[i] / external_chunk_size),
+        static_cast<uint32_t>(read_name_offsets[i] % external_chunk_size)};
+    return junction;
+}
+
+std::vector<Junction> junction_store::junctions() const
+{
+    std::vector<Junction> all_junctions(num_junctions);
+    for (size_t i = 0; i < num_junctions; ++i)
+        all_junctions[i] = junction(i);
+    return all_junctions;
+}
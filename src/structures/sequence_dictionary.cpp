@@ -0,0 +1,112 @@
+#include "structures/sequence_dictionary.hpp"
+
+#include <algorithm>        // for std::sort
+#include <atomic>
+#include <deque>
+#include <memory>           // for std::unique_ptr
+#include <mutex>
+#include <numeric>          // for std::iota
+#include <stdexcept>        // for std::out_of_range
+#include <unordered_map>
+
+namespace
+{
+/* Immutable lookup tables of the dictionary. Adding names creates a new table, so that readers never observe a
+ * partially updated table and don't need to lock.
+ */
+struct dictionary_table
+{
+    std::vector<std::string const *> names{};                       // by id
+    std::vector<uint32_t> ranks{};                                  // by id
+    std::unordered_map<std::string_view, sequence_id_t> ids{};      // by name
+};
+
+class sequence_dictionary
+{
+private:
+    std::mutex mutex{};
+    std::deque<std::string> storage{};      // stable addresses of the names
+    // All published tables are kept alive, as readers may still use an older one.
+    std::vector<std::unique_ptr<dictionary_table const>> tables{};
+    std::atomic<dictionary_table const *> current{};
+
+public:
+    sequence_dictionary()
+    {
+        tables.push_back(std::make_unique<dictionary_table const>());
+        current.store(tables.back().get());
+    }
+
+    dictionary_table const & table() const
+    {
+        return *current.load(std::memory_order_acquire);
+    }
+
+    void add(std::vector<std::string_view> const & names)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto new_table = std::make_unique<dictionary_table>(table());
+        size_t const old_size = new_table->names.size();
+        for (std::string_view const name : names)
+        {
+            if (new_table->ids.contains(name))
+                continue;
+            std::string const & stored_name = storage.emplace_back(name);
+            new_table->ids.emplace(stored_name, new_table->names.size());
+            new_table->names.push_back(&stored_name);
+        }
+        if (new_table->names.size() == old_size)
+            return;
+
+        std::vector<sequence_id_t> sorted_ids(new_table->names.size());
+        std::iota(sorted_ids.begin(), sorted_ids.end(), 0);
+        std::sort(sorted_ids.begin(), sorted_ids.end(), [&] (sequence_id_t const a, sequence_id_t const b)
+        {
+            return *new_table->names[a] < *new_table->names[b];
+        });
+        new_table->ranks.resize(sorted_ids.size());
+        for (uint32_t rank = 0; rank < sorted_ids.size(); ++rank)
+            new_table->ranks[sorted_ids[rank]] = rank;
+
+        tables.push_back(std::move(new_table));
+        current.store(tables.back().get(), std::memory_order_release);
+    }
+};
+
+sequence_dictionary & global_dictionary()
+{
+    static sequence_dictionary dictionary{};
+    return dictionary;
+}
+} // namespace
+
+sequence_id_t intern_sequence_name(std::string_view const name)
+{
+    sequence_dictionary & dictionary = global_dictionary();
+    {
+        dictionary_table const & table = dictionary.table();
+        auto const it = table.ids.find(name);
+        if (it != table.ids.end())
+            return it->second;
+    }
+    dictionary.add({name});
+    return dictionary.table().ids.at(name);
+}
+
+void intern_sequence_names(std::vector<std::string_view> const & names)
+{
+    global_dictionary().add(names);
+}
+
+std::string const & sequence_name(sequence_id_t const id)
+{
+    dictionary_table const & table = global_dictionary().table();
+    if (id >= table.names.size())
+        throw std::out_of_range{"Unknown sequence id " + std::to_string(id) + "."};
+    return *table.names[id];
+}
+
+uint32_t sequence_rank(sequence_id_t const id)
+{
+    return global_dictionary().table().ranks[id];
+}
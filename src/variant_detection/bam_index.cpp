@@ -0,0 +1,190 @@
+#include "variant_detection/bam_index.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <seqan3/io/exception.hpp>          // for seqan3::format_error
+
+#include "variant_detection/bgzf_reader.hpp"    // for class bgzf_reader
+
+namespace
+{
+template <typename value_t>
+value_t read_value(std::istream & stream)
+{
+    value_t value{};
+    stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+    if (!stream.good())
+        throw seqan3::format_error{"ERROR: Unexpected end of BAM index file."};
+    return value;
+}
+
+inline void skip_bytes(std::istream & stream, size_t const count)
+{
+    stream.ignore(count);
+    if (!stream.good())
+        throw seqan3::format_error{"ERROR: Unexpected end of BAM index file."};
+}
+
+// Returns the smallest begin of the given chunks, or the previous value if it is smaller.
+inline std::optional<uint64_t> min_chunk_begin(std::istream & stream,
+                                               int32_t const n_chunk,
+                                               std::optional<uint64_t> offset)
+{
+    for (int32_t c = 0; c < n_chunk; ++c)
+    {
+        uint64_t const chunk_begin = read_value<uint64_t>(stream);
+        read_value<uint64_t>(stream); // chunk_end
+        if (!offset || chunk_begin < *offset)
+            offset = chunk_begin;
+    }
+    return offset;
+}
+} // namespace
+
+bam_index::bam_index(std::filesystem::path const & path)
+{
+    std::ifstream file{path, std::ios::binary};
+    if (!file.good() || !file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for reading."};
+    }
+
+    char magic[4]{};
+    file.read(magic, 4);
+    if (file.gcount() == 4 && std::string_view{magic, 4} == std::string_view{"BAI\1", 4})
+    {
+        read_bai(file);
+        return;
+    }
+    file.close();
+
+    // CSI files are BGZF compressed.
+    bgzf_reader reader{path};
+    std::string content{};
+    std::vector<char> buffer(65536);
+    for (size_t bytes_read = 0; (bytes_read = reader.read(buffer.data(), buffer.size())) > 0; )
+        content.append(buffer.data(), bytes_read);
+    std::istringstream stream{content};
+    stream.read(magic, 4);
+    if (stream.gcount() != 4 || std::string_view{magic, 4} != std::string_view{"CSI\1", 4})
+        throw seqan3::format_error{"ERROR: The file '" + path.string() + "' is not a BAI or CSI index."};
+    read_csi(stream);
+}
+
+void bam_index::read_bai(std::istream & stream)
+{
+    // Pseudo bin holding meta data instead of alignment chunks.
+    constexpr uint32_t pseudo_bin = 37450;
+
+    int32_t const n_ref = read_value<int32_t>(stream);
+    reference_offsets.resize(n_ref);
+    linear_indices.resize(n_ref);
+    for (int32_t r = 0; r < n_ref; ++r)
+    {
+        int32_t const n_bin = read_value<int32_t>(stream);
+        for (int32_t b = 0; b < n_bin; ++b)
+        {
+            uint32_t const bin = read_value<uint32_t>(stream);
+            int32_t const n_chunk = read_value<int32_t>(stream);
+            if (bin == pseudo_bin)
+                skip_bytes(stream, n_chunk * 2 * sizeof(uint64_t));
+            else
+                reference_offsets[r] = min_chunk_begin(stream, n_chunk, reference_offsets[r]);
+        }
+        int32_t const n_intv = read_value<int32_t>(stream);
+        linear_indices[r].resize(n_intv);
+        for (uint64_t & offset : linear_indices[r])
+            offset = read_value<uint64_t>(stream);
+    }
+}
+
+void bam_index::read_csi(std::istream & stream)
+{
+    read_value<int32_t>(stream); // min_shift
+    int32_t const depth = read_value<int32_t>(stream);
+    int32_t const l_aux = read_value<int32_t>(stream);
+    skip_bytes(stream, l_aux);
+    // Pseudo bin holding meta data instead of alignment chunks.
+    uint32_t const pseudo_bin = ((1u << ((depth + 1) * 3)) - 1) / 7 + 1;
+
+    int32_t const n_ref = read_value<int32_t>(stream);
+    reference_offsets.resize(n_ref);
+    linear_indices.resize(n_ref);
+    for (int32_t r = 0; r < n_ref; ++r)
+    {
+        int32_t const n_bin = read_value<int32_t>(stream);
+        for (int32_t b = 0; b < n_bin; ++b)
+        {
+            uint32_t const bin = read_value<uint32_t>(stream);
+            read_value<uint64_t>(stream); // loffset
+            int32_t const n_chunk = read_value<int32_t>(stream);
+            if (bin == pseudo_bin)
+                skip_bytes(stream, n_chunk * 2 * sizeof(uint64_t));
+            else
+                reference_offsets[r] = min_chunk_begin(stream, n_chunk, reference_offsets[r]);
+        }
+    }
+}
+
+std::filesystem::path bam_index::find_index_file(std::filesystem::path const & bam_path)
+{
+    std::filesystem::path const candidates[]{std::filesystem::path{bam_path.string() + ".bai"},
+                                             std::filesystem::path{bam_path}.replace_extension(".bai"),
+                                             std::filesystem::path{bam_path.string() + ".csi"}};
+    for (std::filesystem::path const & candidate : candidates)
+    {
+        if (std::filesystem::exists(candidate))
+            return candidate;
+    }
+    return {};
+}
+
+std::vector<bam_region> bam_index::split_into_regions(std::vector<int32_t> const & references_lengths,
+                                                      int32_t const region_size) const
+{
+    if (references_lengths.size() != reference_offsets.size())
+    {
+        throw seqan3::format_error{"ERROR: The number of reference sequences in the BAM index does not match the "
+                                   "BAM header."};
+    }
+
+    std::vector<bam_region> regions{};
+    for (size_t ref_id = 0; ref_id < reference_offsets.size(); ++ref_id)
+    {
+        if (!reference_offsets[ref_id])
+            continue;
+
+        int32_t const ref_length = references_lengths[ref_id];
+        std::vector<uint64_t> const & linear_index = linear_indices[ref_id];
+        if (region_size <= 0 || linear_index.empty() || region_size >= ref_length)
+        {
+            // Alignments may start behind the reference length, so the last region is open-ended.
+            regions.push_back(bam_region{static_cast<int32_t>(ref_id),
+                                         0,
+                                         std::numeric_limits<int32_t>::max(),
+                                         *reference_offsets[ref_id]});
+            continue;
+        }
+
+        for (int64_t begin = 0; begin < ref_length; begin += region_size)
+        {
+            size_t const window = begin >> linear_index_shift;
+            if (window >= linear_index.size())
+                break;
+            // Empty windows are stored as 0 and can be served from the start of the reference sequence.
+            uint64_t const offset = std::max(linear_index[window], *reference_offsets[ref_id]);
+            int64_t const end = begin + region_size;
+            regions.push_back(bam_region{static_cast<int32_t>(ref_id),
+                                         static_cast<int32_t>(begin),
+                                         end >= ref_length ? std::numeric_limits<int32_t>::max()
+                                                           : static_cast<int32_t>(end),
+                                         offset});
+        }
+        // The last region of a reference sequence has to catch alignments starting behind its length.
+        regions.back().end = std::numeric_limits<int32_t>::max();
+    }
+    return regions;
+}
@@ -0,0 +1,307 @@
+#include "variant_detection/bam_reader.hpp"
+
+#include <charconv>                     // for std::from_chars
+#include <cstring>                      // for std::memcpy
+
+#include <seqan3/io/exception.hpp>      // for seqan3::format_error
+
+namespace
+{
+template <typename value_t>
+inline value_t read_value(char const * data)
+{
+    value_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+template <typename value_t>
+inline value_t read_value(bgzf_reader & reader)
+{
+    value_t value{};
+    reader.read_exactly(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+// Size of the fixed fields of a BAM record (without block_size).
+constexpr size_t bam_fixed_fields_size = 32;
+
+// Returns the size of a value of the given type in an auxiliary field of a BAM record.
+inline size_t aux_type_size(char const type)
+{
+    switch (type)
+    {
+        case 'A': case 'c': case 'C':
+            return 1;
+        case 's': case 'S':
+            return 2;
+        case 'i': case 'I': case 'f':
+            return 4;
+        default:
+            throw seqan3::format_error{std::string{"ERROR: Unknown type '"} + type + "' of a BAM tag."};
+    }
+}
+
+// Returns the value of a string field of the type Z or H, which starts at `data`.
+inline std::string_view read_string_value(char const * const data, char const * const end)
+{
+    char const * const value_end = static_cast<char const *>(std::memchr(data, '\0', end - data));
+    if (value_end == nullptr)
+        throw seqan3::format_error{"ERROR: Unterminated string in a BAM tag."};
+    return std::string_view{data, static_cast<size_t>(value_end - data)};
+}
+
+/* Searches a tag in the auxiliary data of a BAM record. Each field consists of a two character tag, a type character
+ * and a value, which is a null-terminated string for the types Z and H, or an array for the type B. Returns a pointer
+ * to the type character of the field, or nullptr if the record has no such field.
+ */
+inline char const * find_aux_field(char const * data, char const * const end, std::string_view const tag)
+{
+    while (data + 3 <= end)
+    {
+        if (data[0] == tag[0] && data[1] == tag[1])
+            return data + 2;
+        char const type = data[2];
+        data += 3;
+        if (type == 'Z' || type == 'H')
+        {
+            data += read_string_value(data, end).size() + 1;
+        }
+        else if (type == 'B')
+        {
+            if (data + 5 > end)
+                break;
+            size_t const element_size = aux_type_size(data[0]);
+            uint32_t const count = read_value<uint32_t>(data + 1);
+            data += 5 + element_size * count;
+        }
+        else
+        {
+            data += aux_type_size(type);
+        }
+    }
+    return nullptr;
+}
+
+// Searches the SA tag in the auxiliary data of a BAM record, returns an empty value if the record has none.
+inline std::string_view find_sa_tag(char const * const data, char const * const end)
+{
+    char const * const field = find_aux_field(data, end, "SA");
+    if (field == nullptr || (field[0] != 'Z' && field[0] != 'H'))
+        return {};
+    return read_string_value(field + 1, end);
+}
+
+// Decodes `count` CIGAR operations, each stored as op_len << 4 | op, reusing the memory of `cigar`.
+inline void decode_binary_cigar(char const * const data, size_t const count, std::vector<seqan3::cigar> & cigar)
+{
+    static constexpr char cigar_operations[] = "MIDNSHP=X";
+    cigar.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t const value = read_value<uint32_t>(data + 4 * i);
+        if ((value & 0xF) > 8)
+            throw seqan3::format_error{"ERROR: Invalid CIGAR operation in BAM record."};
+        seqan3::cigar::operation operation{};
+        operation.assign_char(cigar_operations[value & 0xF]);
+        cigar[i] = seqan3::cigar{value >> 4, operation};
+    }
+}
+
+// Decodes a CIGAR string in text form like "10M2I5M", reusing the memory of `cigar`.
+inline void decode_cigar_string(std::string_view const text, std::vector<seqan3::cigar> & cigar)
+{
+    static constexpr std::string_view cigar_operations{"MIDNSHP=X"};
+    cigar.clear();
+    char const * current = text.data();
+    char const * const end = text.data() + text.size();
+    while (current != end)
+    {
+        uint32_t length{};
+        auto const [operation_ptr, error] = std::from_chars(current, end, length);
+        if (error != std::errc{} || operation_ptr == end ||
+            cigar_operations.find(*operation_ptr) == std::string_view::npos)
+            throw seqan3::format_error{"ERROR: Invalid CIGAR string in the CG tag of a BAM record."};
+        seqan3::cigar::operation operation{};
+        operation.assign_char(*operation_ptr);
+        cigar.emplace_back(length, operation);
+        current = operation_ptr + 1;
+    }
+}
+
+/* Decodes the CIGAR string stored in the CG tag, whose field starts with the type character at `field`. The SAM/BAM
+ * Format Specification stores it as an array of the type B,I in the binary CIGAR encoding, seqan3::sam_file_output
+ * writes it in text form as a string of the type Z.
+ */
+inline void decode_cg_tag(char const * const field, char const * const end, std::vector<seqan3::cigar> & cigar)
+{
+    if (field[0] == 'Z')
+    {
+        decode_cigar_string(read_string_value(field + 1, end), cigar);
+        return;
+    }
+    if (field[0] != 'B' || field + 6 > end || (field[1] != 'I' && field[1] != 'i'))
+        throw seqan3::format_error{"ERROR: Invalid CG tag in BAM record."};
+    size_t const count = read_value<uint32_t>(field + 2);
+    if (4 * count > static_cast<size_t>(end - (field + 6)))
+        throw seqan3::format_error{"ERROR: Invalid CG tag in BAM record."};
+    decode_binary_cigar(field + 6, count, cigar);
+}
+
+// Offsets of the variable fields in the record buffer.
+struct variable_field_offsets
+{
+    uint8_t l_read_name;
+    uint16_t n_cigar_op;
+    int32_t l_seq;
+    size_t cigar;
+    size_t sequence;
+    size_t aux;
+};
+
+inline variable_field_offsets get_variable_field_offsets(std::vector<char> const & record_buffer)
+{
+    char const * const data = record_buffer.data();
+    variable_field_offsets offsets{read_value<uint8_t>(data + 8),
+                                   read_value<uint16_t>(data + 12),
+                                   read_value<int32_t>(data + 16),
+                                   0, 0, 0};
+    if (offsets.l_read_name == 0 || offsets.l_seq < 0)
+        throw seqan3::format_error{"ERROR: Invalid BAM record."};
+    offsets.cigar = bam_fixed_fields_size + offsets.l_read_name;
+    offsets.sequence = offsets.cigar + 4 * offsets.n_cigar_op;
+    offsets.aux = offsets.sequence + (offsets.l_seq + 1) / 2 + offsets.l_seq;  // skip sequence and base qualities
+    if (offsets.aux > record_buffer.size())
+        throw seqan3::format_error{"ERROR: Invalid BAM record."};
+    return offsets;
+}
+} // namespace
+
+bam_file_reader::bam_file_reader(std::filesystem::path const & path, size_t const decompression_threads) :
+    reader{path, decompression_threads}
+{
+    char magic[4]{};
+    if (reader.read(magic, 4) != 4 || std::string_view{magic, 4} != std::string_view{"BAM\1", 4})
+        throw seqan3::format_error{"ERROR: The file '" + path.string() + "' is not a BAM file."};
+
+    // Plain header text, only the sorting order of the @HD line is needed.
+    int32_t const l_text = read_value<int32_t>(reader);
+    std::string text(l_text, '\0');
+    reader.read_exactly(text.data(), l_text);
+    if (text.starts_with("@HD"))
+    {
+        std::string_view const hd_line = std::string_view{text}.substr(0, text.find('\n'));
+        size_t const so_pos = hd_line.find("\tSO:");
+        if (so_pos != std::string_view::npos)
+        {
+            std::string_view const value = hd_line.substr(so_pos + 4);
+            file_header.sorting = value.substr(0, value.find('\t'));
+        }
+    }
+
+    // Binary reference sequence dictionary.
+    int32_t const n_ref = read_value<int32_t>(reader);
+    for (int32_t i = 0; i < n_ref; ++i)
+    {
+        int32_t const l_name = read_value<int32_t>(reader);
+        std::string name(l_name, '\0');
+        reader.read_exactly(name.data(), l_name);
+        name.resize(std::strlen(name.c_str()));   // drop the terminating null character
+        int32_t const l_ref = read_value<int32_t>(reader);
+        file_header.reference_names.push_back(std::move(name));
+        file_header.ref_id_info.emplace_back(l_ref, "");
+    }
+}
+
+bam_file_header const & bam_file_reader::header() const
+{
+    return file_header;
+}
+
+void bam_file_reader::seek(uint64_t const virtual_offset)
+{
+    reader.seek(virtual_offset);
+}
+
+bool bam_file_reader::read_fixed_fields(bam_record & record)
+{
+    int32_t block_size{};
+    size_t const bytes_read = reader.read(reinterpret_cast<char *>(&block_size), sizeof(block_size));
+    if (bytes_read == 0)
+        return false;
+    if (bytes_read != sizeof(block_size) || block_size < static_cast<int32_t>(bam_fixed_fields_size))
+        throw seqan3::format_error{"ERROR: Invalid BAM record."};
+
+    record_buffer.resize(block_size);
+    reader.read_exactly(record_buffer.data(), block_size);
+    char const * const data = record_buffer.data();
+
+    record.ref_id = read_value<int32_t>(data);
+    record.pos = read_value<int32_t>(data + 4);
+    record.mapq = read_value<uint8_t>(data + 9);
+    record.flag = read_value<uint16_t>(data + 14);
+    return true;
+}
+
+void bam_file_reader::decode_variable_fields(bam_record & record, bam_record_fields const fields)
+{
+    variable_field_offsets const offsets = get_variable_field_offsets(record_buffer);
+    char const * const data = record_buffer.data();
+
+    record.read_name.assign(data + bam_fixed_fields_size, offsets.l_read_name - 1);
+
+    if (fields.cigar)
+    {
+        // A CIGAR string of more than 65535 operations is stored in the CG tag and the CIGAR field holds the
+        // placeholder <l_seq>S<reference length>N instead, which is replaced like seqan3::sam_file_input does.
+        char const * const cigar_field = data + offsets.cigar;
+        uint32_t const sequence_soft_clip = static_cast<uint32_t>(offsets.l_seq) << 4 | 4;   // <l_seq>S
+        bool const is_placeholder = offsets.n_cigar_op == 2 && offsets.l_seq > 0 &&
+                                    read_value<uint32_t>(cigar_field) == sequence_soft_clip &&
+                                    (read_value<uint32_t>(cigar_field + 4) & 0xF) == 3;   // N
+        char const * cg_field = nullptr;
+        if (is_placeholder)
+            cg_field = find_aux_field(data + offsets.aux, data + record_buffer.size(), "CG");
+        if (cg_field != nullptr)
+            decode_cg_tag(cg_field, data + record_buffer.size(), record.cigar);
+        else
+            decode_binary_cigar(cigar_field, offsets.n_cigar_op, record.cigar);
+    }
+    else
+    {
+        record.cigar.clear();
+    }
+
+    if (fields.sequence)
+        decode_sequence(record);
+    else
+        record.sequence.clear();
+
+    if (fields.sa_tag)
+        record.sa_tag = find_sa_tag(data + offsets.aux, data + record_buffer.size());
+    else
+        record.sa_tag.clear();
+}
+
+void bam_file_reader::decode_sequence(bam_record & record)
+{
+    variable_field_offsets const offsets = get_variable_field_offsets(record_buffer);
+    char const * const data = record_buffer.data() + offsets.sequence;
+
+    // The sequence is stored with 4 bits per base, the high nibble first.
+    static constexpr char sequence_characters[] = "=ACMGRSVTWYHKDBN";
+    record.sequence.resize(offsets.l_seq);
+    for (int32_t i = 0; i < offsets.l_seq; ++i)
+    {
+        uint8_t const code = (static_cast<uint8_t>(data[i / 2]) >> ((i % 2) ? 0 : 4)) & 0xF;
+        record.sequence[i].assign_char(sequence_characters[code]);
+    }
+}
+
+bool bam_file_reader::read_record(bam_record & record)
+{
+    if (!read_fixed_fields(record))
+        return false;
+    decode_variable_fields(record);
+    return true;
+}
@@ -0,0 +1,316 @@
+#include "variant_detection/bgzf_reader.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstring>                      // for std::memcpy
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>                       // for inflate
+
+#include <seqan3/io/exception.hpp>      // for seqan3::format_error
+
+namespace
+{
+// Size of the fixed part of the gzip header of a BGZF block (up to and including XLEN).
+constexpr size_t bgzf_header_size = 12;
+// Size of the gzip footer of a BGZF block (CRC32 and ISIZE).
+constexpr size_t bgzf_footer_size = 8;
+// Maximal size of the uncompressed data of a BGZF block.
+constexpr size_t bgzf_max_block_size = 65536;
+
+inline uint16_t read_uint16(char const * data)
+{
+    uint16_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t read_uint32(char const * data)
+{
+    uint32_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Inflates the raw deflate data of a BGZF block into `block`, which has to have the size of the uncompressed data.
+void inflate_block(std::vector<char> & compressed, std::vector<char> & block)
+{
+    if (block.empty())
+        return;
+
+    z_stream stream{};
+    stream.next_in = reinterpret_cast<Bytef *>(compressed.data());
+    stream.avail_in = compressed.size();
+    stream.next_out = reinterpret_cast<Bytef *>(block.data());
+    stream.avail_out = block.size();
+    // Negative window bits: raw deflate data without zlib header.
+    if (inflateInit2(&stream, -15) != Z_OK)
+        throw std::runtime_error{"Could not initialize the BGZF decompression."};
+    int const status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END || stream.total_out != block.size())
+        throw seqan3::format_error{"ERROR: Could not decompress BGZF block."};
+}
+} // namespace
+
+/* Threads inflating the blocks following the current one. The reader thread reads the compressed blocks in file order
+ * and appends them to `pending`, the workers inflate them in any order, and the reader takes them from the front of
+ * `pending` as soon as they are done.
+ */
+struct bgzf_reader::decompression_pool
+{
+    struct job
+    {
+        uint64_t address{};
+        uint64_t next_address{};
+        std::vector<char> compressed{};
+        std::vector<char> data{};
+        bool done{false};
+        std::exception_ptr error{};
+    };
+
+    size_t const lookahead;
+    uint64_t next_read_address{0};
+    bool end_of_file{false};
+    std::deque<std::shared_ptr<job>> pending{};     // in file order, owned by the reader
+    std::deque<std::shared_ptr<job>> todo{};        // not yet taken by a worker
+    std::mutex mutex{};
+    std::condition_variable work_available{};
+    std::condition_variable job_done{};
+    bool stop{false};
+    std::vector<std::thread> workers{};
+
+    explicit decompression_pool(size_t const threads) : lookahead{4 * threads}
+    {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this] () { work(); });
+    }
+
+    ~decompression_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        work_available.notify_all();
+        for (std::thread & worker : workers)
+            worker.join();
+    }
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        while (true)
+        {
+            work_available.wait(lock, [this] () { return stop || !todo.empty(); });
+            if (stop)
+                return;
+            std::shared_ptr<job> current = std::move(todo.front());
+            todo.pop_front();
+            lock.unlock();
+            try
+            {
+                inflate_block(current->compressed, current->data);
+            }
+            catch (...)
+            {
+                current->error = std::current_exception();
+            }
+            lock.lock();
+            current->done = true;
+            job_done.notify_all();
+        }
+    }
+
+    void submit(std::shared_ptr<job> new_job)
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            pending.push_back(new_job);
+            todo.push_back(std::move(new_job));
+        }
+        work_available.notify_one();
+    }
+
+    // Waits until the first pending block is inflated and removes it from the queue.
+    std::shared_ptr<job> take_front()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        job_done.wait(lock, [this] () { return pending.front()->done; });
+        std::shared_ptr<job> front = std::move(pending.front());
+        pending.pop_front();
+        if (front->error)
+            std::rethrow_exception(front->error);
+        return front;
+    }
+
+    // Drops all blocks read ahead, e.g. after a seek. Jobs in progress are finished by the workers and discarded.
+    void reset(uint64_t const address)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        pending.clear();
+        todo.clear();
+        next_read_address = address;
+        end_of_file = false;
+    }
+};
+
+bgzf_reader::bgzf_reader(std::filesystem::path const & path, size_t const threads) : file{path, std::ios::binary}
+{
+    if (!file.good() || !file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for reading."};
+    }
+    compressed_block.reserve(bgzf_max_block_size);
+    block.reserve(bgzf_max_block_size);
+    if (threads > 1)
+        pool = std::make_unique<decompression_pool>(threads);
+}
+
+bgzf_reader::bgzf_reader(bgzf_reader &&) noexcept = default;
+bgzf_reader & bgzf_reader::operator=(bgzf_reader &&) noexcept = default;
+bgzf_reader::~bgzf_reader() = default;
+
+bool bgzf_reader::read_compressed_block(uint64_t const address,
+                                        std::vector<char> & compressed,
+                                        uint32_t & uncompressed_size,
+                                        uint64_t & block_size)
+{
+    std::array<char, bgzf_header_size> header{};
+    file.clear();
+    file.seekg(address);
+    file.read(header.data(), header.size());
+    if (file.gcount() == 0)
+        return false;
+    if (static_cast<size_t>(file.gcount()) != header.size() ||
+        static_cast<uint8_t>(header[0]) != 31 || static_cast<uint8_t>(header[1]) != 139 ||
+        static_cast<uint8_t>(header[2]) != 8 || (static_cast<uint8_t>(header[3]) & 4) == 0)
+    {
+        throw seqan3::format_error{"ERROR: Invalid BGZF block header."};
+    }
+
+    // Find the BC subfield in the extra field, it holds the total block size minus 1.
+    uint16_t const extra_length = read_uint16(header.data() + 10);
+    std::vector<char> extra(extra_length);
+    file.read(extra.data(), extra_length);
+    block_size = 0;
+    for (size_t i = 0; i + 4 <= extra.size();)
+    {
+        uint16_t const subfield_length = read_uint16(extra.data() + i + 2);
+        if (extra[i] == 'B' && extra[i + 1] == 'C' && subfield_length == 2)
+            block_size = read_uint16(extra.data() + i + 4) + 1u;
+        i += 4 + subfield_length;
+    }
+    if (block_size < bgzf_header_size + extra_length + bgzf_footer_size)
+        throw seqan3::format_error{"ERROR: Invalid BGZF block header (missing BC subfield)."};
+
+    size_t const compressed_size = block_size - bgzf_header_size - extra_length - bgzf_footer_size;
+    compressed.resize(compressed_size);
+    file.read(compressed.data(), compressed_size);
+    std::array<char, bgzf_footer_size> footer{};
+    file.read(footer.data(), footer.size());
+    if (!file.good())
+        throw seqan3::format_error{"ERROR: Unexpected end of BGZF file."};
+
+    uncompressed_size = read_uint32(footer.data() + 4);
+    if (uncompressed_size > bgzf_max_block_size)
+        throw seqan3::format_error{"ERROR: Invalid BGZF block (uncompressed size too large)."};
+    return true;
+}
+
+bool bgzf_reader::load_next_block()
+{
+    block.clear();
+    block_offset = 0;
+    block_address = next_block_address;
+
+    if (!pool)
+    {
+        uint32_t uncompressed_size{};
+        uint64_t block_size{};
+        if (!read_compressed_block(block_address, compressed_block, uncompressed_size, block_size))
+            return false;
+        next_block_address = block_address + block_size;
+        block.resize(uncompressed_size);
+        inflate_block(compressed_block, block);
+        return true;
+    }
+
+    // Keep the workers busy with the following blocks.
+    while (!pool->end_of_file && pool->pending.size() < pool->lookahead)
+    {
+        auto new_job = std::make_shared<decompression_pool::job>();
+        uint32_t uncompressed_size{};
+        uint64_t block_size{};
+        if (!read_compressed_block(pool->next_read_address, new_job->compressed, uncompressed_size, block_size))
+        {
+            pool->end_of_file = true;
+            break;
+        }
+        new_job->address = pool->next_read_address;
+        new_job->next_address = pool->next_read_address + block_size;
+        new_job->data.resize(uncompressed_size);
+        pool->next_read_address = new_job->next_address;
+        pool->submit(std::move(new_job));
+    }
+    if (pool->pending.empty())
+        return false;
+
+    std::shared_ptr<decompression_pool::job> const next = pool->take_front();
+    block_address = next->address;
+    next_block_address = next->next_address;
+    block.swap(next->data);
+    return true;
+}
+
+size_t bgzf_reader::read(char * buffer, size_t count)
+{
+    size_t bytes_read = 0;
+    while (bytes_read < count)
+    {
+        // Empty blocks (e.g. the EOF marker) are skipped.
+        if (block_offset == block.size())
+        {
+            if (!load_next_block())
+                break;
+            continue;
+        }
+        size_t const chunk = std::min(count - bytes_read, block.size() - block_offset);
+        std::memcpy(buffer + bytes_read, block.data() + block_offset, chunk);
+        block_offset += chunk;
+        bytes_read += chunk;
+    }
+    return bytes_read;
+}
+
+void bgzf_reader::read_exactly(char * buffer, size_t count)
+{
+    if (read(buffer, count) != count)
+        throw seqan3::format_error{"ERROR: Unexpected end of BGZF file."};
+}
+
+uint64_t bgzf_reader::tell() const
+{
+    if (block_offset == block.size())
+        return next_block_address << 16;
+    return (block_address << 16) | block_offset;
+}
+
+void bgzf_reader::seek(uint64_t const virtual_offset)
+{
+    next_block_address = virtual_offset >> 16;
+    if (pool)
+        pool->reset(next_block_address);
+    size_t const offset_in_block = virtual_offset & 0xFFFF;
+    if (!load_next_block())
+    {
+        if (offset_in_block != 0)
+            throw seqan3::format_error{"ERROR: Seek beyond the end of the BGZF file."};
+        return;
+    }
+    if (offset_in_block > block.size())
+        throw seqan3::format_error{"ERROR: Invalid virtual file offset."};
+    block_offset = offset_in_block;
+}
@@ -0,0 +1,258 @@
+#include "variant_detection/cluster_checkpoint.hpp"
+
+#include <algorithm>    // for std::lower_bound, std::upper_bound
+#include <array>
+#include <fstream>
+#include <stdexcept>    // for std::runtime_error
+#include <string>
+#include <string_view>
+
+#include <seqan3/core/debug_stream.hpp>
+
+namespace
+{
+constexpr std::array<char, 8> checkpoint_magic{'i', 'G', 'V', 'c', 'l', 's', 't', '\0'};
+constexpr uint32_t checkpoint_version = 2;
+// Written in the native byte order, so that a checkpoint of another byte order is detected.
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+// The header is followed by the member offsets (uint64_t per cluster and the end of the last cluster), the members
+// (uint32_t indices into the junctions, padded to 8 bytes) and the summaries of the clusters.
+struct checkpoint_header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_junctions;
+    // Fingerprint of the junctions, so that the checkpoint is only used with the junction store it belongs to.
+    uint64_t junctions_fingerprint;
+    uint64_t num_clusters;
+    uint64_t num_members;
+    // Parameters of the junction detection and the clustering the clusters were computed with.
+    int32_t min_var_length;
+    int32_t max_overlap;
+    int32_t clustering_method;
+    int32_t compaction_tolerance;
+    double hierarchical_clustering_cutoff;
+};
+
+// The summary of a cluster, the sequences and orientations of the average mates are the ones of the members.
+struct checkpoint_summary
+{
+    int64_t sum_mate1_positions;
+    int64_t sum_mate2_positions;
+    uint64_t sum_inserted_sizes;
+    int32_t average_mate1_position;
+    int32_t average_mate2_position;
+    int32_t average_inserted_size;
+    int32_t min_inserted_size;
+    int32_t max_inserted_size;
+    int32_t padding;
+};
+
+// FNV-1a hash of the mates, inserted sequences and read names of the junctions. The sequences of the mates are hashed
+// by name, as their ids depend on the order the names were added to the sequence dictionary in.
+uint64_t junctions_fingerprint(std::span<Junction const> const junctions)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto const add_bytes = [&] (void const * data, size_t const size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<unsigned char const *>(data)[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto const add_breakend = [&] (Breakend const & breakend)
+    {
+        std::string const & seq_name = breakend.seq_name();
+        add_bytes(seq_name.data(), seq_name.size() + 1);
+        add_bytes(&breakend.position, sizeof(breakend.position));
+        add_bytes(&breakend.orientation, sizeof(breakend.orientation));
+    };
+    for (Junction const & junction : junctions)
+    {
+        add_breakend(junction.get_mate1());
+        add_breakend(junction.get_mate2());
+        uint64_t const inserted_size = junction.inserted_size();
+        add_bytes(&inserted_size, sizeof(inserted_size));
+        std::string_view const packed_sequence = junction.packed_inserted_sequence();
+        add_bytes(packed_sequence.data(), packed_sequence.size());
+        std::string_view const read_name = junction.get_read_name();
+        add_bytes(read_name.data(), read_name.size());
+        add_bytes("", 1);
+    }
+    return hash;
+}
+
+constexpr uint64_t padding_size(uint64_t const size)
+{
+    return (8 - size % 8) % 8;
+}
+
+template <typename value_t>
+void write_values(std::ofstream & stream, std::vector<value_t> const & values)
+{
+    stream.write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(value_t));
+}
+
+template <typename value_t>
+bool read_values(std::ifstream & stream, std::vector<value_t> & values, size_t const num_values)
+{
+    values.resize(num_values);
+    return static_cast<bool>(stream.read(reinterpret_cast<char *>(values.data()), num_values * sizeof(value_t)));
+}
+} // namespace
+
+void write_cluster_checkpoint(std::filesystem::path const & path,
+                              std::span<Cluster const> const clusters,
+                              std::span<Junction const> const junctions,
+                              cmd_arguments const & args)
+{
+    std::vector<uint64_t> member_offsets{0};
+    std::vector<uint32_t> members{};
+    std::vector<checkpoint_summary> summaries{};
+    member_offsets.reserve(clusters.size() + 1);
+    members.reserve(junctions.size());
+    summaries.reserve(clusters.size());
+
+    // Equal members are found among the equal junctions, which are neighbors in sorted order. Every junction is the
+    // member of one cluster only.
+    std::vector<bool> used(junctions.size(), false);
+    for (Cluster const & cluster : clusters)
+    {
+        for (Junction const & member : cluster.get_members())
+        {
+            auto const first = std::lower_bound(junctions.begin(), junctions.end(), member);
+            auto const last = std::upper_bound(first, junctions.end(), member);
+            auto it = first;
+            while (it != last && (used[it - junctions.begin()] || it->get_read_name() != member.get_read_name()))
+                ++it;
+            if (it == last)
+            {
+                throw std::runtime_error{"The clusters can not be written to the checkpoint '" + path.string() +
+                                         "', because a member is not one of the clustered junctions."};
+            }
+            used[it - junctions.begin()] = true;
+            members.push_back(it - junctions.begin());
+        }
+        member_offsets.push_back(members.size());
+        summaries.push_back(checkpoint_summary{cluster.sum_mate1_positions,
+                                               cluster.sum_mate2_positions,
+                                               cluster.sum_inserted_sizes,
+                                               cluster.average_mate1.position,
+                                               cluster.average_mate2.position,
+                                               cluster.average_inserted_size,
+                                               cluster.min_inserted_size,
+                                               cluster.max_inserted_size,
+                                               0});
+    }
+
+    checkpoint_header const header{checkpoint_magic,
+                                   checkpoint_version,
+                                   byte_order_mark,
+                                   junctions.size(),
+                                   junctions_fingerprint(junctions),
+                                   clusters.size(),
+                                   members.size(),
+                                   args.min_var_length,
+                                   args.max_overlap,
+                                   static_cast<int32_t>(args.clustering_method),
+                                   args.compaction_tolerance,
+                                   args.hierarchical_clustering_cutoff};
+
+    std::ofstream checkpoint_file{path, std::ios::binary};
+    if (!checkpoint_file.good() || !checkpoint_file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for writing."};
+    }
+    char const padding[8]{};
+    checkpoint_file.write(reinterpret_cast<char const *>(&header), sizeof(checkpoint_header));
+    write_values(checkpoint_file, member_offsets);
+    write_values(checkpoint_file, members);
+    checkpoint_file.write(padding, padding_size(members.size() * sizeof(uint32_t)));
+    write_values(checkpoint_file, summaries);
+    if (!checkpoint_file)
+    {
+        throw std::runtime_error{"Could not write the cluster checkpoint '" + path.string() + "'."};
+    }
+}
+
+std::vector<Cluster> read_cluster_checkpoint(std::filesystem::path const & path,
+                                             std::span<Junction const> const junctions,
+                                             cmd_arguments const & args)
+{
+    std::ifstream checkpoint_file{path, std::ios::binary};
+    if (!checkpoint_file.good() || !checkpoint_file.is_open())
+    {
+        throw std::runtime_error{"Could not open file '" + path.string() + "' for reading."};
+    }
+    auto const invalid = [&] (std::string const & reason)
+    {
+        return std::runtime_error{"The file '" + path.string() + "' is not a valid cluster checkpoint: " + reason +
+                                  "."};
+    };
+
+    checkpoint_header header{};
+    if (!checkpoint_file.read(reinterpret_cast<char *>(&header), sizeof(checkpoint_header)) ||
+        header.magic != checkpoint_magic)
+        throw invalid("unknown file format");
+    if (header.byte_order != byte_order_mark)
+        throw invalid("written with another byte order");
+    if (header.version != checkpoint_version)
+    {
+        throw invalid("version " + std::to_string(header.version) + " instead of " +
+                      std::to_string(checkpoint_version));
+    }
+    if (header.num_junctions != junctions.size() || header.junctions_fingerprint != junctions_fingerprint(junctions))
+        throw invalid("it belongs to another junction store");
+
+    std::vector<uint64_t> member_offsets{};
+    std::vector<uint32_t> members{};
+    std::vector<checkpoint_summary> summaries{};
+    char padding[8]{};
+    if (header.num_members > junctions.size() || header.num_clusters > header.num_members ||
+        !read_values(checkpoint_file, member_offsets, header.num_clusters + 1) ||
+        !read_values(checkpoint_file, members, header.num_members) ||
+        !checkpoint_file.read(padding, padding_size(header.num_members * sizeof(uint32_t))) ||
+        !read_values(checkpoint_file, summaries, header.num_clusters))
+        throw invalid("truncated file");
+
+    if (header.min_var_length != args.min_var_length ||
+        header.max_overlap != args.max_overlap ||
+        header.clustering_method != static_cast<int32_t>(args.clustering_method) ||
+        header.compaction_tolerance != args.compaction_tolerance ||
+        header.hierarchical_clustering_cutoff != args.hierarchical_clustering_cutoff)
+    {
+        seqan3::debug_stream << "Warning: The clusters of the checkpoint were computed with other parameters of the "
+                                "junction detection or the clustering, which are not applied again.\n";
+    }
+
+    std::vector<Cluster> clusters(header.num_clusters);
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        if (member_offsets[c] >= member_offsets[c + 1] || member_offsets[c + 1] > members.size())
+            throw invalid("corrupted member offsets");
+        Cluster & cluster = clusters[c];
+        cluster.members.reserve(member_offsets[c + 1] - member_offsets[c]);
+        for (size_t m = member_offsets[c]; m < member_offsets[c + 1]; ++m)
+        {
+            if (members[m] >= junctions.size())
+                throw invalid("corrupted members");
+            cluster.members.push_back(junctions[members[m]]);
+        }
+
+        checkpoint_summary const & summary = summaries[c];
+        cluster.sum_mate1_positions = summary.sum_mate1_positions;
+        cluster.sum_mate2_positions = summary.sum_mate2_positions;
+        cluster.sum_inserted_sizes = summary.sum_inserted_sizes;
+        cluster.average_mate1 = cluster.members.front().get_mate1();
+        cluster.average_mate1.position = summary.average_mate1_position;
+        cluster.average_mate2 = cluster.members.front().get_mate2();
+        cluster.average_mate2.position = summary.average_mate2_position;
+        cluster.average_inserted_size = summary.average_inserted_size;
+        cluster.min_inserted_size = summary.min_inserted_size;
+        cluster.max_inserted_size = summary.max_inserted_size;
+    }
+    return clusters;
+}
@@ -0,0 +1,85 @@
+#include "variant_detection/contig_pair_buffer.hpp"
+
+#include <algorithm>    // for std::sort, std::max
+#include <stdexcept>    // for std::runtime_error
+
+#include "structures/junction_sort.hpp"     // for sort_junctions()
+
+contig_pair_buffer::contig_pair_buffer(batch_callback the_on_batch) :
+    on_batch{std::move(the_on_batch)}
+{}
+
+void contig_pair_buffer::release(std::vector<std::pair<sequence_id_t, sequence_id_t>> seq_id_pairs)
+{
+    std::sort(seq_id_pairs.begin(), seq_id_pairs.end(), [] (auto const & a, auto const & b)
+    {
+        return std::pair{sequence_rank(a.first), sequence_rank(a.second)} <
+               std::pair{sequence_rank(b.first), sequence_rank(b.second)};
+    });
+    for (auto const & seq_id_pair : seq_id_pairs)
+    {
+        auto it = pairs.find(seq_id_pair);
+        std::vector<Junction> batch = std::move(it->second);
+        pairs.erase(it);
+        sort_junctions(batch);
+        on_batch(batch);
+    }
+}
+
+void contig_pair_buffer::add_sequence(sequence_id_t const seq_id, std::vector<Junction> & junctions)
+{
+    if (seen_seq_ids.contains(seq_id))
+        throw std::runtime_error{"The junctions of a sequence were added twice."};
+
+    // Pairs whose sequences have both been added before were released already.
+    for (Junction & junction : junctions)
+    {
+        sequence_id_t const seq_id_1 = junction.get_mate1().seq_id;
+        sequence_id_t const seq_id_2 = junction.get_mate2().seq_id;
+        if (seen_seq_ids.contains(seq_id_1) && seen_seq_ids.contains(seq_id_2))
+        {
+            late.push_back(std::move(junction));
+            ++num_late;
+        }
+        else
+        {
+            pairs[{seq_id_1, seq_id_2}].push_back(std::move(junction));
+        }
+    }
+    junctions.clear();
+    seen_seq_ids.insert(seq_id);
+
+    std::vector<std::pair<sequence_id_t, sequence_id_t>> complete_pairs{};
+    for (auto const & [seq_id_pair, pair_junctions] : pairs)
+    {
+        if (seen_seq_ids.contains(seq_id_pair.first) && seen_seq_ids.contains(seq_id_pair.second))
+            complete_pairs.push_back(seq_id_pair);
+    }
+    release(std::move(complete_pairs));
+}
+
+void contig_pair_buffer::finish()
+{
+    std::vector<std::pair<sequence_id_t, sequence_id_t>> remaining_pairs{};
+    for (auto const & [seq_id_pair, pair_junctions] : pairs)
+        remaining_pairs.push_back(seq_id_pair);
+    release(std::move(remaining_pairs));
+
+    if (!late.empty())
+    {
+        sort_junctions(late);
+        on_batch(late);
+        late.clear();
+    }
+}
+
+void contig_pair_buffer::compact_arena()
+{
+    if (arena_allocated_bytes() <= arena_limit)
+        return;
+    std::vector<std::span<Junction>> held_junctions{late};
+    for (auto & [seq_id_pair, pair_junctions] : pairs)
+        held_junctions.emplace_back(pair_junctions);
+    compact_junction_arena(held_junctions);
+    arena_limit = std::max(min_arena_compaction_bytes, 2 * arena_allocated_bytes());
+}
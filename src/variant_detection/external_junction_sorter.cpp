@@ -0,0 +1,159 @@
+#include "variant_detection/external_junction_sorter.hpp"
+
+#include <algorithm>    // for std::max
+#include <fstream>
+#include <iterator>     // for std::make_move_iterator
+#include <queue>
+#include <random>       // for std::random_device
+#include <sstream>
+#include <stdexcept>    // for std::runtime_error
+#include <string>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"    // for is_partition_border()
+#include "structures/junction_arena.hpp"                            // for arena_allocated_bytes, arena_clear
+#include "structures/junction_sort.hpp"                             // for sort_junctions()
+
+namespace
+{
+// Bytes of the junctions in memory, including their inserted sequences and read names.
+size_t used_memory(std::vector<Junction> const & junctions)
+{
+    return junctions.size() * sizeof(Junction) + arena_allocated_bytes();
+}
+
+// A sorted run in a temporary file with its next junction.
+struct run_reader
+{
+    std::ifstream stream;
+    Junction current{};
+};
+} // namespace
+
+external_junction_sorter::external_junction_sorter(size_t const the_memory_budget) :
+    memory_budget{the_memory_budget}
+{
+    // Half of the budget is kept for the inserted sequences and read names. The vector is only reallocated if more
+    // junctions are added at once than fit into it.
+    junctions.reserve(std::max<size_t>(memory_budget / 2 / sizeof(Junction), 1));
+}
+
+external_junction_sorter::~external_junction_sorter()
+{
+    if (!directory.empty())
+    {
+        std::error_code error{};
+        std::filesystem::remove_all(directory, error);
+    }
+}
+
+void external_junction_sorter::spill()
+{
+    if (directory.empty())
+    {
+        std::random_device random{};
+        do
+        {
+            directory = std::filesystem::temp_directory_path() / ("iGenVar_" + std::to_string(random()));
+        }
+        while (!std::filesystem::create_directory(directory));
+    }
+
+    sort_junctions(junctions);
+    runs.push_back(directory / ("run_" + std::to_string(runs.size()) + ".bin"));
+    std::ofstream run_file{runs.back(), std::ios::binary};
+    for (Junction const & junction : junctions)
+        write_junction(run_file, junction);
+    run_file.close();
+    if (!run_file.good())
+    {
+        throw std::runtime_error{"Could not write the temporary file '" + runs.back().string() + "'."};
+    }
+
+    junctions.clear();
+    arena_clear();
+}
+
+void external_junction_sorter::add(std::vector<Junction> & new_junctions)
+{
+    // The new junctions refer to the junction arena as well, so they are spilled together with the others.
+    junctions.insert(junctions.end(),
+                     std::make_move_iterator(new_junctions.begin()),
+                     std::make_move_iterator(new_junctions.end()));
+    new_junctions.clear();
+    if (junctions.size() >= junctions.capacity() || used_memory(junctions) >= memory_budget)
+        spill();
+}
+
+void external_junction_sorter::merge(batch_callback const & on_batch)
+{
+    if (runs.empty())
+    {
+        sort_junctions(junctions);
+        if (!junctions.empty())
+            on_batch(junctions);
+        junctions.clear();
+        return;
+    }
+    if (!junctions.empty())
+        spill();
+
+    std::vector<run_reader> readers(runs.size());
+    // The run with the smallest next junction is on top, equal junctions are taken in the order of the runs.
+    auto greater = [&readers] (size_t const a, size_t const b)
+    {
+        if (readers[a].current < readers[b].current)
+            return false;
+        if (readers[b].current < readers[a].current)
+            return true;
+        return a > b;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heads{greater};
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        readers[i].stream.open(runs[i], std::ios::binary);
+        if (!readers[i].stream.is_open())
+            throw std::runtime_error{"Could not open the temporary file '" + runs[i].string() + "'."};
+        if (read_junction(readers[i].stream, readers[i].current))
+            heads.push(i);
+    }
+
+    // The batches end at partition borders once they exceed half of the budget.
+    size_t const batch_budget = memory_budget / 2;
+    std::vector<Junction> batch{};
+    while (!heads.empty())
+    {
+        size_t const i = heads.top();
+        heads.pop();
+        if (!batch.empty() && used_memory(batch) >= batch_budget &&
+            is_partition_border(batch.back().get_mate1(), readers[i].current.get_mate1()))
+        {
+            on_batch(batch);
+            batch.clear();
+
+            // The next junctions of the runs are stored again after the arena is cleared.
+            std::stringstream heads_buffer{};
+            write_junction(heads_buffer, readers[i].current);
+            std::vector<size_t> waiting{};
+            while (!heads.empty())
+            {
+                waiting.push_back(heads.top());
+                heads.pop();
+                write_junction(heads_buffer, readers[waiting.back()].current);
+            }
+            arena_clear();
+            read_junction(heads_buffer, readers[i].current);
+            for (size_t const j : waiting)
+            {
+                read_junction(heads_buffer, readers[j].current);
+                heads.push(j);
+            }
+        }
+
+        batch.push_back(std::move(readers[i].current));
+        if (read_junction(readers[i].stream, readers[i].current))
+            heads.push(i);
+    }
+    if (!batch.empty())
+        on_batch(batch);
+    arena_clear();
+}
@@ -0,0 +1,165 @@
+#include "variant_detection/junction_window.hpp"
+
+#include <algorithm>    // for std::sort, std::inplace_merge, std::max
+#include <iterator>     // for std::make_move_iterator
+#include <limits>       // for std::numeric_limits
+#include <stdexcept>    // for std::runtime_error
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"    // for is_partition_border()
+#include "structures/junction_sort.hpp"                             // for sort_junctions()
+
+namespace
+{
+// The window is released when the boundary has moved by the lag, but at least by this many bases, so that a short lag
+// does not lead to many small batches.
+constexpr int64_t min_release_interval = 100000;
+
+// Larger than all positions, releases all junctions of the current sequence.
+constexpr int64_t end_of_sequence = std::numeric_limits<int64_t>::max();
+} // namespace
+
+junction_window::junction_window(int32_t const the_lag, batch_callback the_on_batch) :
+    lag{the_lag},
+    on_batch{std::move(the_on_batch)}
+{}
+
+void junction_window::release(int64_t const new_boundary)
+{
+    for (size_t orientation = 0; orientation < window.size(); ++orientation)
+    {
+        std::vector<Junction> & junctions = window[orientation];
+        sort_junctions(std::span{junctions}.subspan(num_sorted[orientation]));
+        std::inplace_merge(junctions.begin(), junctions.begin() + num_sorted[orientation], junctions.end());
+
+        // Junctions in front of the boundary can not be followed by new ones anymore. The last of them ends a partition
+        // if the next junction is more than 50bp away, otherwise the release stops at the last border in between.
+        size_t end = std::partition_point(junctions.begin(), junctions.end(), [&] (Junction const & junction)
+        {
+            return junction.get_mate1().position < new_boundary;
+        }) - junctions.begin();
+        if (end > 0 && new_boundary != end_of_sequence &&
+            static_cast<int64_t>(junctions[end - 1].get_mate1().position) + 50 >= new_boundary)
+        {
+            --end;
+            while (end > 0 && !is_partition_border(junctions[end - 1].get_mate1(), junctions[end].get_mate1()))
+                --end;
+        }
+
+        batch.insert(batch.end(),
+                     std::make_move_iterator(junctions.begin()),
+                     std::make_move_iterator(junctions.begin() + end));
+        junctions.erase(junctions.begin(), junctions.begin() + end);
+        num_sorted[orientation] = junctions.size();
+    }
+    boundary = new_boundary;
+
+    // Forward junctions are sorted before reverse junctions of the same sequence, so the batch is sorted.
+    if (!batch.empty())
+        on_batch(batch);
+    batch.clear();
+}
+
+void junction_window::advance(sequence_id_t const seq_id, int32_t const position)
+{
+    if (!started || seq_id != current_seq_id)
+    {
+        if (started)
+        {
+            release(end_of_sequence);
+            finished_seq_ids.insert(current_seq_id);
+        }
+        if (finished_seq_ids.contains(seq_id))
+            throw std::runtime_error{"The alignments are not sorted by coordinate."};
+
+        started = true;
+        current_seq_id = seq_id;
+        boundary = std::numeric_limits<int32_t>::min();
+        // The junctions held for this sequence in the side store enter the window.
+        if (auto it = upcoming.find(seq_id); it != upcoming.end())
+        {
+            for (Junction & junction : it->second)
+                window[static_cast<size_t>(junction.get_mate1().orientation)].push_back(std::move(junction));
+            upcoming.erase(it);
+        }
+    }
+    else
+    {
+        if (position < current_position)
+            throw std::runtime_error{"The alignments are not sorted by coordinate."};
+        int64_t const new_boundary = static_cast<int64_t>(position) - lag;
+        if (new_boundary - boundary >= std::max<int64_t>(lag, min_release_interval))
+            release(new_boundary);
+    }
+    current_position = position;
+}
+
+void junction_window::add(Junction const & junction)
+{
+    Breakend const & mate1 = junction.get_mate1();
+    if (started && mate1.seq_id == current_seq_id)
+    {
+        if (mate1.position < boundary)
+        {
+            late.push_back(junction);
+            ++num_late;
+        }
+        else
+        {
+            window[static_cast<size_t>(mate1.orientation)].push_back(junction);
+        }
+    }
+    else if (finished_seq_ids.contains(mate1.seq_id))
+    {
+        late.push_back(junction);
+        ++num_late;
+    }
+    else
+    {
+        upcoming[mate1.seq_id].push_back(junction);
+    }
+}
+
+void junction_window::finish()
+{
+    if (started)
+    {
+        release(end_of_sequence);
+        finished_seq_ids.insert(current_seq_id);
+        started = false;
+    }
+
+    // Sequences without alignments, which were reached by junctions only, in sorted order.
+    std::vector<sequence_id_t> upcoming_seq_ids{};
+    for (auto const & [seq_id, junctions] : upcoming)
+        upcoming_seq_ids.push_back(seq_id);
+    std::sort(upcoming_seq_ids.begin(), upcoming_seq_ids.end(), [] (sequence_id_t const a, sequence_id_t const b)
+    {
+        return sequence_rank(a) < sequence_rank(b);
+    });
+    for (sequence_id_t const seq_id : upcoming_seq_ids)
+    {
+        batch = std::move(upcoming[seq_id]);
+        sort_junctions(batch);
+        on_batch(batch);
+        batch.clear();
+    }
+    upcoming.clear();
+
+    if (!late.empty())
+    {
+        sort_junctions(late);
+        on_batch(late);
+        late.clear();
+    }
+}
+
+void junction_window::compact_arena()
+{
+    if (arena_allocated_bytes() <= arena_limit)
+        return;
+    std::vector<std::span<Junction>> held_junctions{window[0], window[1], late};
+    for (auto & [seq_id, junctions] : upcoming)
+        held_junctions.emplace_back(junctions);
+    compact_junction_arena(held_junctions);
+    arena_limit = std::max(min_arena_compaction_bytes, 2 * arena_allocated_bytes());
+}
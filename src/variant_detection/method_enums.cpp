@@ -41,3 +41,13 @@ return std::unordered_map<std::string, refinement_methods>{{"0", refinement_meth
                                                            {"sVirl_refinement_method",
                                                            refinement_methods::sVirl_refinement_method}};
 };
+
+std::unordered_map<std::string, resume_stages> enumeration_names(resume_stages)
+{
+return std::unordered_map<std::string, resume_stages>{{"0", resume_stages::no_resume},
+                                                      {"none", resume_stages::no_resume},
+                                                      {"1", resume_stages::resume_from_junctions},
+                                                      {"junctions", resume_stages::resume_from_junctions},
+                                                      {"2", resume_stages::resume_from_clusters},
+                                                      {"clusters", resume_stages::resume_from_clusters}};
+};
@@ -0,0 +1,166 @@
+#include "variant_detection/parameter_sweep.hpp"
+
+#include <algorithm>    // for std::min, std::ranges::find, std::ranges::stable_sort
+#include <array>
+#include <charconv>     // for std::from_chars
+#include <stdexcept>    // for std::runtime_error
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace
+{
+// A swept parameter with the values as given and the setter of a value.
+struct swept_parameter
+{
+    std::string name;
+    std::vector<std::string> values;
+    void (* set)(cmd_arguments &, std::string const &);
+};
+
+int32_t parse_non_negative_integer(std::string const & name, std::string const & value)
+{
+    int32_t number{};
+    auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (error != std::errc{} || end != value.data() + value.size() || number < 0)
+    {
+        throw std::runtime_error{"The value '" + value + "' of the swept parameter " + name +
+                                 " is not a non-negative integer."};
+    }
+    return number;
+}
+
+double parse_non_negative_number(std::string const & name, std::string const & value)
+{
+    size_t end{0};
+    double number{-1};
+    try
+    {
+        number = std::stod(value, &end);
+    }
+    catch (std::logic_error const &)
+    {
+    }
+    if (end != value.size() || !(number >= 0))
+    {
+        throw std::runtime_error{"The value '" + value + "' of the swept parameter " + name +
+                                 " is not a non-negative number."};
+    }
+    return number;
+}
+
+// The parameters, which can be swept.
+std::array<std::pair<std::string_view, void (*)(cmd_arguments &, std::string const &)>, 6> const sweepable_parameters
+{{
+    {"min_var_length", [] (cmd_arguments & args, std::string const & value)
+        { args.min_var_length = parse_non_negative_integer("min_var_length", value); }},
+    {"max_var_length", [] (cmd_arguments & args, std::string const & value)
+        { args.max_var_length = parse_non_negative_integer("max_var_length", value); }},
+    {"max_tol_inserted_length", [] (cmd_arguments & args, std::string const & value)
+        { args.max_tol_inserted_length = parse_non_negative_integer("max_tol_inserted_length", value); }},
+    {"max_overlap", [] (cmd_arguments & args, std::string const & value)
+        { args.max_overlap = parse_non_negative_integer("max_overlap", value); }},
+    {"min_qual", [] (cmd_arguments & args, std::string const & value)
+        { args.min_qual = parse_non_negative_integer("min_qual", value); }},
+    {"hierarchical_clustering_cutoff", [] (cmd_arguments & args, std::string const & value)
+        { args.hierarchical_clustering_cutoff = parse_non_negative_number("hierarchical_clustering_cutoff", value); }}
+}};
+
+// Parses a sweep given as `name=value1,value2,...`.
+swept_parameter parse_swept_parameter(std::string const & sweep)
+{
+    size_t const equal_sign = sweep.find('=');
+    swept_parameter parameter{sweep.substr(0, equal_sign), {}, nullptr};
+    for (auto const & [name, set] : sweepable_parameters)
+    {
+        if (name == parameter.name)
+            parameter.set = set;
+    }
+    if (parameter.set == nullptr)
+    {
+        throw std::runtime_error{"The parameter " + parameter.name + " can not be swept. Value must be one of "
+                                 "[min_var_length,max_var_length,max_tol_inserted_length,max_overlap,min_qual,"
+                                 "hierarchical_clustering_cutoff]."};
+    }
+    if (equal_sign == std::string::npos || equal_sign + 1 == sweep.size())
+        throw std::runtime_error{"The swept parameter " + parameter.name + " has no values."};
+
+    for (size_t begin = equal_sign + 1; begin <= sweep.size();)
+    {
+        size_t const end = std::min(sweep.find(',', begin), sweep.size());
+        std::string value = sweep.substr(begin, end - begin);
+        // The VCF files are named after the values, so a repeated value would overwrite the file of the first one.
+        if (std::ranges::find(parameter.values, value) != parameter.values.end())
+        {
+            throw std::runtime_error{"The value '" + value + "' of the swept parameter " + parameter.name +
+                                     " was given multiple times."};
+        }
+        parameter.values.push_back(std::move(value));
+        // The value is checked once, the combinations are set without errors.
+        cmd_arguments args{};
+        parameter.set(args, parameter.values.back());
+        begin = end + 1;
+    }
+    return parameter;
+}
+} // namespace
+
+std::vector<parameter_combination> parameter_sweep_combinations(cmd_arguments const & args)
+{
+    std::vector<swept_parameter> parameters{};
+    for (std::string const & sweep : args.sweep)
+    {
+        parameters.push_back(parse_swept_parameter(sweep));
+        for (size_t i = 0; i + 1 < parameters.size(); ++i)
+        {
+            if (parameters[i].name == parameters.back().name)
+                throw std::runtime_error{"The parameter " + parameters.back().name + " was swept multiple times."};
+        }
+    }
+
+    std::vector<parameter_combination> combinations{};
+    if (args.sweep_separately)
+    {
+        for (swept_parameter const & parameter : parameters)
+        {
+            for (std::string const & value : parameter.values)
+            {
+                parameter_combination combination{args, args.sweep_output_directory /
+                                                        (parameter.name + "_" + value + ".vcf")};
+                parameter.set(combination.args, value);
+                combinations.push_back(std::move(combination));
+            }
+        }
+    }
+    else if (!parameters.empty())
+    {
+        // Odometer over the values of all parameters, the last parameter changes fastest.
+        std::vector<size_t> value_indices(parameters.size(), 0);
+        while (value_indices[0] < parameters[0].values.size())
+        {
+            parameter_combination combination{args, {}};
+            std::string file_name{};
+            for (size_t p = 0; p < parameters.size(); ++p)
+            {
+                std::string const & value = parameters[p].values[value_indices[p]];
+                parameters[p].set(combination.args, value);
+                file_name += (p == 0 ? "" : ".") + parameters[p].name + "_" + value;
+            }
+            combination.output_file_path = args.sweep_output_directory / (file_name + ".vcf");
+            combinations.push_back(std::move(combination));
+
+            size_t p = parameters.size() - 1;
+            while (++value_indices[p] == parameters[p].values.size() && p > 0)
+                value_indices[p--] = 0;
+        }
+    }
+
+    // The combinations with the same junctions and the same clusters are neighbors.
+    std::ranges::stable_sort(combinations, {}, [] (parameter_combination const & combination)
+    {
+        return std::tuple{combination.args.max_overlap,
+                          combination.args.min_var_length,
+                          combination.args.hierarchical_clustering_cutoff};
+    });
+    return combinations;
+}
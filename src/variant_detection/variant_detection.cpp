@@ -1,13 +1,26 @@
 #include "variant_detection/variant_detection.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <sstream>
+#include <thread>
+
 #include <seqan3/core/debug_stream.hpp>
 #include <seqan3/io/sam_file/input.hpp>         // SAM/BAM support (seqan3::sam_file_input)
 
 #include "modules/sv_detection_methods/analyze_cigar_method.hpp"    // for the split read method
 #include "modules/sv_detection_methods/analyze_read_pair_method.hpp"// for the read pair method
 #include "modules/sv_detection_methods/analyze_sa_tag_method.hpp"   // for the cigar string method
+#include "structures/sequence_dictionary.hpp"                       // for intern_sequence_name(s)
 #include "variant_detection/bam_functions.hpp"                      // for hasFlag* functions
+#include "variant_detection/bam_index.hpp"                          // for class bam_index
+#include "variant_detection/bounded_queue.hpp"                      // for class bounded_queue
+#include "variant_detection/thread_debug_stream.hpp"                // for thread_debug_stream
 
+using seqan3::operator""_cigar_operation;
 using seqan3::operator""_tag;
 
 std::deque<std::string> read_header_information(auto & alignment_file,
@@ -39,10 +52,23 @@ std::deque<std::string> read_header_information(auto & alignment_file,
         }
         ++i;
     }
+    // Add all names at once, so that the global sequence dictionary is not rebuilt for each of them.
+    intern_sequence_names(ref_ids);
 
     return ref_ids;
 }
 
+// Checks the fixed fields of an alignment: skips unmapped, secondary and duplicate alignments and alignments with low
+// mapping quality.
+inline bool is_good_alignment(seqan3::sam_flag const flag,
+                              int32_t const ref_id,
+                              int32_t const ref_pos,
+                              uint8_t const mapq)
+{
+    return !(hasFlagUnmapped(flag) || hasFlagSecondary(flag) || hasFlagDuplicate(flag) || mapq < 20 ||
+             ref_id < 0 || ref_pos < 0);
+}
+
 void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
                                               std::map<std::string, int32_t> & references_lengths,
                                               cmd_arguments const & args)
@@ -54,7 +80,7 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
                                      seqan3::field::mapq>;      // 5: MAPQ
 
     // Set number of decompression threads
-    seqan3::contrib::bgzf_thread_count = args.threads;
+    seqan3::contrib::bgzf_thread_count = args.decompression_threads;
     seqan3::sam_file_input alignment_short_reads_file{args.alignment_short_reads_file_path, my_fields{}};
 
     std::deque<std::string> const ref_ids = read_header_information(alignment_short_reads_file, references_lengths);
@@ -66,18 +92,17 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
         int32_t const ref_id                = record.reference_id().value_or(-1);       // 3: RNAME
         int32_t const ref_pos               = record.reference_position().value_or(-1); // 4: POS
         uint8_t const mapq                  = record.mapping_quality();                 // 5: MAPQ
-        if (hasFlagUnmapped(flag) || hasFlagSecondary(flag) || hasFlagDuplicate(flag) || mapq < 20 ||
-            ref_id < 0 || ref_pos < 0)
+        if (!is_good_alignment(flag, ref_id, ref_pos, mapq))
             continue;
 
         for (detection_methods method : args.methods) {
             switch (method)
             {
                 case detection_methods::cigar_string: // Detect junctions from CIGAR string
-                    seqan3::debug_stream << "The cigar string method for short reads is not yet implemented.\n";
+                    thread_debug_stream << "The cigar string method for short reads is not yet implemented.\n";
                     break;
                 case detection_methods::split_read:     // Detect junctions from split read evidence (SA tag,
-                    seqan3::debug_stream << "The split read method for short reads is not yet implemented.\n";
+                    thread_debug_stream << "The split read method for short reads is not yet implemented.\n";
                     break;
                 case detection_methods::read_pairs: // Detect junctions from read pair evidence
                     if (hasFlagMultiple(flag))
@@ -86,7 +111,7 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
                     }
                     break;
                 case detection_methods::read_depth: // Detect junctions from read depth evidence
-                    seqan3::debug_stream << "The read depth method for short reads is not yet implemented.\n";
+                    thread_debug_stream << "The read depth method for short reads is not yet implemented.\n";
                     break;
             }
         }
@@ -94,16 +119,203 @@ void detect_junctions_in_short_reads_sam_file(std::vector<Junction> & junctions,
         num_good++;
         if (num_good % 1000 == 0)
         {
-            seqan3::debug_stream << num_good << " good alignments from short read file." << std::endl;
+            thread_debug_stream << num_good << " good alignments from short read file." << std::endl;
         }
     }
 }
 
-void detect_junctions_in_long_reads_sam_file(std::vector<Junction> & junctions,
-                                             std::map<std::string, int32_t> & references_lengths,
-                                             cmd_arguments const & args)
+void detect_junctions_in_long_read_alignment(std::string const & query_name,
+                                             seqan3::sam_flag const flag,
+                                             std::string const & ref_name,
+                                             int32_t const ref_pos,
+                                             uint8_t const mapq,
+                                             std::vector<seqan3::cigar> & cigar,
+                                             seqan3::dna5_vector const & seq,
+                                             std::string const & sa_tag,
+                                             cmd_arguments const & args,
+                                             std::vector<Junction> & junctions)
 {
-    // Open input alignment file
+    for (detection_methods method : args.methods) {
+        switch (method)
+        {
+            case detection_methods::cigar_string: // Detect junctions from CIGAR string
+                analyze_cigar(query_name,
+                              ref_name,
+                              ref_pos,
+                              cigar,
+                              seq,
+                              junctions,
+                              args.min_var_length);
+                break;
+            case detection_methods::split_read:     // Detect junctions from split read evidence (SA tag,
+                if (!hasFlagSupplementary(flag))    //                                  primary alignments only)
+                {
+                    if (!sa_tag.empty())
+                    {
+                        analyze_sa_tag(query_name,
+                                       flag,
+                                       ref_name,
+                                       ref_pos,
+                                       mapq,
+                                       cigar,
+                                       seq,
+                                       sa_tag,
+                                       args,
+                                       junctions);
+                    }
+                }
+                break;
+            case detection_methods::read_pairs: // There are no read pairs in long reads.
+                break;
+            case detection_methods::read_depth: // Detect junctions from read depth evidence
+                thread_debug_stream << "The read depth method for long reads is not yet implemented.\n";
+                break;
+        }
+    }
+}
+
+bam_record_fields required_long_read_fields(std::vector<detection_methods> const & methods)
+{
+    bam_record_fields fields{false, false, false};
+    for (detection_methods method : methods)
+    {
+        switch (method)
+        {
+            case detection_methods::cigar_string:   // CIGAR string and inserted bases
+                fields.cigar = true;
+                fields.sequence = true;
+                break;
+            case detection_methods::split_read:     // CIGAR string of the primary segment, SA tag and inserted bases
+                fields.cigar = true;
+                fields.sequence = true;
+                fields.sa_tag = true;
+                break;
+            default:                                // There are no read pairs in long reads, read depth is not yet
+                break;                              // implemented.
+        }
+    }
+    return fields;
+}
+
+bool needs_query_sequence(bam_record const & record, cmd_arguments const & args)
+{
+    using seqan3::get;
+    for (detection_methods method : args.methods)
+    {
+        switch (method)
+        {
+            case detection_methods::cigar_string:   // Insertions carry their inserted bases.
+                for (seqan3::cigar const & pair : record.cigar)
+                {
+                    if (get<1>(pair) == 'I'_cigar_operation &&
+                        static_cast<int32_t>(get<0>(pair)) >= args.min_var_length)
+                        return true;
+                }
+                break;
+            case detection_methods::split_read:     // Junctions between the segments of a split read carry the bases
+                                                    // between the segments.
+                if (!hasFlagSupplementary(static_cast<seqan3::sam_flag>(record.flag)) && !record.sa_tag.empty())
+                    return true;
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+// Decodes the fields of a good BAM record, which are needed by the detection methods. The sequence is only decoded if
+// it is used by one of the detection methods.
+void decode_good_long_read_record(bam_file_reader & reader,
+                                  bam_record & record,
+                                  bam_record_fields const fields,
+                                  cmd_arguments const & args)
+{
+    reader.decode_variable_fields(record, bam_record_fields{fields.cigar, false, fields.sa_tag});
+    if (hasFlagSupplementary(static_cast<seqan3::sam_flag>(record.flag)))
+        record.sa_tag.clear();
+    if (fields.sequence && needs_query_sequence(record, args))
+        reader.decode_sequence(record);
+}
+
+/* Reads a long read SAM/BAM file with seqan3::sam_file_input, which decodes exactly the fields in `fields_t`, see
+ * read_good_long_read_alignments().
+ */
+template <typename fields_t>
+bool read_good_long_read_alignments_with_fields(std::map<std::string, int32_t> & references_lengths,
+                                                cmd_arguments const & args,
+                                                auto && on_record)
+{
+    // Set number of decompression threads
+    seqan3::contrib::bgzf_thread_count = args.decompression_threads;
+    seqan3::sam_file_input alignment_long_reads_file{args.alignment_long_reads_file_path, fields_t{}};
+
+    std::deque<std::string> const ref_ids = read_header_information(alignment_long_reads_file, references_lengths);
+
+    for (auto & record : alignment_long_reads_file)
+    {
+        seqan3::sam_flag const flag         = record.flag();                            // 2: FLAG
+        int32_t const ref_id                = record.reference_id().value_or(-1);       // 3: RNAME
+        int32_t const ref_pos               = record.reference_position().value_or(-1); // 4: POS
+        uint8_t const mapq                  = record.mapping_quality();                 // 5: MAPQ
+        if (!is_good_alignment(flag, ref_id, ref_pos, mapq))
+            continue;
+
+        bam_record good_record{};
+        good_record.flag                    = static_cast<uint16_t>(flag);
+        good_record.ref_id                  = ref_id;
+        good_record.pos                     = ref_pos;
+        good_record.mapq                    = mapq;
+        good_record.read_name               = std::move(record.id());                   // 1: QNAME
+        good_record.cigar                   = std::move(record.cigar_sequence());       // 6: CIGAR
+        if constexpr (fields_t::contains(seqan3::field::seq))
+            good_record.sequence            = std::move(record.sequence());             // 10:SEQ
+        if constexpr (fields_t::contains(seqan3::field::tags))
+        {
+            if (!hasFlagSupplementary(flag))
+                good_record.sa_tag = record.tags().template get<"SA"_tag>();
+        }
+
+        if (!on_record(good_record, ref_ids))
+            return false;
+    }
+    return true;
+}
+
+/* Reads the long read alignment file and calls `on_record(record, ref_ids)` for each alignment, which passes the
+ * filters for unmapped, secondary and duplicate alignments and alignments with low mapping quality.
+ * The filters are checked on the fixed fields first. Only the fields needed by the selected detection methods are
+ * decoded, see required_long_read_fields(). In BAM files, the sequence is only decoded for the alignments which need
+ * it, see needs_query_sequence().
+ * Returns false if `on_record` requested to stop by returning false.
+ */
+bool read_good_long_read_alignments(std::map<std::string, int32_t> & references_lengths,
+                                    cmd_arguments const & args,
+                                    auto && on_record)
+{
+    bam_record_fields const fields = required_long_read_fields(args.methods);
+
+    // BAM files are decoded by our own reader, which decodes the variable fields of the filtered alignments only.
+    if (args.alignment_long_reads_file_path.extension() == ".bam")
+    {
+        bam_file_reader alignment_long_reads_file{args.alignment_long_reads_file_path,
+                                                  static_cast<size_t>(args.decompression_threads)};
+        std::deque<std::string> const ref_ids = read_header_information(alignment_long_reads_file,
+                                                                        references_lengths);
+        bam_record record{};
+        while (alignment_long_reads_file.read_fixed_fields(record))
+        {
+            if (!is_good_alignment(static_cast<seqan3::sam_flag>(record.flag), record.ref_id, record.pos, record.mapq))
+                continue;
+
+            decode_good_long_read_record(alignment_long_reads_file, record, fields, args);
+            if (!on_record(record, ref_ids))
+                return false;
+        }
+        return true;
+    }
+
+    // Open input alignment file, the SEQ field and the tags are only decoded if a detection method needs them.
     using my_fields = seqan3::fields<seqan3::field::id,         // 1: QNAME
                                      seqan3::field::flag,       // 2: FLAG
                                      seqan3::field::ref_id,     // 3: RNAME
@@ -112,73 +324,536 @@ void detect_junctions_in_long_reads_sam_file(std::vector<Junction> & junctions,
                                      seqan3::field::cigar,      // 6: CIGAR
                                      seqan3::field::seq,        // 10:SEQ
                                      seqan3::field::tags>;
+    using my_fields_without_tags = seqan3::fields<seqan3::field::id,
+                                                  seqan3::field::flag,
+                                                  seqan3::field::ref_id,
+                                                  seqan3::field::ref_offset,
+                                                  seqan3::field::mapq,
+                                                  seqan3::field::cigar,
+                                                  seqan3::field::seq>;
+    using my_fields_without_seq = seqan3::fields<seqan3::field::id,
+                                                 seqan3::field::flag,
+                                                 seqan3::field::ref_id,
+                                                 seqan3::field::ref_offset,
+                                                 seqan3::field::mapq,
+                                                 seqan3::field::cigar,
+                                                 seqan3::field::tags>;
+    using my_fields_without_seq_and_tags = seqan3::fields<seqan3::field::id,
+                                                          seqan3::field::flag,
+                                                          seqan3::field::ref_id,
+                                                          seqan3::field::ref_offset,
+                                                          seqan3::field::mapq,
+                                                          seqan3::field::cigar>;
 
-    // Set number of decompression threads
-    seqan3::contrib::bgzf_thread_count = args.threads;
-    seqan3::sam_file_input alignment_long_reads_file{args.alignment_long_reads_file_path, my_fields{}};
+    if (fields.sequence && fields.sa_tag)
+        return read_good_long_read_alignments_with_fields<my_fields>(references_lengths, args, on_record);
+    else if (fields.sequence)
+        return read_good_long_read_alignments_with_fields<my_fields_without_tags>(references_lengths, args, on_record);
+    else if (fields.sa_tag)
+        return read_good_long_read_alignments_with_fields<my_fields_without_seq>(references_lengths, args, on_record);
+    else
+        return read_good_long_read_alignments_with_fields<my_fields_without_seq_and_tags>(references_lengths,
+                                                                                          args,
+                                                                                          on_record);
+}
+
+// Runs the detection methods on one alignment record, see detect_junctions_in_long_read_alignment().
+void detect_junctions_in_long_read_record(bam_record & record,
+                                          std::deque<std::string> const & ref_ids,
+                                          cmd_arguments const & args,
+                                          std::vector<Junction> & junctions)
+{
+    detect_junctions_in_long_read_alignment(record.read_name,
+                                            static_cast<seqan3::sam_flag>(record.flag),
+                                            ref_ids[record.ref_id],
+                                            record.pos,
+                                            record.mapq,
+                                            record.cigar,
+                                            record.sequence,
+                                            record.sa_tag,
+                                            args,
+                                            junctions);
+}
+
+// Runs the detection methods of every set of detection parameters on one alignment record, the junctions of the set
+// detection_args[i] are appended to junctions[i].
+void detect_junctions_in_long_read_record(bam_record & record,
+                                          std::deque<std::string> const & ref_ids,
+                                          std::span<cmd_arguments const> const detection_args,
+                                          std::span<std::vector<Junction>> const junctions)
+{
+    for (size_t i = 0; i < detection_args.size(); ++i)
+        detect_junctions_in_long_read_record(record, ref_ids, detection_args[i], junctions[i]);
+}
+
+// The sets of detection parameters only differ in the minimum variant length and the maximum overlap, so the records
+// are decoded with the set which needs the most fields: the inserted bases are decoded for the smallest minimum
+// variant length.
+cmd_arguments const & record_decoding_args(std::span<cmd_arguments const> const detection_args)
+{
+    return *std::ranges::min_element(detection_args, {}, &cmd_arguments::min_var_length);
+}
+
+void detect_junctions_in_long_reads_in_batches(std::span<std::vector<Junction>> const junctions,
+                                               std::map<std::string, int32_t> & references_lengths,
+                                               std::span<cmd_arguments const> const detection_args,
+                                               size_t const batch_size = 1000);
+
+void detect_junctions_in_long_reads_bam_file_by_regions(std::span<std::vector<Junction>> const junctions,
+                                                        std::map<std::string, int32_t> & references_lengths,
+                                                        std::span<cmd_arguments const> const detection_args,
+                                                        std::filesystem::path const & index_path);
+
+void detect_junctions_in_long_reads_sam_file(std::vector<Junction> & junctions,
+                                             std::map<std::string, int32_t> & references_lengths,
+                                             cmd_arguments const & args)
+{
+    if (args.threads > 1)
+    {
+        // Indexed BAM files are split into regions, which are analyzed in parallel.
+        if (args.alignment_long_reads_file_path.extension() == ".bam")
+        {
+            std::filesystem::path const index_path = bam_index::find_index_file(args.alignment_long_reads_file_path);
+            if (!index_path.empty())
+            {
+                detect_junctions_in_long_reads_bam_file_by_regions(junctions, references_lengths, args, index_path);
+                return;
+            }
+        }
+        // Otherwise, the records are analyzed in batches in parallel.
+        detect_junctions_in_long_reads_in_batches(junctions, references_lengths, args);
+        return;
+    }
 
-    std::deque<std::string> const ref_ids = read_header_information(alignment_long_reads_file, references_lengths);
     uint32_t num_good = 0;
+    read_good_long_read_alignments(references_lengths, args, [&] (bam_record & record,
+                                                                  std::deque<std::string> const & ref_ids)
+    {
+        detect_junctions_in_long_read_record(record, ref_ids, args, junctions);
 
-    for (auto & record : alignment_long_reads_file)
+        num_good++;
+        if (num_good % 1000 == 0)
+        {
+            thread_debug_stream << num_good << " good alignments from long read file." << std::endl;
+        }
+        return true;
+    });
+}
+
+void detect_junctions_in_long_reads_sam_file(std::vector<std::vector<Junction>> & junctions,
+                                             std::map<std::string, int32_t> & references_lengths,
+                                             std::span<cmd_arguments const> const detection_args)
+{
+    junctions.resize(detection_args.size());
+    if (detection_args.empty())
+        return;
+
+    // The records are decoded with the arguments which need the most fields. The sets share the arguments of the
+    // input file and the threads.
+    cmd_arguments const & read_args = record_decoding_args(detection_args);
+    if (read_args.threads > 1)
     {
-        std::string const query_name        = record.id();                              // 1: QNAME
-        seqan3::sam_flag const flag         = record.flag();                            // 2: FLAG
-        int32_t const ref_id                = record.reference_id().value_or(-1);       // 3: RNAME
-        int32_t const ref_pos               = record.reference_position().value_or(-1); // 4: POS
-        uint8_t const mapq                  = record.mapping_quality();                 // 5: MAPQ
-        std::vector<seqan3::cigar> cigar    = record.cigar_sequence();                  // 6: CIGAR
-        seqan3::dna5_vector const seq       = record.sequence();                        // 10:SEQ
-        auto tags                           = record.tags();
+        // Indexed BAM files are split into regions, which are analyzed in parallel with every set of parameters.
+        if (read_args.alignment_long_reads_file_path.extension() == ".bam")
+        {
+            std::filesystem::path const index_path =
+                bam_index::find_index_file(read_args.alignment_long_reads_file_path);
+            if (!index_path.empty())
+            {
+                detect_junctions_in_long_reads_bam_file_by_regions(junctions,
+                                                                   references_lengths,
+                                                                   detection_args,
+                                                                   index_path);
+                return;
+            }
+        }
+        // Otherwise, the records are analyzed in batches in parallel.
+        detect_junctions_in_long_reads_in_batches(junctions, references_lengths, detection_args);
+        return;
+    }
 
-        if (hasFlagUnmapped(flag) || hasFlagSecondary(flag) || hasFlagDuplicate(flag) || mapq < 20 ||
-            ref_id < 0 || ref_pos < 0)
-            continue;
+    uint32_t num_good = 0;
+    read_good_long_read_alignments(references_lengths, read_args, [&] (bam_record & record,
+                                                                       std::deque<std::string> const & ref_ids)
+    {
+        detect_junctions_in_long_read_record(record, ref_ids, detection_args, junctions);
 
-        std::string const ref_name = ref_ids[ref_id];
-        for (detection_methods method : args.methods) {
-            switch (method)
+        num_good++;
+        if (num_good % 1000 == 0)
+        {
+            thread_debug_stream << num_good << " good alignments from long read file." << std::endl;
+        }
+        return true;
+    });
+}
+
+void detect_junctions_in_long_reads_sam_file(alignment_callback const & on_alignment,
+                                             std::map<std::string, int32_t> & references_lengths,
+                                             cmd_arguments const & args)
+{
+    std::vector<sequence_id_t> seq_ids{};
+    std::vector<Junction> record_junctions{};
+    uint32_t num_good = 0;
+    read_good_long_read_alignments(references_lengths, args, [&] (bam_record & record,
+                                                                  std::deque<std::string> const & ref_ids)
+    {
+        if (seq_ids.empty())
+        {
+            for (std::string const & ref_id : ref_ids)
+                seq_ids.push_back(intern_sequence_name(ref_id));
+        }
+
+        detect_junctions_in_long_read_record(record, ref_ids, args, record_junctions);
+        on_alignment(seq_ids[record.ref_id], record.pos, record_junctions);
+        record_junctions.clear();
+
+        num_good++;
+        if (num_good % 1000 == 0)
+        {
+            thread_debug_stream << num_good << " good alignments from long read file." << std::endl;
+        }
+        return true;
+    });
+}
+
+// A batch of consecutive good alignment records. `first_good` is the number of good records in front of the batch.
+struct long_read_batch
+{
+    size_t index;
+    uint32_t first_good;
+    std::vector<bam_record> records;
+};
+
+// Junctions and messages of a batch, stored in the buffer of the worker thread which analyzed the batch.
+struct long_read_batch_result
+{
+    size_t index;
+    std::vector<std::vector<Junction>> junctions;     // one vector per set of detection parameters
+    std::string messages;
+};
+
+void detect_junctions_in_long_reads_in_batches(std::vector<Junction> & junctions,
+                                               std::map<std::string, int32_t> & references_lengths,
+                                               cmd_arguments const & args,
+                                               size_t const batch_size)
+{
+    detect_junctions_in_long_reads_in_batches(std::span{&junctions, 1},
+                                              references_lengths,
+                                              std::span{&args, 1},
+                                              batch_size);
+}
+
+// Detects the junctions of every set of detection parameters in batches, see the function above.
+void detect_junctions_in_long_reads_in_batches(std::span<std::vector<Junction>> const junctions,
+                                               std::map<std::string, int32_t> & references_lengths,
+                                               std::span<cmd_arguments const> const detection_args,
+                                               size_t const batch_size)
+{
+    cmd_arguments const & read_args = record_decoding_args(detection_args);
+    size_t const num_workers = std::max<int16_t>(read_args.threads, 1);
+    // At most two batches per worker are waiting, which bounds the memory used for decoded records.
+    bounded_queue<long_read_batch> batches{2 * num_workers};
+    std::vector<std::vector<long_read_batch_result>> thread_results(num_workers);
+    std::deque<std::string> ref_ids{};
+    std::exception_ptr worker_exception{};
+    std::mutex exception_mutex{};
+
+    auto worker = [&] (std::vector<long_read_batch_result> & results)
+    {
+        std::ostringstream messages{};
+        thread_debug_stream.set_underlying_stream(messages);
+        try
+        {
+            while (std::optional<long_read_batch> batch = batches.pop())
             {
-                case detection_methods::cigar_string: // Detect junctions from CIGAR string
-                    analyze_cigar(query_name,
-                                  ref_name,
-                                  ref_pos,
-                                  cigar,
-                                  seq,
-                                  junctions,
-                                  args.min_var_length);
-                    break;
-                case detection_methods::split_read:     // Detect junctions from split read evidence (SA tag,
-                    if (!hasFlagSupplementary(flag))    //                                  primary alignments only)
+                long_read_batch_result result{batch->index, {}, {}};
+                result.junctions.resize(detection_args.size());
+                uint32_t num_good = batch->first_good;
+                for (bam_record & record : batch->records)
+                {
+                    detect_junctions_in_long_read_record(record, ref_ids, detection_args, result.junctions);
+
+                    num_good++;
+                    if (num_good % 1000 == 0)
                     {
-                        std::string const sa_tag = tags.get<"SA"_tag>();
-                        if (!sa_tag.empty())
-                        {
-                            analyze_sa_tag(query_name,
-                                           flag,
-                                           ref_name,
-                                           ref_pos,
-                                           mapq,
-                                           cigar,
-                                           seq,
-                                           sa_tag,
-                                           args,
-                                           junctions);
-                        }
+                        thread_debug_stream << num_good << " good alignments from long read file." << std::endl;
                     }
-                    break;
-                case detection_methods::read_pairs: // There are no read pairs in long reads.
-                    break;
-                case detection_methods::read_depth: // Detect junctions from read depth evidence
-                    seqan3::debug_stream << "The read depth method for long reads is not yet implemented.\n";
-                    break;
+                }
+                result.messages = messages.str();
+                messages.str("");
+                // Batches are taken in increasing order, so each buffer stays sorted by batch index.
+                results.push_back(std::move(result));
             }
         }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{exception_mutex};
+            if (!worker_exception)
+                worker_exception = std::current_exception();
+            batches.close();    // stop the reader and the other workers
+        }
+        thread_debug_stream.set_underlying_stream(std::cerr);
+    };
 
-        num_good++;
-        if (num_good % 1000 == 0)
+    // The reader runs in this thread and fills the queue. The workers are started as soon as the header is known.
+    std::vector<std::thread> workers{};
+    std::exception_ptr reader_exception{};
+    try
+    {
+        long_read_batch batch{0, 0, {}};
+        uint32_t num_good = 0;
+        bool const completed = read_good_long_read_alignments(references_lengths, read_args,
+                                                              [&] (bam_record & record,
+                                                                   std::deque<std::string> const & names)
+        {
+            if (workers.empty())
+            {
+                ref_ids = names;
+                for (size_t i = 0; i < num_workers; ++i)
+                    workers.emplace_back(worker, std::ref(thread_results[i]));
+            }
+
+            batch.records.push_back(std::move(record));
+            num_good++;
+            if (batch.records.size() < batch_size)
+                return true;
+            long_read_batch full_batch{batch.index, batch.first_good, std::move(batch.records)};
+            batch = long_read_batch{full_batch.index + 1, num_good, {}};
+            return batches.push(std::move(full_batch));
+        });
+        if (completed && !batch.records.empty())
+            batches.push(std::move(batch));
+    }
+    catch (...)
+    {
+        reader_exception = std::current_exception();
+    }
+    batches.close();
+    for (std::thread & thread : workers)
+        thread.join();
+
+    if (reader_exception)
+        std::rethrow_exception(reader_exception);
+    if (worker_exception)
+        std::rethrow_exception(worker_exception);
+
+    // k-way merge of the per-thread buffers by batch index restores the order of the input file.
+    using buffer_position = std::pair<size_t, size_t>; // (thread, position in its buffer)
+    auto later_batch = [&] (buffer_position const & lhs, buffer_position const & rhs)
+    {
+        return thread_results[lhs.first][lhs.second].index > thread_results[rhs.first][rhs.second].index;
+    };
+    std::priority_queue<buffer_position, std::vector<buffer_position>, decltype(later_batch)> heads{later_batch};
+    for (size_t t = 0; t < num_workers; ++t)
+    {
+        if (!thread_results[t].empty())
+            heads.emplace(t, 0);
+    }
+    while (!heads.empty())
+    {
+        auto [t, i] = heads.top();
+        heads.pop();
+        long_read_batch_result & result = thread_results[t][i];
+        thread_debug_stream << result.messages;
+        for (size_t k = 0; k < junctions.size(); ++k)
+        {
+            junctions[k].insert(junctions[k].end(),
+                                std::make_move_iterator(result.junctions[k].begin()),
+                                std::make_move_iterator(result.junctions[k].end()));
+        }
+        if (i + 1 < thread_results[t].size())
+            heads.emplace(t, i + 1);
+    }
+}
+
+// The junctions and messages of a region. The progress messages are added when the regions are merged, as the good
+// alignments are numbered across the regions.
+struct bam_region_result
+{
+    std::vector<std::vector<Junction>> junctions{};     // one vector per set of detection parameters
+    std::ostringstream messages{};
+    uint32_t num_good{0};
+    // Pairs (i, n): the first n characters of the messages were written up to the i-th good alignment of the region.
+    std::vector<std::pair<uint32_t, size_t>> message_ends{};
+};
+
+// Detects junctions in the alignments starting in the given region with every set of detection parameters.
+void detect_junctions_in_long_reads_bam_region(bam_file_reader & reader,
+                                               bam_region const & region,
+                                               std::deque<std::string> const & ref_ids,
+                                               std::span<cmd_arguments const> const detection_args,
+                                               bam_region_result & result)
+{
+    reader.seek(region.file_offset);
+    cmd_arguments const & read_args = record_decoding_args(detection_args);
+    bam_record_fields const fields = required_long_read_fields(read_args.methods);
+    result.junctions.resize(detection_args.size());
+    bam_record record{};
+    size_t messages_length = 0;
+
+    while (reader.read_fixed_fields(record))
+    {
+        // Alignments in front of the region belong to the previous region, the input is sorted by coordinate.
+        if (record.ref_id < region.ref_id || (record.ref_id == region.ref_id && record.pos < region.begin))
+            continue;
+        if (record.ref_id != region.ref_id || record.pos >= region.end)
+            break;
+
+        if (!is_good_alignment(static_cast<seqan3::sam_flag>(record.flag), record.ref_id, record.pos, record.mapq))
+            continue;
+
+        decode_good_long_read_record(reader, record, fields, read_args);
+        detect_junctions_in_long_read_record(record, ref_ids, detection_args, result.junctions);
+
+        // The messages of this alignment precede its progress message, which is added when the regions are merged.
+        ++result.num_good;
+        size_t const length = static_cast<size_t>(result.messages.tellp());
+        if (length != messages_length)
+        {
+            result.message_ends.emplace_back(result.num_good, length);
+            messages_length = length;
+        }
+    }
+}
+
+// Detects junctions in the given regions in parallel, with every set of detection parameters. The junctions and
+// messages are merged in region order. `num_good` is the number of good alignments in front of the regions, it is
+// increased by the ones in the regions.
+void detect_junctions_in_long_reads_bam_regions(std::span<bam_region const> const regions,
+                                                std::deque<std::string> const & ref_ids,
+                                                std::span<cmd_arguments const> const detection_args,
+                                                std::span<std::vector<Junction>> const junctions,
+                                                uint32_t & num_good)
+{
+    cmd_arguments const & read_args = record_decoding_args(detection_args);
+    // Each region collects its own junctions and messages, which are merged in region order afterwards. Thus, the
+    // result is identical to a serial run over the regions.
+    std::vector<bam_region_result> results(regions.size());
+    std::atomic<size_t> next_region{0};
+    std::exception_ptr worker_exception{};
+    std::mutex exception_mutex{};
+
+    auto worker = [&] ()
+    {
+        try
+        {
+            bam_file_reader reader{read_args.alignment_long_reads_file_path};
+            for (size_t i = next_region++; i < regions.size(); i = next_region++)
+            {
+                thread_debug_stream.set_underlying_stream(results[i].messages);
+                detect_junctions_in_long_reads_bam_region(reader, regions[i], ref_ids, detection_args, results[i]);
+            }
+        }
+        catch (...)
         {
-            seqan3::debug_stream << num_good << " good alignments from long read file." << std::endl;
+            std::lock_guard<std::mutex> lock{exception_mutex};
+            if (!worker_exception)
+                worker_exception = std::current_exception();
+            next_region = regions.size();   // stop the other workers
         }
+        thread_debug_stream.set_underlying_stream(std::cerr);
+    };
+
+    size_t const num_workers = std::min<size_t>(read_args.threads, regions.size());
+    std::vector<std::thread> workers{};
+    for (size_t i = 0; i < num_workers; ++i)
+        workers.emplace_back(worker);
+    for (std::thread & thread : workers)
+        thread.join();
+
+    if (worker_exception)
+        std::rethrow_exception(worker_exception);
+
+    for (bam_region_result & result : results)
+    {
+        // The progress messages continue the numbering of the previous regions, like in a serial run.
+        std::string const messages = result.messages.str();
+        size_t num_written = 0;
+        auto message_end = result.message_ends.begin();
+        for (uint32_t i = 1000 - num_good % 1000; i <= result.num_good; i += 1000)
+        {
+            size_t end = num_written;
+            for (; message_end != result.message_ends.end() && message_end->first <= i; ++message_end)
+                end = message_end->second;
+            thread_debug_stream << messages.substr(num_written, end - num_written);
+            num_written = end;
+            thread_debug_stream << num_good + i << " good alignments from long read file." << std::endl;
+        }
+        thread_debug_stream << messages.substr(num_written);
+        num_good += result.num_good;
+
+        for (size_t k = 0; k < result.junctions.size(); ++k)
+        {
+            junctions[k].insert(junctions[k].end(),
+                                std::make_move_iterator(result.junctions[k].begin()),
+                                std::make_move_iterator(result.junctions[k].end()));
+        }
+    }
+}
+
+// Reads the header of a long read BAM file and splits its reference sequences into regions with the index.
+std::vector<bam_region> read_long_reads_bam_regions(std::deque<std::string> & ref_ids,
+                                                    std::map<std::string, int32_t> & references_lengths,
+                                                    cmd_arguments const & args,
+                                                    std::filesystem::path const & index_path)
+{
+    bam_file_reader header_reader{args.alignment_long_reads_file_path};
+    ref_ids = read_header_information(header_reader, references_lengths);
+
+    std::vector<int32_t> ref_lengths{};
+    for (auto const & info : header_reader.header().ref_id_info)
+        ref_lengths.push_back(std::get<0>(info));
+    return bam_index{index_path}.split_into_regions(ref_lengths, args.region_size);
+}
+
+void detect_junctions_in_long_reads_bam_file_by_regions(std::vector<Junction> & junctions,
+                                                        std::map<std::string, int32_t> & references_lengths,
+                                                        cmd_arguments const & args,
+                                                        std::filesystem::path const & index_path)
+{
+    detect_junctions_in_long_reads_bam_file_by_regions(std::span{&junctions, 1},
+                                                       references_lengths,
+                                                       std::span{&args, 1},
+                                                       index_path);
+}
+
+// Detects the junctions of every set of detection parameters region by region, see the function above.
+void detect_junctions_in_long_reads_bam_file_by_regions(std::span<std::vector<Junction>> const junctions,
+                                                        std::map<std::string, int32_t> & references_lengths,
+                                                        std::span<cmd_arguments const> const detection_args,
+                                                        std::filesystem::path const & index_path)
+{
+    cmd_arguments const & read_args = record_decoding_args(detection_args);
+    std::deque<std::string> ref_ids{};
+    std::vector<bam_region> const regions = read_long_reads_bam_regions(ref_ids,
+                                                                        references_lengths,
+                                                                        read_args,
+                                                                        index_path);
+    uint32_t num_good = 0;
+    detect_junctions_in_long_reads_bam_regions(regions, ref_ids, detection_args, junctions, num_good);
+}
+
+void detect_junctions_in_long_reads_bam_file_by_chromosome(std::map<std::string, int32_t> & references_lengths,
+                                                           cmd_arguments const & args,
+                                                           std::filesystem::path const & index_path,
+                                                           chromosome_callback const & on_chromosome)
+{
+    std::deque<std::string> ref_ids{};
+    std::vector<bam_region> const regions = read_long_reads_bam_regions(ref_ids, references_lengths, args, index_path);
+
+    // The regions are sorted by reference sequence, the regions of each reference sequence are analyzed together.
+    std::vector<Junction> junctions{};
+    uint32_t num_good = 0;
+    for (size_t begin = 0, end = 0; begin < regions.size(); begin = end)
+    {
+        while (end < regions.size() && regions[end].ref_id == regions[begin].ref_id)
+            ++end;
+        detect_junctions_in_long_reads_bam_regions(std::span{regions}.subspan(begin, end - begin),
+                                                   ref_ids,
+                                                   std::span{&args, 1},
+                                                   std::span{&junctions, 1},
+                                                   num_good);
+        on_chromosome(intern_sequence_name(ref_ids[regions[begin].ref_id]), junctions);
+        junctions.clear();
     }
 }
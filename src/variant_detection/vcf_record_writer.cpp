@@ -0,0 +1,70 @@
+#include "variant_detection/vcf_record_writer.hpp"
+
+#include <charconv>     // for std::to_chars
+#include <cstring>      // for std::memcpy
+
+namespace
+{
+// Appends the characters of `text` at `out` and returns the end of the characters.
+inline char * append(char * out, std::string_view const text)
+{
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
+// Maximal number of characters of a record besides the sequence name and the SV type (twice): the numbers, the
+// separators and the constant fields.
+constexpr size_t max_fixed_record_size = 160;
+} // namespace
+
+vcf_record_writer::vcf_record_writer(std::ostream & the_out_stream, size_t const buffer_size) :
+    out_stream{the_out_stream},
+    buffer(buffer_size)
+{}
+
+vcf_record_writer::~vcf_record_writer()
+{
+    flush();
+}
+
+void vcf_record_writer::write_record(std::string_view const chrom,
+                                     uint64_t const pos,
+                                     std::string_view const sv_type,
+                                     float const qual,
+                                     int32_t const end,
+                                     int32_t const sv_len)
+{
+    size_t const max_record_size = chrom.size() + 2 * sv_type.size() + max_fixed_record_size;
+    if (buffer_used + max_record_size > buffer.size())
+    {
+        flush();
+        if (max_record_size > buffer.size())
+            buffer.resize(max_record_size);
+    }
+
+    char * out = buffer.data() + buffer_used;
+    char * const buffer_end = buffer.data() + buffer.size();
+    out = append(out, chrom);
+    *out++ = '\t';
+    out = std::to_chars(out, buffer_end, pos).ptr;
+    out = append(out, "\t.\tN\t<");
+    out = append(out, sv_type);
+    out = append(out, ">\t");
+    // A std::ostream prints a float with the general format and a precision of 6 by default, like printf("%g").
+    out = std::to_chars(out, buffer_end, static_cast<double>(qual), std::chars_format::general, 6).ptr;
+    out = append(out, "\tPASS\tEND=");
+    out = std::to_chars(out, buffer_end, end).ptr;
+    out = append(out, ";SVLEN=");
+    out = std::to_chars(out, buffer_end, sv_len).ptr;
+    out = append(out, ";SVTYPE=");
+    out = append(out, sv_type);
+    out = append(out, "\tGT\t./.\n");
+    buffer_used = out - buffer.data();
+}
+
+void vcf_record_writer::flush()
+{
+    if (buffer_used > 0)
+        out_stream.write(buffer.data(), buffer_used);
+    buffer_used = 0;
+}
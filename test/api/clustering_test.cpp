@@ -1,8 +1,23 @@
 #include <gtest/gtest.h>
 
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+
 #include "modules/clustering/simple_clustering_method.hpp"          // for the simple clustering method
+#include "fastcluster.h"                                            // for hclust_fast, the reference implementation
+#include "modules/clustering/average_linkage.hpp"                   // for average_linkage, cut_dendrogram
+#include "modules/clustering/distance_kernel.hpp"                   // for condensed_distances
 #include "modules/clustering/hierarchical_clustering_method.hpp"    // for the hierarchical clustering method
+#include "modules/clustering/junction_compaction.hpp"               // for compact_junctions
+#include "modules/clustering/sparse_average_linkage.hpp"            // for sparse_average_linkage
 #include "structures/cluster.hpp"                                   // for class Cluster
+#include "structures/junction_sort.hpp"                             // for sort_junctions()
+#include "variant_detection/cluster_checkpoint.hpp"                 // for write_cluster_checkpoint()
+#include "variant_detection/contig_pair_buffer.hpp"                 // for class contig_pair_buffer
+#include "variant_detection/external_junction_sorter.hpp"           // for class external_junction_sorter
+#include "variant_detection/junction_window.hpp"                    // for class junction_window
 
 using seqan3::operator""_dna5;
 
@@ -144,7 +159,7 @@ TEST(simple_clustering, empty_junction_vector)
 TEST(hierarchical_clustering, partitioning)
 {
     std::vector<Junction> input_junctions = prepare_input_junctions();
-    std::vector<std::vector<Junction>> partitions = partition_junctions(input_junctions);
+    std::vector<std::span<Junction>> partitions = partition_junctions(input_junctions);
 
     std::vector<std::vector<Junction>> expected_partitions
     {
@@ -429,38 +444,812 @@ TEST(hierarchical_clustering, clustering_25)
     }
 }
 
-TEST(hierarchical_clustering, subsampling)
+TEST(hierarchical_clustering, large_partition)
 {
+    // One partition of groups of 1 to 5 junctions every 14bp. The members of a group are at most 8 apart from each
+    // other and at least 11 apart from the members of other groups, so the clusters do not depend on the order of
+    // merges with equal distances.
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<int32_t> offset{0, 2};
     std::vector<Junction> input_junctions;
-    for (int32_t i = 0; i < 300; ++i)
+    for (int32_t group = 0; group < 100; ++group)
     {
-        input_junctions.emplace_back(Breakend{chrom1,
-                                              chrom1_position1 + i,
-                                              strand::forward},
-                                     Breakend{chrom2,
-                                              chrom2_position1 + i,
-                                              strand::forward},
-                                     ""_dna5,
-                                     read_name_1);
+        for (int32_t k = 0; k <= group % 5; ++k)
+        {
+            int32_t const mate2_position = chrom2_position1 + 14 * group + offset(generator);
+            int32_t const inserted_size = offset(generator) + k % 2;
+            input_junctions.emplace_back(Breakend{chrom1, chrom1_position1 + 14 * group + k % 4, strand::forward},
+                                         Breakend{chrom2, mate2_position, strand::forward},
+                                         seqan3::dna5_vector(inserted_size),
+                                         read_name_1);
+        }
     }
     std::sort(input_junctions.begin(), input_junctions.end());
-    
+    // More than 200 distinct junctions, so the partition is clustered by sparse_average_linkage().
+    ASSERT_GT(compact_junctions(input_junctions).size(), 200u);
+
+    // Reference: average linkage of all junctions with the full distance matrix.
+    average_linkage_buffers buffers{};
+    for (size_t i = 0; i < input_junctions.size(); ++i)
+        for (size_t j = i + 1; j < input_junctions.size(); ++j)
+            buffers.distances.push_back(junction_distance(input_junctions[i], input_junctions[j]));
+    average_linkage(input_junctions.size(), 10, buffers);
+    std::map<int, std::vector<Junction>> label_to_junctions{};
+    for (size_t i = 0; i < input_junctions.size(); ++i)
+        label_to_junctions[buffers.labels[i]].push_back(input_junctions[i]);
+    std::vector<Cluster> expected_clusters{};
+    for (auto & [label, members] : label_to_junctions)
+        expected_clusters.emplace_back(std::move(members));
+    std::sort(expected_clusters.begin(), expected_clusters.end());
+    ASSERT_EQ(expected_clusters.size(), 100);
+
     testing::internal::CaptureStderr();
-    std::vector<Cluster> clusters = hierarchical_clustering_method(input_junctions, 0);
+    std::vector<Cluster> const clusters = hierarchical_clustering_method(input_junctions, 10);
+
+    ASSERT_EQ(expected_clusters.size(), clusters.size());
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        EXPECT_EQ(expected_clusters[i].get_members(), clusters[i].get_members())
+            << "Cluster " << i << " different than expected";
+    }
+
+    std::string result_err = testing::internal::GetCapturedStderr();
+    EXPECT_EQ("", result_err);
+}
+
+TEST(hierarchical_clustering, parallel_clustering)
+{
+    // Partitions of 1 to 250 junctions, with random offsets and inserted sequence sizes.
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<int32_t> partition_size{1, 250};
+    std::uniform_int_distribution<int32_t> offset{0, 40};
+    std::vector<Junction> input_junctions;
+    for (int32_t partition = 0; partition < 60; ++partition)
+    {
+        int32_t const size = partition_size(generator);
+        for (int32_t i = 0; i < size; ++i)
+        {
+            input_junctions.emplace_back(Breakend{(partition % 2) ? chrom1 : chrom2,
+                                                  chrom2_position1 + 10000 * partition + offset(generator),
+                                                  strand::forward},
+                                         Breakend{chrom2,
+                                                  chrom1_position1 + offset(generator),
+                                                  (partition % 3) ? strand::forward : strand::reverse},
+                                         seqan3::dna5_vector(offset(generator)),
+                                         read_name_1);
+        }
+    }
+    std::sort(input_junctions.begin(), input_junctions.end());
+
+    std::vector<Cluster> const expected_clusters = hierarchical_clustering_method(input_junctions, 10, 1);
+    for (size_t threads : {2, 4, 8})
+    {
+        std::vector<Cluster> const clusters = hierarchical_clustering_method(input_junctions, 10, threads);
+        ASSERT_EQ(expected_clusters.size(), clusters.size()) << "with " << threads << " threads";
+        for (size_t i = 0; i < clusters.size(); ++i)
+        {
+            EXPECT_EQ(expected_clusters[i].get_members(), clusters[i].get_members())
+                << "Cluster " << i << " unequal with " << threads << " threads";
+        }
+    }
+}
 
-    size_t num_junctions = 0;
+TEST(hierarchical_clustering, average_linkage)
+{
+    // Random distances without ties, so that the order of the merges is unique.
+    std::mt19937 generator{1234};
+    std::uniform_real_distribution<double> random_distance{0, 100};
+    average_linkage_buffers buffers{};
+    for (size_t num_objects : {2, 3, 10, 50, 200})
+    {
+        for (double clustering_cutoff : {0.0, 10.0, 30.0, 1000.0})
+        {
+            std::vector<double> distances(num_objects * (num_objects - 1) / 2);
+            std::generate(distances.begin(), distances.end(), [&] () { return random_distance(generator); });
+
+            std::vector<double> reference_distances = distances;
+            std::vector<int> merge(2 * (num_objects - 1));
+            std::vector<double> height(num_objects - 1);
+            std::vector<int> expected_labels(num_objects);
+            hclust_fast(num_objects, reference_distances.data(), HCLUST_METHOD_AVERAGE, merge.data(), height.data());
+            cutree_cdist(num_objects, merge.data(), height.data(), clustering_cutoff, expected_labels.data());
+
+            buffers.distances = distances;
+            average_linkage(num_objects, clustering_cutoff, buffers);
+
+            // The same partition of the objects, possibly with other label numbers.
+            std::map<int, int> label_mapping{};
+            for (size_t i = 0; i < num_objects; ++i)
+            {
+                auto const [it, inserted] = label_mapping.emplace(expected_labels[i], buffers.labels[i]);
+                EXPECT_EQ(it->second, buffers.labels[i]) << "Object " << i << " with " << num_objects
+                                                         << " objects and cutoff " << clustering_cutoff;
+            }
+            EXPECT_EQ(label_mapping.size(), std::set<int>(buffers.labels.begin(), buffers.labels.end()).size());
+
+            // Only the merges below the cutoff, with the same heights.
+            size_t const num_merges = std::ranges::count_if(height, [&] (double h) { return h < clustering_cutoff; });
+            ASSERT_EQ(num_merges, buffers.merges.size());
+            for (size_t i = 0; i < num_merges; ++i)
+                EXPECT_NEAR(height[i], buffers.merges[i].height, 1e-9);
+        }
+    }
+}
+
+TEST(hierarchical_clustering, distance_kernels)
+{
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<int32_t> offset{-1000, 1000};
+    std::uniform_int_distribution<size_t> insertion_length{0, 500};
+    // Sizes with and without a remainder for the vectorized kernels.
+    for (size_t num_junctions : {0, 1, 2, 7, 8, 9, 33, 200})
+    {
+        std::vector<Junction> partition{};
+        for (size_t i = 0; i < num_junctions; ++i)
+        {
+            partition.emplace_back(Breakend{chrom1, chrom1_position1 + offset(generator), strand::forward},
+                                   Breakend{chrom2, chrom2_position1 + offset(generator), strand::reverse},
+                                   seqan3::dna5_vector(insertion_length(generator)),
+                                   read_name_1);
+        }
+        std::vector<double> expected_distances{};
+        for (size_t i = 0; i < num_junctions; ++i)
+            for (size_t j = i + 1; j < num_junctions; ++j)
+                expected_distances.push_back(junction_distance(partition[i], partition[j]));
+
+        junction_coordinates coordinates{};
+        load_coordinates(partition, coordinates);
+        std::vector<double> distances{};
+        for (distance_kernel kernel : {distance_kernel::scalar, distance_kernel::sse2, distance_kernel::avx2})
+        {
+            if (kernel > best_distance_kernel())
+                continue; // not supported by the CPU
+            condensed_distances(coordinates, distances, kernel);
+            EXPECT_EQ(expected_distances, distances) << "Kernel " << static_cast<int>(kernel) << " with "
+                                                     << num_junctions << " junctions";
+        }
+    }
+}
+
+TEST(hierarchical_clustering, sparse_average_linkage)
+{
+    // Groups of junctions around every 40th position, whose members are at most 8 apart from each other.
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<int32_t> offset{0, 2};
+    std::vector<Junction> input_junctions;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        int32_t const group = i % 50;
+        input_junctions.emplace_back(Breakend{chrom1, chrom1_position1 + 40 * group + offset(generator), strand::forward},
+                                     Breakend{chrom1, chrom1_position2 + 40 * group + offset(generator), strand::forward},
+                                     seqan3::dna5_vector(offset(generator) + 2 * (i % 3 == 0)),
+                                     read_name_1);
+    }
+    std::sort(input_junctions.begin(), input_junctions.end());
+
+    // One partition of 1000 junctions, clustered without the full distance matrix.
+    std::vector<Cluster> const clusters = hierarchical_clustering_method(input_junctions, 10);
+    ASSERT_EQ(clusters.size(), 50);
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        EXPECT_EQ(clusters[i].get_cluster_size(), 20);
+        EXPECT_EQ(clusters[i].get_members().front().get_mate1().position / 40,
+                  clusters[i].get_members().back().get_mate1().position / 40) << "Cluster " << i << " mixes groups";
+    }
+
+    // Small partitions are clustered with the full distance matrix, with the same result.
+    std::vector<Junction> const small_partition(input_junctions.begin(), input_junctions.begin() + 100);
+    std::vector<int> const labels = sparse_average_linkage(small_partition, 10);
+    std::vector<Cluster> const small_clusters = hierarchical_clustering_method(small_partition, 10);
+    ASSERT_EQ(small_clusters.size(), 5);
+    for (size_t i = 0; i < small_partition.size(); ++i)
+        EXPECT_EQ(labels[i], i / 20) << "Junction " << i << " in an unexpected cluster";
+    for (size_t i = 0; i < small_clusters.size(); ++i)
+    {
+        EXPECT_TRUE(std::ranges::equal(small_clusters[i].get_members(),
+                                       std::span{small_partition}.subspan(20 * i, 20)));
+    }
+}
+
+TEST(hierarchical_clustering, junction_compaction)
+{
+    // 60 distinct junctions, each of them detected in 5 reads with different inserted sequences of the same size.
+    std::vector<Junction> junctions{};
+    for (int32_t i = 0; i < 300; ++i)
+    {
+        int32_t const locus = i % 60;
+        junctions.emplace_back(Breakend{chrom1, chrom1_position1 + 3 * (locus % 20), strand::forward},
+                               Breakend{chrom1, chrom1_position2 + locus / 20, strand::forward},
+                               seqan3::dna5_vector(locus % 4, (i % 2) ? 'A'_dna5 : 'C'_dna5),
+                               "read_" + std::to_string(i));
+    }
+    compacted_junctions const compacted = compact_junctions(junctions);
+    ASSERT_EQ(compacted.size(), 60);
+    for (size_t i = 0; i < compacted.size(); ++i)
+    {
+        EXPECT_EQ(compacted.weight(i), 5);
+        Junction const & representative = junctions[compacted.representative(i)];
+        std::span<uint32_t const> const members = compacted.members_of(i);
+        EXPECT_TRUE(std::ranges::is_sorted(members));
+        for (uint32_t const member : members)
+        {
+            EXPECT_EQ(junction_distance(representative, junctions[member]), 0);
+            EXPECT_EQ(junctions[member].get_read_name(), "read_" + std::to_string(member));
+        }
+        if (i > 0)
+            EXPECT_TRUE(junctions[compacted.representative(i - 1)] < representative);
+    }
+
+    // With a tolerance of 1, the junctions with neighboring second mates or inserted sizes are collapsed as well.
+    compacted_junctions const tolerant = compact_junctions(junctions, 1);
+    EXPECT_LT(tolerant.size(), compacted.size());
+    EXPECT_EQ(tolerant.members.size(), junctions.size());
+    for (size_t i = 0; i < tolerant.size(); ++i)
+    {
+        for (uint32_t const member : tolerant.members_of(i))
+            EXPECT_LE(junction_distance(junctions[tolerant.representative(i)], junctions[member]), 3);
+    }
+
+    // The clusters of the weighted junctions are the ones of all junctions, with the sizes and averages of all members.
+    std::sort(junctions.begin(), junctions.end());
+    std::vector<Cluster> const clusters = hierarchical_clustering_method(junctions, 4);
+    size_t num_members = 0;
     for (Cluster const & cluster : clusters)
     {
-        num_junctions += cluster.get_cluster_size();
+        EXPECT_EQ(cluster.get_cluster_size(), cluster.get_members().size());
+        EXPECT_EQ(cluster.get_cluster_size() % 5, 0);
+        EXPECT_EQ(Cluster{cluster.get_members()}.get_average_mate1(), cluster.get_average_mate1());
+        num_members += cluster.get_cluster_size();
     }
-    EXPECT_EQ(num_junctions, 200);
-    
-    std::string const expected_err
+    EXPECT_EQ(num_members, junctions.size());
+}
+
+TEST(hierarchical_clustering, weighted_average_linkage)
+{
+    // Objects of weight k give the same clusters as k copies of the object at distance 0.
+    std::mt19937 generator{1234};
+    std::uniform_real_distribution<double> random_distance{1, 100};
+    std::uniform_int_distribution<uint32_t> random_weight{1, 4};
+    size_t const num_objects = 40;
+    std::vector<double> distances(num_objects * (num_objects - 1) / 2);
+    std::generate(distances.begin(), distances.end(), [&] () { return random_distance(generator); });
+    std::vector<uint32_t> weights(num_objects);
+    std::generate(weights.begin(), weights.end(), [&] () { return random_weight(generator); });
+
+    std::vector<size_t> copies{};
+    for (size_t i = 0; i < num_objects; ++i)
+        copies.insert(copies.end(), weights[i], i);
+    auto const distance = [&] (size_t const i, size_t const j)
     {
-        "A partition exceeds the maximum size (300>200) and has to be subsampled. "
-        "Representative partition member:\n"
-        "[chr1\t12323443\tForward] -> [chr2\t234432\tForward]\n"
+        if (i == j)
+            return 0.0;
+        size_t const a = std::min(i, j), b = std::max(i, j);
+        return distances[num_objects * a - a * (a + 1) / 2 + b - a - 1];
     };
-    std::string result_err = testing::internal::GetCapturedStderr();
-    EXPECT_EQ(expected_err, result_err);
+    std::vector<double> copy_distances{};
+    for (size_t i = 0; i < copies.size(); ++i)
+        for (size_t j = i + 1; j < copies.size(); ++j)
+            copy_distances.push_back(distance(copies[i], copies[j]));
+
+    for (double clustering_cutoff : {10.0, 30.0, 60.0})
+    {
+        average_linkage_buffers buffers{};
+        buffers.distances = copy_distances;
+        average_linkage(copies.size(), clustering_cutoff, buffers);
+        std::vector<int> const expected_labels = buffers.labels;
+
+        buffers.distances = distances;
+        average_linkage(num_objects, clustering_cutoff, buffers, weights);
+
+        // The same partition of the objects, possibly with other label numbers.
+        std::map<int, int> label_mapping{};
+        for (size_t i = 0; i < copies.size(); ++i)
+        {
+            auto const [it, inserted] = label_mapping.emplace(expected_labels[i], buffers.labels[copies[i]]);
+            EXPECT_EQ(it->second, buffers.labels[copies[i]]) << "Copy " << i << " with cutoff " << clustering_cutoff;
+        }
+        EXPECT_EQ(label_mapping.size(), std::set<int>(buffers.labels.begin(), buffers.labels.end()).size());
+    }
+}
+
+TEST(hierarchical_clustering, several_cutoffs)
+{
+    // A large partition of groups around every 40th position, clustered without the full distance matrix, whose
+    // members are at most 8 apart from each other.
+    std::mt19937 generator{1234};
+    std::uniform_int_distribution<int32_t> offset{0, 2};
+    std::vector<Junction> input_junctions;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+        int32_t const group = i % 50;
+        input_junctions.emplace_back(Breakend{chrom1, chrom1_position1 + 40 * group + offset(generator), strand::forward},
+                                     Breakend{chrom1, chrom1_position2 + 40 * group + offset(generator), strand::forward},
+                                     seqan3::dna5_vector(offset(generator) + 2 * (i % 3 == 0)),
+                                     read_name_1);
+    }
+    // Small partitions of two groups each, about 20 apart, clustered with the full distance matrix.
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        int32_t const position = chrom2_position1 + 1000 * (i % 5) + 20 * (i % 2);
+        input_junctions.emplace_back(Breakend{chrom2, position + offset(generator) / 2, strand::forward},
+                                     Breakend{chrom2, position + 5000 + offset(generator) / 2, strand::forward},
+                                     seqan3::dna5_vector{},
+                                     read_name_2);
+    }
+    std::sort(input_junctions.begin(), input_junctions.end());
+
+    // The dendrogram of each partition is cut at every cutoff, with the same clusters as clustering at each cutoff.
+    std::vector<double> const clustering_cutoffs{10, 0, 30, 60, 10};
+    std::vector<std::vector<Cluster>> const clusters = hierarchical_clustering_method(input_junctions,
+                                                                                      clustering_cutoffs,
+                                                                                      2);
+    ASSERT_EQ(clusters.size(), clustering_cutoffs.size());
+    std::vector<size_t> const expected_num_clusters{60, 1100, 55, 55, 60};
+    for (size_t k = 0; k < clustering_cutoffs.size(); ++k)
+    {
+        EXPECT_EQ(clusters[k].size(), expected_num_clusters[k]) << "Cutoff " << clustering_cutoffs[k];
+        EXPECT_EQ(clusters[k], hierarchical_clustering_method(input_junctions, clustering_cutoffs[k]))
+            << "Cutoff " << clustering_cutoffs[k];
+    }
+    EXPECT_TRUE(hierarchical_clustering_method(input_junctions, std::vector<double>{}).empty());
+
+    // Cutting a dendrogram of merges in any order.
+    std::vector<linkage_merge> const merges{{3, 4, 2.0}, {0, 1, 1.0}, {1, 3, 5.0}, {2, 0, 3.0}};
+    EXPECT_EQ(cut_dendrogram(6, merges, 1.0), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(cut_dendrogram(6, merges, 2.5), (std::vector<int>{0, 0, 1, 2, 2, 3}));
+    EXPECT_EQ(cut_dendrogram(6, merges, 4.0), (std::vector<int>{0, 0, 0, 1, 1, 2}));
+    EXPECT_EQ(cut_dendrogram(6, merges, 6.0), (std::vector<int>{0, 0, 0, 0, 0, 1}));
+}
+
+TEST(hierarchical_clustering, junction_window)
+{
+    // Alignments on chrom2 followed by alignments on chrom1, as in a BAM file whose sequences are not sorted by name.
+    // Each alignment adds junctions around its position, and on chrom2 also translocations to chrom1, whose first mate
+    // lies on chrom1 and waits in the side store.
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{-1000, 300};
+    std::uniform_int_distribution<int32_t> num_junctions{0, 3};
+    std::vector<Junction> all_junctions{};
+    std::vector<std::vector<Junction>> batches{};
+    junction_window window{1000, [&] (std::vector<Junction> & batch) { batches.push_back(batch); }};
+    for (std::string const & chrom : {chrom2, chrom1})
+    {
+        for (int32_t position = 1000; position < 1000000; position += 100)
+        {
+            window.advance(intern_sequence_name(chrom), position);
+            for (int32_t i = num_junctions(generator); i > 0; --i)
+            {
+                int32_t const mate1_position = position + offset(generator);
+                all_junctions.emplace_back(Breakend{chrom, mate1_position, (i % 2) ? strand::forward : strand::reverse},
+                                           Breakend{(position % 5000) ? chrom : chrom1,
+                                                    mate1_position + 500 + offset(generator) / 100,
+                                                    strand::forward},
+                                           seqan3::dna5_vector(i),
+                                           read_name_1);
+                window.add(all_junctions.back());
+            }
+        }
+    }
+    EXPECT_THROW(window.advance(intern_sequence_name(chrom2), 1000000), std::runtime_error);
+
+    // A junction on chrom2, which was released already, is late.
+    Junction const late_junction{Breakend{chrom2, 2000, strand::forward}, Breakend{chrom2, 3000, strand::forward},
+                                 ""_dna5, read_name_2};
+    window.add(late_junction);
+    window.finish();
+    EXPECT_EQ(window.num_late_junctions(), 1);
+    ASSERT_GT(batches.size(), 2);
+    EXPECT_EQ(batches.back(), std::vector<Junction>{late_junction});
+    batches.pop_back();
+
+    // The batches are sorted and never split a partition, so clustering them separately gives the same result as
+    // clustering all junctions at once.
+    std::vector<std::vector<Junction>> partitions{};
+    std::vector<Cluster> clusters{};
+    for (std::vector<Junction> & batch : batches)
+    {
+        EXPECT_TRUE(std::is_sorted(batch.begin(), batch.end()));
+        for (std::span<Junction> const partition : partition_junctions(batch))
+            partitions.emplace_back(partition.begin(), partition.end());
+        std::vector<Cluster> const batch_clusters = hierarchical_clustering_method(batch, 10);
+        clusters.insert(clusters.end(), batch_clusters.begin(), batch_clusters.end());
+    }
+    std::sort(all_junctions.begin(), all_junctions.end());
+    std::vector<std::vector<Junction>> expected_partitions{};
+    for (std::span<Junction> const partition : partition_junctions(all_junctions))
+        expected_partitions.emplace_back(partition.begin(), partition.end());
+    std::sort(partitions.begin(), partitions.end());
+    std::sort(expected_partitions.begin(), expected_partitions.end());
+    EXPECT_TRUE(partitions == expected_partitions);
+
+    std::sort(clusters.begin(), clusters.end());
+    std::vector<Cluster> const expected_clusters = hierarchical_clustering_method(all_junctions, 10);
+    ASSERT_EQ(clusters.size(), expected_clusters.size());
+    for (size_t i = 0; i < clusters.size(); ++i)
+        EXPECT_EQ(clusters[i].get_members(), expected_clusters[i].get_members()) << "Cluster " << i << " unequal";
+}
+
+// The inserted sequence of the i-th junction of the arena tests, which is read back after the arena was compacted.
+seqan3::dna5_vector arena_test_sequence(size_t const i)
+{
+    seqan3::dna5_vector sequence(2000);
+    for (size_t k = 0; k < sequence.size(); ++k)
+        sequence[k].assign_rank((i + k) % 4);
+    return sequence;
+}
+
+TEST(hierarchical_clustering, junction_window_arena)
+{
+    // Every alignment adds a junction with a long insertion, so the junctions of the file need far more bytes in the
+    // junction arena than the ones held by the window.
+    size_t const num_junctions = 60000;
+    size_t num_released = 0;
+    junction_window window{1000, [&] (std::vector<Junction> & batch)
+    {
+        // The released junctions were moved to new chunks in between, but still have their sequences and names.
+        for (Junction const & junction : batch)
+        {
+            size_t const i = std::stoul(std::string{junction.get_read_name()});
+            EXPECT_EQ(junction.get_inserted_sequence(), arena_test_sequence(i));
+        }
+        num_released += batch.size();
+    }};
+    size_t max_arena_bytes = 0;
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        int32_t const position = 1000 + static_cast<int32_t>(i) * 100;
+        window.advance(intern_sequence_name(chrom1), position);
+        window.add(Junction{Breakend{chrom1, position - 200, strand::forward},
+                            Breakend{chrom1, position + 300, strand::forward},
+                            arena_test_sequence(i),
+                            std::to_string(i)});
+        window.compact_arena();
+        max_arena_bytes = std::max(max_arena_bytes, arena_allocated_bytes());
+    }
+    window.finish();
+    EXPECT_EQ(num_released, num_junctions);
+    EXPECT_EQ(window.num_late_junctions(), 0);
+    EXPECT_GT(num_junctions * arena_test_sequence(0).size() / 2, 3 * max_arena_bytes);
+    EXPECT_LE(max_arena_bytes, 2 * min_arena_compaction_bytes);
+}
+
+TEST(hierarchical_clustering, contig_pair_buffer)
+{
+    // Three sequences analyzed in the order chrom2, chrom3, chrom1. Each sequence adds junctions within itself and
+    // translocations to the other sequences, which are held until both of their sequences were added.
+    std::string const chrom3 = "chr10";
+    std::vector<std::string> const chroms{chrom2, chrom3, chrom1};
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<int32_t> position{1000, 200000};
+    std::uniform_int_distribution<size_t> partner{0, 7};
+    std::vector<Junction> all_junctions{};
+    std::vector<std::vector<Junction>> batches{};
+    contig_pair_buffer buffer{[&] (std::vector<Junction> & batch) { batches.push_back(batch); }};
+    std::set<sequence_id_t> added_seq_ids{};
+    for (std::string const & chrom : chroms)
+    {
+        std::vector<Junction> junctions{};
+        for (int32_t i = 0; i < 3000; ++i)
+        {
+            int32_t const mate1_position = position(generator);
+            size_t const other = partner(generator);
+            junctions.emplace_back(Breakend{chrom, mate1_position, (i % 2) ? strand::forward : strand::reverse},
+                                   Breakend{other < chroms.size() ? chroms[other] : chrom,
+                                            mate1_position + 500 + i % 20,
+                                            strand::forward},
+                                   ""_dna5,
+                                   read_name_1);
+        }
+        all_junctions.insert(all_junctions.end(), junctions.begin(), junctions.end());
+
+        size_t const num_batches = batches.size();
+        buffer.add_sequence(intern_sequence_name(chrom), junctions);
+        EXPECT_TRUE(junctions.empty());
+        added_seq_ids.insert(intern_sequence_name(chrom));
+        // Only pairs of added sequences are released, each of them once.
+        EXPECT_GT(batches.size(), num_batches);
+        for (size_t i = num_batches; i < batches.size(); ++i)
+        {
+            EXPECT_TRUE(added_seq_ids.contains(batches[i].front().get_mate1().seq_id));
+            EXPECT_TRUE(added_seq_ids.contains(batches[i].front().get_mate2().seq_id));
+        }
+    }
+    std::vector<Junction> twice{};
+    EXPECT_THROW(buffer.add_sequence(intern_sequence_name(chrom2), twice), std::runtime_error);
+
+    // A junction within chrom2, which was released already, is late.
+    Junction const late_junction{Breakend{chrom2, 2000, strand::forward}, Breakend{chrom2, 3000, strand::forward},
+                                 ""_dna5, read_name_2};
+    std::vector<Junction> late_junctions{late_junction};
+    buffer.add_sequence(intern_sequence_name("chr3"), late_junctions);
+    buffer.finish();
+    EXPECT_EQ(buffer.num_late_junctions(), 1);
+    EXPECT_EQ(batches.back(), std::vector<Junction>{late_junction});
+    batches.pop_back();
+
+    // The batches are sorted and partitions never contain junctions of different pairs of sequences, so clustering
+    // them separately gives the same result as clustering all junctions at once.
+    std::vector<Cluster> clusters{};
+    for (std::vector<Junction> & batch : batches)
+    {
+        EXPECT_TRUE(std::is_sorted(batch.begin(), batch.end()));
+        std::vector<Cluster> const batch_clusters = hierarchical_clustering_method(batch, 10);
+        clusters.insert(clusters.end(), batch_clusters.begin(), batch_clusters.end());
+    }
+    std::sort(clusters.begin(), clusters.end());
+    std::sort(all_junctions.begin(), all_junctions.end());
+    std::vector<Cluster> const expected_clusters = hierarchical_clustering_method(all_junctions, 10);
+    ASSERT_EQ(clusters.size(), expected_clusters.size());
+    for (size_t i = 0; i < clusters.size(); ++i)
+        EXPECT_EQ(clusters[i].get_members(), expected_clusters[i].get_members()) << "Cluster " << i << " unequal";
+}
+
+TEST(hierarchical_clustering, contig_pair_buffer_arena)
+{
+    // Many sequences with junctions with long insertions within themselves and a few translocations to the last
+    // sequence, which are held until the end. The junctions of all sequences need far more bytes in the junction arena
+    // than the ones of a single sequence.
+    size_t const num_sequences = 60;
+    size_t const junctions_per_sequence = 1000;
+    size_t num_released = 0;
+    contig_pair_buffer buffer{[&] (std::vector<Junction> & batch)
+    {
+        // The held junctions were moved to new chunks in between, but still have their sequences and names.
+        for (Junction const & junction : batch)
+        {
+            size_t const i = std::stoul(std::string{junction.get_read_name()});
+            EXPECT_EQ(junction.get_inserted_sequence(), arena_test_sequence(i));
+        }
+        num_released += batch.size();
+    }};
+    std::string const last_chrom = "arena_chr_last";
+    size_t max_arena_bytes = 0;
+    for (size_t s = 0; s < num_sequences; ++s)
+    {
+        std::string const chrom = "arena_chr" + std::to_string(s);
+        std::vector<Junction> junctions{};
+        for (size_t j = 0; j < junctions_per_sequence; ++j)
+        {
+            size_t const i = s * junctions_per_sequence + j;
+            int32_t const position = 1000 + static_cast<int32_t>(j) * 100;
+            junctions.emplace_back(Breakend{chrom, position, strand::forward},
+                                   Breakend{(j % 100) ? chrom : last_chrom, position + 300, strand::forward},
+                                   arena_test_sequence(i),
+                                   std::to_string(i));
+        }
+        buffer.add_sequence(intern_sequence_name(chrom), junctions);
+        buffer.compact_arena();
+        max_arena_bytes = std::max(max_arena_bytes, arena_allocated_bytes());
+    }
+    std::vector<Junction> no_junctions{};
+    buffer.add_sequence(intern_sequence_name(last_chrom), no_junctions);
+    buffer.finish();
+    EXPECT_EQ(num_released, num_sequences * junctions_per_sequence);
+    EXPECT_EQ(buffer.num_late_junctions(), 0);
+    EXPECT_GT(num_sequences * junctions_per_sequence * arena_test_sequence(0).size() / 2, 3 * max_arena_bytes);
+    EXPECT_LE(max_arena_bytes, 2 * min_arena_compaction_bytes + junctions_per_sequence * arena_test_sequence(0).size());
+}
+
+TEST(hierarchical_clustering, external_junction_sorter)
+{
+    // The junction arena is cleared by the sorter, so the junctions are kept as plain values.
+    using junction_values = std::tuple<Breakend, Breakend, std::string, std::string>;
+    auto to_values = [] (Junction const & junction)
+    {
+        seqan3::dna5_vector const inserted = junction.get_inserted_sequence();
+        std::string inserted_string{};
+        for (seqan3::dna5 const base : inserted)
+            inserted_string.push_back(seqan3::to_char(base));
+        return junction_values{junction.get_mate1(),
+                               junction.get_mate2(),
+                               inserted_string,
+                               std::string{junction.get_read_name()}};
+    };
+    auto to_junction = [] (junction_values const & values)
+    {
+        seqan3::dna5_vector inserted{};
+        for (char const base : std::get<2>(values))
+            inserted.push_back(seqan3::dna5{}.assign_char(base));
+        return Junction{std::get<0>(values), std::get<1>(values), inserted, std::get<3>(values)};
+    };
+
+    std::mt19937 generator{11};
+    std::uniform_int_distribution<int32_t> position{1000, 2000000};
+    std::uniform_int_distribution<size_t> inserted_length{0, 40};
+    std::uniform_int_distribution<int> base{0, 3};
+    std::vector<junction_values> expected{};
+    {
+        external_junction_sorter sorter{4 << 20};
+        std::vector<Junction> junctions{};
+        for (size_t i = 0; i < 150000; ++i)
+        {
+            seqan3::dna5_vector inserted(inserted_length(generator));
+            for (seqan3::dna5 & inserted_base : inserted)
+                inserted_base.assign_rank(base(generator));
+            int32_t const mate1_position = position(generator);
+            junctions.emplace_back(Breakend{chrom1, mate1_position, (i % 3) ? strand::forward : strand::reverse},
+                                   Breakend{(i % 7) ? chrom1 : chrom2, mate1_position + 500, strand::forward},
+                                   inserted,
+                                   "read_" + std::to_string(i / 3));
+            expected.push_back(to_values(junctions.back()));
+            // The junctions of a few alignments are added together.
+            if (i % 4 == 3)
+                sorter.add(junctions);
+        }
+        sorter.add(junctions);
+        EXPECT_TRUE(junctions.empty());
+        EXPECT_GT(sorter.num_runs(), 1);
+
+        // The merged batches are sorted and end at partition borders.
+        std::vector<junction_values> merged{};
+        size_t num_batches{0};
+        sorter.merge([&] (std::vector<Junction> & batch)
+        {
+            ASSERT_FALSE(batch.empty());
+            EXPECT_TRUE(std::is_sorted(batch.begin(), batch.end()));
+            if (!merged.empty())
+            {
+                Junction const previous = to_junction(merged.back());
+                EXPECT_FALSE(batch.front() < previous);
+                EXPECT_TRUE(is_partition_border(previous.get_mate1(), batch.front().get_mate1()));
+            }
+            for (Junction const & junction : batch)
+                merged.push_back(to_values(junction));
+            ++num_batches;
+        });
+        EXPECT_GT(num_batches, 1);
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(merged.begin(), merged.end());
+        EXPECT_TRUE(merged == expected);
+    }
+
+    // Without spilling, the junctions are sorted in memory and passed as one batch.
+    external_junction_sorter sorter{64 << 20};
+    std::vector<Junction> junctions{to_junction(expected.back()), to_junction(expected.front())};
+    sorter.add(junctions);
+    std::vector<std::vector<Junction>> batches{};
+    sorter.merge([&] (std::vector<Junction> & batch) { batches.push_back(batch); });
+    EXPECT_EQ(sorter.num_runs(), 0);
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], (std::vector<Junction>{to_junction(expected.front()), to_junction(expected.back())}));
+}
+
+TEST(hierarchical_clustering, sort_junctions)
+{
+    // Few positions and long inserted sequences with common prefixes give many junctions with equal sort keys.
+    std::mt19937 generator{13};
+    std::uniform_int_distribution<int32_t> position{-50, 300};
+    std::uniform_int_distribution<size_t> inserted_length{0, 30};
+    std::uniform_int_distribution<int> base{0, 4};
+    std::vector<Junction> junctions{};
+    for (size_t i = 0; i < 200000; ++i)
+    {
+        seqan3::dna5_vector inserted(inserted_length(generator));
+        for (size_t j = 0; j < inserted.size(); ++j)
+            inserted[j].assign_rank(j < 20 ? (i % 2) : base(generator));
+        junctions.emplace_back(Breakend{(i % 5) ? chrom1 : chrom2, position(generator), strand::forward},
+                               Breakend{chrom2, position(generator), (i % 3) ? strand::forward : strand::reverse},
+                               inserted,
+                               "read_" + std::to_string(i));
+    }
+
+    // The order is the one of std::stable_sort() for any number of threads, also for small inputs.
+    for (size_t const threads : {1, 4})
+    {
+        for (size_t const size : {size_t{100}, junctions.size()})
+        {
+            std::vector<Junction> sorted(junctions.begin(), junctions.begin() + size);
+            std::vector<Junction> expected_sorted = sorted;
+            std::stable_sort(expected_sorted.begin(), expected_sorted.end());
+            sort_junctions(sorted, threads);
+            ASSERT_EQ(sorted, expected_sorted);
+            for (size_t i = 0; i < size; ++i)
+                ASSERT_EQ(sorted[i].get_read_name(), expected_sorted[i].get_read_name());
+        }
+    }
+
+    // The indices of a part of the junctions are sorted in place.
+    std::vector<size_t> indices{7, 3, 5, 1};
+    sort_junction_indices(junctions, std::span{indices}.subspan(1), 4);
+    EXPECT_EQ(indices[0], 7u);
+    EXPECT_FALSE(junctions[indices[2]] < junctions[indices[1]]);
+    EXPECT_FALSE(junctions[indices[3]] < junctions[indices[2]]);
+}
+
+/* -------- interned sequence names tests -------- */
+
+TEST(sequence_dictionary, interned_breakends)
+{
+    // Names added out of lexicographical order still compare like the names themselves.
+    intern_sequence_names(std::vector<std::string>{"chrZ_test", "chrA_test", "chrM_test"});
+    Breakend const breakend_z{"chrZ_test", 10, strand::forward};
+    Breakend const breakend_a{"chrA_test", 20, strand::forward};
+    Breakend const breakend_b{"chrB_test", 5, strand::reverse};   // added after the bulk insertion
+
+    EXPECT_EQ(breakend_z.seq_id, intern_sequence_name("chrZ_test"));
+    EXPECT_EQ(breakend_a.seq_name(), "chrA_test");
+    EXPECT_EQ(breakend_b.seq_name(), "chrB_test");
+    EXPECT_TRUE(breakend_a < breakend_b);
+    EXPECT_TRUE(breakend_b < breakend_z);
+    EXPECT_FALSE(breakend_z < breakend_a);
+    EXPECT_EQ(breakend_a, (Breakend{"chrA_test", 20, strand::forward}));
+    EXPECT_NE(breakend_a, (Breakend{"chrM_test", 20, strand::forward}));
+
+    // The mates of a junction are ordered by sequence name.
+    Junction const junction{breakend_z, breakend_a, ""_dna5, read_name_1};
+    EXPECT_EQ(junction.get_mate1().seq_name(), "chrA_test");
+    EXPECT_EQ(junction.get_mate2().seq_name(), "chrZ_test");
+}
+
+/* -------- cluster tests -------- */
+
+TEST(cluster, summary)
+{
+    Cluster cluster{{Junction{Breakend{chrom1, 100, strand::forward}, Breakend{chrom2, 1000, strand::reverse},
+                              "ACGT"_dna5, read_name_1},
+                     Junction{Breakend{chrom1, 103, strand::forward}, Breakend{chrom2, 1010, strand::reverse},
+                              ""_dna5, read_name_2}}};
+    EXPECT_EQ(cluster.get_cluster_size(), 2);
+    EXPECT_EQ(cluster.get_average_mate1(), (Breakend{chrom1, 102, strand::forward}));
+    EXPECT_EQ(cluster.get_average_mate2(), (Breakend{chrom2, 1005, strand::reverse}));
+    EXPECT_EQ(cluster.get_average_inserted_sequence_size(), 2);
+    EXPECT_EQ(cluster.get_min_inserted_sequence_size(), 0);
+    EXPECT_EQ(cluster.get_max_inserted_sequence_size(), 4);
+
+    // The summary is updated when members are added.
+    cluster.add_member(Junction{Breakend{chrom1, 109, strand::forward}, Breakend{chrom2, 1020, strand::reverse},
+                                "ACGTACGTAC"_dna5, read_name_3});
+    EXPECT_EQ(cluster.get_cluster_size(), 3);
+    EXPECT_EQ(cluster.get_average_mate1(), (Breakend{chrom1, 104, strand::forward}));
+    EXPECT_EQ(cluster.get_average_mate2(), (Breakend{chrom2, 1010, strand::reverse}));
+    EXPECT_EQ(cluster.get_average_inserted_sequence_size(), 5);
+    EXPECT_EQ(cluster.get_max_inserted_sequence_size(), 10);
+
+    // Members with different orientations can not be added and leave the cluster unchanged.
+    EXPECT_THROW(cluster.add_member(Junction{Breakend{chrom1, 104, strand::forward},
+                                             Breakend{chrom2, 1010, strand::forward}, ""_dna5, read_name_4}),
+                 std::runtime_error);
+    EXPECT_EQ(cluster.get_cluster_size(), 3);
+    EXPECT_EQ(cluster.get_average_mate2(), (Breakend{chrom2, 1010, strand::reverse}));
+}
+
+TEST(cluster, checkpoint)
+{
+    std::vector<Junction> const junctions = prepare_input_junctions();
+    std::vector<Cluster> const clusters = hierarchical_clustering_method(junctions, 15);
+    cmd_arguments args{};
+    args.hierarchical_clustering_cutoff = 15;
+
+    std::filesystem::path const checkpoint_path{std::filesystem::temp_directory_path()/"cluster_checkpoint.bin"};
+    write_cluster_checkpoint(checkpoint_path, clusters, junctions, args);
+    std::vector<Cluster> const restored_clusters = read_cluster_checkpoint(checkpoint_path, junctions, args);
+
+    ASSERT_EQ(restored_clusters.size(), clusters.size());
+    for (size_t i = 0; i < clusters.size(); ++i)
+    {
+        EXPECT_EQ(restored_clusters[i], clusters[i]);
+        EXPECT_EQ(restored_clusters[i].get_average_mate1(), clusters[i].get_average_mate1());
+        EXPECT_EQ(restored_clusters[i].get_average_mate2(), clusters[i].get_average_mate2());
+        EXPECT_EQ(restored_clusters[i].get_average_inserted_sequence_size(),
+                  clusters[i].get_average_inserted_sequence_size());
+        EXPECT_EQ(restored_clusters[i].get_min_inserted_sequence_size(), clusters[i].get_min_inserted_sequence_size());
+        EXPECT_EQ(restored_clusters[i].get_max_inserted_sequence_size(), clusters[i].get_max_inserted_sequence_size());
+    }
+
+    // A checkpoint belongs to the junctions it was written for.
+    EXPECT_THROW(read_cluster_checkpoint(checkpoint_path, std::span{junctions}.first(junctions.size() - 1), args),
+                 std::runtime_error);
+    // The same number of other junctions is detected as well.
+    std::vector<Junction> other_junctions = junctions;
+    other_junctions.back() = Junction{Breakend{chrom2, chrom2_position1, strand::forward},
+                                      Breakend{chrom2, chrom2_position1 + 1000, strand::forward},
+                                      ""_dna5,
+                                      read_name_1};
+    EXPECT_THROW(read_cluster_checkpoint(checkpoint_path, other_junctions, args), std::runtime_error);
+    // Only the clustered junctions can be members.
+    EXPECT_THROW(write_cluster_checkpoint(checkpoint_path, clusters, std::span{junctions}.first(3), args),
+                 std::runtime_error);
+
+    std::filesystem::remove(checkpoint_path);
 }
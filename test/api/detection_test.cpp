@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <random>
+#include <sstream>
+
 #include <seqan3/alphabet/cigar/cigar.hpp>
 #include <seqan3/io/sam_file/sam_flag.hpp>
 
 #include "modules/sv_detection_methods/analyze_cigar_method.hpp"    // for the split read method
 #include "modules/sv_detection_methods/analyze_sa_tag_method.hpp"   // for the cigar string method
+#include "variant_detection/thread_debug_stream.hpp"                // for thread_debug_stream
 
 using seqan3::operator""_cigar_operation;
 using seqan3::operator""_dna5;
@@ -214,6 +218,176 @@ TEST(junction_detection, retrieve_aligned_segments)
     }
 }
 
+TEST(junction_detection, aligned_segment_coordinates)
+{
+    std::vector<seqan3::cigar> const cigar{{5, 'H'_cigar_operation}, {10, 'S'_cigar_operation},
+                                           {20, 'M'_cigar_operation}, {5, 'I'_cigar_operation},
+                                           {3, 'D'_cigar_operation}, {2, 'N'_cigar_operation},
+                                           {1, 'P'_cigar_operation}, {10, '='_cigar_operation},
+                                           {4, 'X'_cigar_operation}, {8, 'S'_cigar_operation},
+                                           {3, 'H'_cigar_operation}};
+    AlignedSegment segment{strand::forward, "chr1", 100, 60, cigar};
+    EXPECT_EQ(segment.get_reference_start(), 100);
+    EXPECT_EQ(segment.get_reference_end(), 138);
+    EXPECT_EQ(segment.get_left_soft_clip(), 10);
+    EXPECT_EQ(segment.get_right_soft_clip(), 8);
+    EXPECT_EQ(segment.get_query_length(), 57);
+    EXPECT_EQ(segment.get_query_start(), 10);
+    EXPECT_EQ(segment.get_query_end(), 49);
+
+    // Assigning new members updates the coordinates.
+    segment.assign(strand::reverse, "chr2", 200, 60, cigar);
+    EXPECT_EQ(segment.get_orientation(), strand::reverse);
+    EXPECT_EQ(segment.get_ref_name(), "chr2");
+    EXPECT_EQ(segment.get_reference_start(), 200);
+    EXPECT_EQ(segment.get_reference_end(), 238);
+    EXPECT_EQ(segment.get_query_start(), 8);
+    EXPECT_EQ(segment.get_query_end(), 47);
+
+    // Without aligned bases, all soft clipped bases belong to both soft clips.
+    AlignedSegment const clipped_segment{strand::forward, "chr1", 100, 60, {{10, 'S'_cigar_operation},
+                                                                            {5, 'S'_cigar_operation}}};
+    EXPECT_EQ(clipped_segment.get_reference_end(), 99);
+    EXPECT_EQ(clipped_segment.get_left_soft_clip(), 15);
+    EXPECT_EQ(clipped_segment.get_right_soft_clip(), 15);
+    EXPECT_EQ(clipped_segment.get_query_length(), 15);
+}
+
+// Previous SA tag parser based on std::stringstream, std::stoi and seqan3::detail::parse_cigar as reference.
+void retrieve_aligned_segments_reference(std::string const & sa_string, std::vector<AlignedSegment> & aligned_segments)
+{
+    std::vector<std::string> sa_tags{};
+    split_string(sa_string, sa_tags, ';');
+    for (std::string sa_tag : sa_tags)
+    {
+        std::vector<std::string> fields {};
+        split_string(sa_tag, fields, ',');
+        if (fields.size() == 6)
+        {
+            std::string ref_name = fields[0];
+            int32_t pos = std::stoi(fields[1]) - 1;
+            strand orientation;
+            if (fields[2] == "+")
+                orientation = strand::forward;
+            else if (fields[2] == "-")
+                orientation = strand::reverse;
+            else
+                continue;
+            std::vector<seqan3::cigar> cigar_vector = std::get<0>(seqan3::detail::parse_cigar(fields[3]));
+            int32_t mapq = std::stoi(fields[4]);
+            aligned_segments.push_back(AlignedSegment{orientation, ref_name, pos, mapq, cigar_vector});
+        }
+        else
+        {
+            thread_debug_stream << "Your SA tag has a wrong format (wrong amount of parameters): " << sa_tag << '\n';
+        }
+    }
+}
+
+TEST(junction_detection, retrieve_aligned_segments_fuzzy)
+{
+    std::mt19937 generator{1234};
+    auto pick = [&] (std::vector<std::string> const & choices)
+    {
+        return choices[std::uniform_int_distribution<size_t>{0, choices.size() - 1}(generator)];
+    };
+    auto random_cigar = [&] ()
+    {
+        std::string cigar{};
+        size_t const num_operations = std::uniform_int_distribution<size_t>{0, 12}(generator);
+        for (size_t i = 0; i < num_operations; ++i)
+            cigar += std::to_string(std::uniform_int_distribution<uint32_t>{0, 20000}(generator)) +
+                     pick({"M", "I", "D", "N", "S", "H", "P", "=", "X"});
+        return cigar + pick({"", "", "", "", "", "", "12", "M5S"});  // sometimes malformed
+    };
+    std::vector<std::string> const ref_names{"chr1", "chr22", "", "HLA-A*01:01:01:01", "chrUn_KI270742v1"};
+    std::vector<std::string> const numbers{"1", "42", "17458418", "0", "-5", "+12", " 7", "12x", "", "abc", "+-3",
+                                           "99999999999"};
+    std::vector<std::string> const strands{"+", "-", "+", "-", "*", ""};
+
+    std::vector<AlignedSegment> reused_buffer{};
+    size_t num_compared = 0;
+    for (size_t iteration = 0; iteration < 5000; ++iteration)
+    {
+        std::string sa_tag{};
+        size_t const num_entries = std::uniform_int_distribution<size_t>{0, 12}(generator);
+        for (size_t j = 0; j < num_entries; ++j)
+        {
+            std::vector<std::string> fields{pick(ref_names), pick(numbers), pick(strands), random_cigar(),
+                                            pick(numbers), pick(numbers)};
+            if (std::uniform_int_distribution<int>{0, 9}(generator) == 0)
+                fields.pop_back();
+            if (std::uniform_int_distribution<int>{0, 9}(generator) == 0)
+                fields.push_back(pick(numbers));
+            for (size_t k = 0; k < fields.size(); ++k)
+                sa_tag += (k == 0 ? "" : ",") + fields[k];
+            sa_tag += pick({";", ";", ";", ";;", ",;"});
+        }
+        if (!sa_tag.empty() && std::uniform_int_distribution<int>{0, 3}(generator) == 0)
+            sa_tag.pop_back();
+
+        std::ostringstream expected_messages{};
+        std::vector<AlignedSegment> segments_expected_res{};
+        thread_debug_stream.set_underlying_stream(expected_messages);
+        bool reference_failed = false;
+        try
+        {
+            retrieve_aligned_segments_reference(sa_tag, segments_expected_res);
+        }
+        catch (std::exception const &)
+        {
+            reference_failed = true;    // std::stoi and parse_cigar throw on invalid numbers and CIGAR strings
+        }
+
+        std::ostringstream messages{};
+        std::vector<AlignedSegment> segments_res{};
+        thread_debug_stream.set_underlying_stream(messages);
+        EXPECT_NO_THROW(retrieve_aligned_segments(sa_tag, segments_res));
+
+        // The reused buffer contains the segments of the previous SA tag.
+        std::ostringstream reused_buffer_messages{};
+        thread_debug_stream.set_underlying_stream(reused_buffer_messages);
+        size_t const num_segments = parse_sa_tag(sa_tag, reused_buffer, 0);
+        thread_debug_stream.set_underlying_stream(std::cerr);
+        EXPECT_EQ(messages.str(), reused_buffer_messages.str());
+
+        ASSERT_EQ(segments_res.size(), num_segments) << sa_tag;
+        for (size_t k = 0; k < num_segments; ++k)
+            EXPECT_TRUE(segments_res[k] == reused_buffer[k]) << sa_tag;
+
+        if (reference_failed)
+            continue;
+        ++num_compared;
+        EXPECT_EQ(expected_messages.str(), messages.str()) << sa_tag;
+        ASSERT_EQ(segments_expected_res.size(), segments_res.size()) << sa_tag;
+        for (size_t k = 0; k < segments_res.size(); ++k)
+            EXPECT_TRUE(segments_expected_res[k] == segments_res[k]) << sa_tag;
+    }
+    EXPECT_GT(num_compared, 500u);
+}
+
+TEST(junction_detection, retrieve_aligned_segments_invalid_fields)
+{
+    std::vector<AlignedSegment> segments_res{AlignedSegment{strand::forward, "chr1", 10, 60, {}}};
+    std::ostringstream messages{};
+    thread_debug_stream.set_underlying_stream(messages);
+    retrieve_aligned_segments("chr2,abc,+,10M,60,0;chr2,101,+,10M5,60,0;chr2,101,+,10Q,60,0;chr2,101,+,10M,,0;"
+                              "chr2,101,*,10M,60,0;chr2,101,+,10M;chr2,101,-,5S10M,60,0", segments_res);
+    thread_debug_stream.set_underlying_stream(std::cerr);
+
+    // The previous segments are kept, only the last element of the SA tag is valid.
+    ASSERT_EQ(segments_res.size(), 2u);
+    EXPECT_TRUE((segments_res[1] == AlignedSegment{strand::reverse, "chr2", 100, 60, {{5, 'S'_cigar_operation},
+                                                                                       {10, 'M'_cigar_operation}}}));
+    std::string const invalid_message{"Your SA tag has a wrong format (invalid position, CIGAR string or mapping "
+                                      "quality): "};
+    EXPECT_EQ(messages.str(), invalid_message + "chr2,abc,+,10M,60,0\n" +
+                              invalid_message + "chr2,101,+,10M5,60,0\n" +
+                              invalid_message + "chr2,101,+,10Q,60,0\n" +
+                              invalid_message + "chr2,101,+,10M,,0\n" +
+                              "Your SA tag has a wrong format (wrong amount of parameters): chr2,101,+,10M\n");
+}
+
 TEST(junction_detection, analyze_aligned_segments)
 {
     AlignedSegment aligned_segment1 {strand::forward, "chr1", 100, 60, std::vector<seqan3::cigar>{{6, 'M'_cigar_operation},
@@ -2,14 +2,20 @@
 
 #include <fstream>
 
+#include <zlib.h>                                   // for deflate, crc32
+
 #include <seqan3/io/exception.hpp>
+#include <seqan3/io/sam_file/input.hpp>             // for seqan3::sam_file_input
 
+#include "structures/junction_sort.hpp"             // for sort_junctions()
+#include "structures/junction_store.hpp"            // for write_junction_store(), class junction_store
 #include "variant_detection/variant_detection.hpp"  // for detect_junctions_in_long_reads_sam_file()
 
 using seqan3::operator""_dna5;
 
 std::string const default_alignment_short_reads_file_path = DATADIR"paired_end_mini_example.sam";
 std::string const default_alignment_long_reads_file_path = DATADIR"simulated.minimap2.hg19.coordsorted_cutoff.sam";
+std::string const default_alignment_long_reads_bam_file_path = DATADIR"simulated.minimap2.hg19.coordsorted_cutoff.bam";
 std::filesystem::path const empty_path{};
 std::string default_vcf_sample_name{"MYSAMPLE"};
 constexpr int16_t default_threads = 1;
@@ -191,6 +197,495 @@ TEST(input_file, detect_junctions_in_long_reads_sam_file)
     }
 }
 
+TEST(input_file, detect_junctions_in_long_reads_bam_file)
+{
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path,
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path,
+                       empty_path, // empty clusters path,
+                       default_threads,
+                       default_methods,
+                       simple_clustering,
+                       sVirl_refinement_method,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+
+    testing::internal::CaptureStderr();
+    std::vector<Junction> junctions_expected_res{};
+    std::map<std::string, int32_t> references_lengths_expected{};
+    detect_junctions_in_long_reads_sam_file(junctions_expected_res, references_lengths_expected, args);
+    std::string const expected_err = testing::internal::GetCapturedStderr();
+
+    // The BAM file with the same content is decoded by the two-phase BAM reader, with and without parallel inflate.
+    args.alignment_long_reads_file_path = default_alignment_long_reads_bam_file_path;
+    for (int16_t decompression_threads : {1, 4})
+    {
+        args.decompression_threads = decompression_threads;
+        testing::internal::CaptureStderr();
+        std::vector<Junction> junctions_res{};
+        std::map<std::string, int32_t> references_lengths{};
+        detect_junctions_in_long_reads_sam_file(junctions_res, references_lengths, args);
+        EXPECT_EQ(expected_err, testing::internal::GetCapturedStderr());
+
+        EXPECT_EQ(references_lengths_expected, references_lengths);
+        ASSERT_EQ(junctions_expected_res.size(), junctions_res.size());
+        for (size_t i = 0; i < junctions_expected_res.size(); ++i)
+        {
+            EXPECT_EQ(junctions_expected_res[i].get_read_name(), junctions_res[i].get_read_name());
+            EXPECT_TRUE(junctions_expected_res[i] == junctions_res[i]);
+        }
+    }
+}
+
+TEST(input_file, long_read_field_projection)
+{
+    bam_record_fields fields = required_long_read_fields({cigar_string});
+    EXPECT_TRUE(fields.cigar && fields.sequence && !fields.sa_tag);
+    fields = required_long_read_fields({split_read});
+    EXPECT_TRUE(fields.cigar && fields.sequence && fields.sa_tag);
+    fields = required_long_read_fields({read_pairs, read_depth});
+    EXPECT_FALSE(fields.cigar || fields.sequence || fields.sa_tag);
+
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path,
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path,
+                       empty_path, // empty clusters path,
+                       default_threads,
+                       {cigar_string},
+                       simple_clustering,
+                       sVirl_refinement_method,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+
+    using seqan3::operator""_cigar_operation;
+    bam_record record{};
+    record.cigar = {{100, 'M'_cigar_operation}, {29, 'I'_cigar_operation}, {100, 'M'_cigar_operation}};
+    EXPECT_FALSE(needs_query_sequence(record, args));
+    record.cigar[1] = {30, 'I'_cigar_operation};
+    EXPECT_TRUE(needs_query_sequence(record, args));
+
+    record.cigar[1] = {30, 'D'_cigar_operation};
+    record.sa_tag = "chr21,100,+,50S100M,60,0;";
+    EXPECT_FALSE(needs_query_sequence(record, args));
+    args.methods = {split_read};
+    EXPECT_TRUE(needs_query_sequence(record, args));
+    record.sa_tag.clear();
+    EXPECT_FALSE(needs_query_sequence(record, args));
+
+    // The SAM file is decoded with the projected fields, the BAM file additionally decodes the sequence lazily.
+    for (std::vector<detection_methods> methods : {std::vector{cigar_string}, std::vector{split_read}})
+    {
+        args.methods = methods;
+        args.alignment_long_reads_file_path = default_alignment_long_reads_file_path;
+        testing::internal::CaptureStderr();
+        std::vector<Junction> junctions_expected_res{};
+        std::map<std::string, int32_t> references_lengths_expected{};
+        detect_junctions_in_long_reads_sam_file(junctions_expected_res, references_lengths_expected, args);
+        std::string const expected_err = testing::internal::GetCapturedStderr();
+        EXPECT_FALSE(junctions_expected_res.empty());
+
+        args.alignment_long_reads_file_path = default_alignment_long_reads_bam_file_path;
+        testing::internal::CaptureStderr();
+        std::vector<Junction> junctions_res{};
+        std::map<std::string, int32_t> references_lengths{};
+        detect_junctions_in_long_reads_sam_file(junctions_res, references_lengths, args);
+        EXPECT_EQ(expected_err, testing::internal::GetCapturedStderr());
+
+        ASSERT_EQ(junctions_expected_res.size(), junctions_res.size());
+        for (size_t i = 0; i < junctions_expected_res.size(); ++i)
+        {
+            EXPECT_EQ(junctions_expected_res[i].get_read_name(), junctions_res[i].get_read_name());
+            EXPECT_TRUE(junctions_expected_res[i] == junctions_res[i]);
+        }
+    }
+}
+
+TEST(input_file, bam_file_reader_fixed_fields)
+{
+    bam_file_reader full_reader{default_alignment_long_reads_bam_file_path};
+    bam_file_reader two_phase_reader{default_alignment_long_reads_bam_file_path, 2};
+    bam_record full_record{};
+    bam_record record{};
+    size_t num_records = 0;
+    while (full_reader.read_record(full_record))
+    {
+        ASSERT_TRUE(two_phase_reader.read_fixed_fields(record));
+        EXPECT_EQ(full_record.ref_id, record.ref_id);
+        EXPECT_EQ(full_record.pos, record.pos);
+        EXPECT_EQ(full_record.mapq, record.mapq);
+        EXPECT_EQ(full_record.flag, record.flag);
+        // Every other record is decoded completely, the variable fields of the others are skipped.
+        if (num_records++ % 2 == 0)
+        {
+            two_phase_reader.decode_variable_fields(record);
+            EXPECT_EQ(full_record.read_name, record.read_name);
+            EXPECT_EQ(full_record.cigar, record.cigar);
+            EXPECT_EQ(full_record.sequence, record.sequence);
+            EXPECT_EQ(full_record.sa_tag, record.sa_tag);
+        }
+    }
+    EXPECT_FALSE(two_phase_reader.read_fixed_fields(record));
+    EXPECT_GT(num_records, 0u);
+}
+
+template <typename value_t>
+void append_value(std::string & buffer, value_t const value)
+{
+    buffer.append(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+// Writes `data` as a BGZF file, in blocks of at most 65280 bytes, followed by the empty end-of-file block.
+void write_bgzf_file(std::filesystem::path const & path, std::string_view const data)
+{
+    std::ofstream file{path, std::ios::binary};
+    auto write_block = [&] (std::string_view const block)
+    {
+        std::string compressed(compressBound(block.size()), '\0');
+        z_stream stream{};
+        ASSERT_EQ(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY), Z_OK);
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(block.data()));
+        stream.avail_in = block.size();
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = compressed.size();
+        int const status = deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+        ASSERT_EQ(status, Z_STREAM_END);
+
+        std::string header{"\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10};
+        append_value<uint16_t>(header, 6);                                      // XLEN
+        header += "BC";
+        append_value<uint16_t>(header, 2);
+        append_value<uint16_t>(header, header.size() + 2 + compressed.size() + 8 - 1);  // BSIZE: block size - 1
+        std::string footer{};
+        append_value<uint32_t>(footer, crc32(0L, reinterpret_cast<Bytef const *>(block.data()), block.size()));
+        append_value<uint32_t>(footer, block.size());
+        file << header << compressed << footer;
+    };
+    for (size_t begin = 0; begin < data.size(); begin += 65280)
+        write_block(data.substr(begin, 65280));
+    write_block({});
+}
+
+/* A read on chr1 with a CIGAR string of more than 65535 operations, which alternates matches and mismatches and
+ * contains an insertion and a deletion. In a BAM file, the CIGAR string is stored in the CG tag, either as an array
+ * of the type B,I like the SAM/BAM Format Specification (e.g. written by htslib) or as a string of the type Z like
+ * seqan3::sam_file_output writes it.
+ */
+struct long_cigar_read
+{
+    std::string name;
+    int32_t pos;
+    uint32_t insertion_length;
+    uint32_t deletion_length;
+    char cg_type;
+
+    std::vector<std::pair<uint32_t, char>> cigar() const
+    {
+        std::vector<std::pair<uint32_t, char>> operations{};
+        for (uint32_t k = 0; k < 35000; ++k)
+        {
+            operations.emplace_back(1, '=');
+            operations.emplace_back(1, 'X');
+            if (k == 10000)
+                operations.emplace_back(insertion_length, 'I');
+            if (k == 20000)
+                operations.emplace_back(deletion_length, 'D');
+        }
+        return operations;
+    }
+
+    std::string cigar_string() const
+    {
+        std::string text{};
+        for (auto const & [length, operation] : cigar())
+            text += std::to_string(length) + operation;
+        return text;
+    }
+
+    std::string sequence() const
+    {
+        std::string bases(70000 + insertion_length, 'A');
+        for (size_t i = 0; i < bases.size(); ++i)
+            bases[i] = "ACGTTGCA"[i % 8];
+        return bases;
+    }
+};
+
+// Writes the reads as a SAM file with the CIGAR strings in the CIGAR field and as a BAM file with the CG tags.
+void write_long_cigar_files(std::vector<long_cigar_read> const & reads,
+                            std::filesystem::path const & sam_path,
+                            std::filesystem::path const & bam_path)
+{
+    std::string const header_text{"@HD\tVN:1.6\tSO:coordinate\n@SQ\tSN:chr1\tLN:1000000\n"};
+    std::ofstream sam_file{sam_path};
+    sam_file << header_text;
+
+    std::string bam{"BAM\1", 4};
+    append_value<int32_t>(bam, header_text.size());
+    bam += header_text;
+    append_value<int32_t>(bam, 1);          // n_ref
+    append_value<int32_t>(bam, 5);
+    bam.append("chr1\0", 5);
+    append_value<int32_t>(bam, 1000000);
+
+    for (long_cigar_read const & read : reads)
+    {
+        std::vector<std::pair<uint32_t, char>> const cigar = read.cigar();
+        std::string const sequence = read.sequence();
+        sam_file << read.name << "\t0\tchr1\t" << read.pos + 1 << "\t60\t" << read.cigar_string() << "\t*\t0\t0\t"
+                 << sequence << "\t*\n";
+
+        uint32_t reference_length = 0;
+        for (auto const & [length, operation] : cigar)
+            reference_length += (operation == '=' || operation == 'X' || operation == 'D') ? length : 0;
+        std::string record{};
+        append_value<int32_t>(record, 0);                       // refID
+        append_value<int32_t>(record, read.pos);
+        append_value<uint8_t>(record, read.name.size() + 1);    // l_read_name
+        append_value<uint8_t>(record, 60);                      // MAPQ
+        append_value<uint16_t>(record, 0);                      // bin, not used by the reader
+        append_value<uint16_t>(record, 2);                      // n_cigar_op of the placeholder
+        append_value<uint16_t>(record, 0);                      // FLAG
+        append_value<int32_t>(record, sequence.size());         // l_seq
+        append_value<int32_t>(record, -1);                      // next_refID
+        append_value<int32_t>(record, -1);                      // next_pos
+        append_value<int32_t>(record, 0);                       // tlen
+        record.append(read.name.c_str(), read.name.size() + 1);
+        append_value<uint32_t>(record, sequence.size() << 4 | 4);   // <l_seq>S
+        append_value<uint32_t>(record, reference_length << 4 | 3);  // <reference length>N
+        std::string packed_sequence((sequence.size() + 1) / 2, '\0');
+        for (size_t i = 0; i < sequence.size(); ++i)
+        {
+            size_t const code = std::string_view{"=ACMGRSVTWYHKDBN"}.find(sequence[i]);
+            packed_sequence[i / 2] = static_cast<char>(packed_sequence[i / 2] | code << ((i % 2) ? 0 : 4));
+        }
+        record += packed_sequence;
+        record.append(sequence.size(), '\xff');                 // no base qualities
+        record += "CG";
+        if (read.cg_type == 'B')
+        {
+            record += "BI";
+            append_value<uint32_t>(record, cigar.size());
+            for (auto const & [length, operation] : cigar)
+                append_value<uint32_t>(record, length << 4 | std::string_view{"MIDNSHP=X"}.find(operation));
+        }
+        else
+        {
+            record += 'Z';
+            record += read.cigar_string();
+            record += '\0';
+        }
+        append_value<int32_t>(bam, record.size());
+        bam += record;
+    }
+    write_bgzf_file(bam_path, bam);
+}
+
+TEST(input_file, bam_file_reader_long_cigar)
+{
+    std::vector<long_cigar_read> const reads{{"long_read_b_array", 1000, 100, 200, 'B'},
+                                             {"long_read_string", 200000, 50, 80, 'Z'}};
+    std::filesystem::path const tmp_dir = std::filesystem::temp_directory_path();     // get the temp directory
+    std::filesystem::path const sam_path{tmp_dir/"long_cigar.sam"};
+    std::filesystem::path const bam_path{tmp_dir/"long_cigar.bam"};
+    write_long_cigar_files(reads, sam_path, bam_path);
+
+    // The BAM reader replaces the placeholder by the CIGAR string of the CG tag, like seqan3::sam_file_input.
+    using my_fields = seqan3::fields<seqan3::field::id,
+                                     seqan3::field::flag,
+                                     seqan3::field::ref_offset,
+                                     seqan3::field::mapq,
+                                     seqan3::field::cigar,
+                                     seqan3::field::seq>;
+    seqan3::sam_file_input sam_file{sam_path, my_fields{}};
+    bam_file_reader bam_file{bam_path};
+    bam_record record{};
+    size_t num_records = 0;
+    for (auto & expected_record : sam_file)
+    {
+        ASSERT_TRUE(bam_file.read_record(record));
+        EXPECT_EQ(expected_record.id(), record.read_name);
+        EXPECT_EQ(static_cast<uint16_t>(expected_record.flag()), record.flag);
+        EXPECT_EQ(expected_record.reference_position().value_or(-1), record.pos);
+        EXPECT_EQ(expected_record.mapping_quality(), record.mapq);
+        EXPECT_GT(record.cigar.size(), 65535u);
+        EXPECT_EQ(expected_record.cigar_sequence(), record.cigar);
+        EXPECT_EQ(expected_record.sequence(), record.sequence);
+        ++num_records;
+    }
+    EXPECT_FALSE(bam_file.read_record(record));
+    EXPECT_EQ(num_records, reads.size());
+
+    // The insertion and the deletion of both reads are detected in the SAM and the BAM file.
+    cmd_arguments args{"",
+                       sam_path,
+                       empty_path, // empty output path,
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path,
+                       empty_path, // empty clusters path,
+                       default_threads,
+                       {cigar_string},
+                       simple_clustering,
+                       no_refinement,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+    testing::internal::CaptureStderr();
+    std::vector<Junction> junctions_expected_res{};
+    std::map<std::string, int32_t> references_lengths_expected{};
+    detect_junctions_in_long_reads_sam_file(junctions_expected_res, references_lengths_expected, args);
+    std::string const expected_err = testing::internal::GetCapturedStderr();
+    EXPECT_EQ(junctions_expected_res.size(), 4u);
+
+    args.alignment_long_reads_file_path = bam_path;
+    testing::internal::CaptureStderr();
+    std::vector<Junction> junctions_res{};
+    std::map<std::string, int32_t> references_lengths{};
+    detect_junctions_in_long_reads_sam_file(junctions_res, references_lengths, args);
+    EXPECT_EQ(expected_err, testing::internal::GetCapturedStderr());
+
+    ASSERT_EQ(junctions_expected_res.size(), junctions_res.size());
+    for (size_t i = 0; i < junctions_expected_res.size(); ++i)
+    {
+        EXPECT_EQ(junctions_expected_res[i].get_read_name(), junctions_res[i].get_read_name());
+        EXPECT_TRUE(junctions_expected_res[i] == junctions_res[i]);
+    }
+
+    std::filesystem::remove(sam_path);
+    std::filesystem::remove(bam_path);
+}
+
+TEST(input_file, detect_junctions_in_long_reads_bam_file_by_regions)
+{
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path,
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path,
+                       empty_path, // empty clusters path,
+                       default_threads,
+                       default_methods,
+                       simple_clustering,
+                       sVirl_refinement_method,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+
+    // Serial run over the SAM file.
+    std::vector<Junction> junctions_expected_res{};
+    std::map<std::string, int32_t> references_lengths_expected{};
+    detect_junctions_in_long_reads_sam_file(junctions_expected_res, references_lengths_expected, args);
+
+    // Parallel runs over the indexed BAM file with the same content, split by chromosome and into 1 Mbp regions.
+    args.alignment_long_reads_file_path = default_alignment_long_reads_bam_file_path;
+    args.threads = 4;
+    for (int32_t region_size : {0, 1000000})
+    {
+        args.region_size = region_size;
+        std::vector<Junction> junctions_res{};
+        std::map<std::string, int32_t> references_lengths{};
+        detect_junctions_in_long_reads_sam_file(junctions_res, references_lengths, args);
+
+        EXPECT_EQ(references_lengths_expected, references_lengths);
+        ASSERT_EQ(junctions_expected_res.size(), junctions_res.size());
+        for (size_t i = 0; i < junctions_expected_res.size(); ++i)
+        {
+            EXPECT_EQ(junctions_expected_res[i].get_read_name(), junctions_res[i].get_read_name());
+            EXPECT_TRUE(junctions_expected_res[i] == junctions_res[i]);
+        }
+    }
+}
+
+TEST(input_file, detect_junctions_in_long_reads_in_batches)
+{
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path,
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path,
+                       empty_path, // empty clusters path,
+                       default_threads,
+                       default_methods,
+                       simple_clustering,
+                       sVirl_refinement_method,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+
+    testing::internal::CaptureStderr();
+    std::vector<Junction> junctions_expected_res{};
+    std::map<std::string, int32_t> references_lengths_expected{};
+    detect_junctions_in_long_reads_sam_file(junctions_expected_res, references_lengths_expected, args);
+    std::string const expected_err = testing::internal::GetCapturedStderr();
+
+    // With small batches, the records are spread over all analysis threads.
+    args.threads = 3;
+    for (size_t batch_size : {1u, 3u, 1000u})
+    {
+        testing::internal::CaptureStderr();
+        std::vector<Junction> junctions_res{};
+        std::map<std::string, int32_t> references_lengths{};
+        detect_junctions_in_long_reads_in_batches(junctions_res, references_lengths, args, batch_size);
+        EXPECT_EQ(expected_err, testing::internal::GetCapturedStderr());
+
+        EXPECT_EQ(references_lengths_expected, references_lengths);
+        ASSERT_EQ(junctions_expected_res.size(), junctions_res.size());
+        for (size_t i = 0; i < junctions_expected_res.size(); ++i)
+        {
+            EXPECT_EQ(junctions_expected_res[i].get_read_name(), junctions_res[i].get_read_name());
+            EXPECT_TRUE(junctions_expected_res[i] == junctions_res[i]);
+        }
+    }
+}
+
+TEST(input_file, bam_index_regions)
+{
+    bam_index const index{default_alignment_long_reads_bam_file_path + ".bai"};
+    std::vector<int32_t> const references_lengths{46709983};    // chr21
+
+    // Whole chromosome
+    std::vector<bam_region> regions = index.split_into_regions(references_lengths, 0);
+    ASSERT_EQ(regions.size(), 1u);
+    EXPECT_EQ(regions[0].ref_id, 0);
+    EXPECT_EQ(regions[0].begin, 0);
+    EXPECT_EQ(regions[0].end, std::numeric_limits<int32_t>::max());
+
+    // All alignments start at about 41.97 Mbp, regions behind the last window of the linear index are dropped.
+    regions = index.split_into_regions(references_lengths, 10000000);
+    ASSERT_EQ(regions.size(), 5u);
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+        EXPECT_EQ(regions[i].begin, static_cast<int32_t>(i * 10000000));
+        EXPECT_LE(regions[0].file_offset, regions[i].file_offset);
+    }
+    EXPECT_EQ(regions[3].end, 40000000);
+    EXPECT_EQ(regions[4].end, std::numeric_limits<int32_t>::max());
+
+    EXPECT_THROW(index.split_into_regions({46709983, 51304566}, 0), seqan3::format_error);
+}
+
 TEST(input_file, long_read_sam_file_unsorted)
 {
     std::vector<Junction> junctions_res{};
@@ -309,3 +804,124 @@ TEST(input_file, short_and_long_read_sam_file_with_different_references_lengths)
     std::filesystem::remove(short_sam_path);
     std::filesystem::remove(long_sam_path);
 }
+
+TEST(input_file, detect_junctions_for_several_detection_parameters)
+{
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path
+                       empty_path, // empty clusters path
+                       default_threads,
+                       default_methods,
+                       simple_clustering,
+                       no_refinement,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+    std::vector<cmd_arguments> detection_args(4, args);
+    detection_args[1].min_var_length = 10;
+    detection_args[2].min_var_length = 2000;
+    detection_args[3].max_overlap = 0;
+
+    testing::internal::CaptureStderr();
+    std::vector<std::vector<Junction>> junctions_res{};
+    std::map<std::string, int32_t> references_lengths{};
+    detect_junctions_in_long_reads_sam_file(junctions_res, references_lengths, detection_args);
+    std::string const serial_err = testing::internal::GetCapturedStderr();
+
+    // The junctions of every set of detection parameters are the ones of a separate pass over the file.
+    testing::internal::CaptureStderr();
+    ASSERT_EQ(junctions_res.size(), detection_args.size());
+    for (size_t i = 0; i < detection_args.size(); ++i)
+    {
+        std::vector<Junction> expected_junctions{};
+        std::map<std::string, int32_t> expected_references_lengths{};
+        detect_junctions_in_long_reads_sam_file(expected_junctions, expected_references_lengths, detection_args[i]);
+        EXPECT_EQ(junctions_res[i], expected_junctions);
+        EXPECT_EQ(references_lengths, expected_references_lengths);
+    }
+    testing::internal::GetCapturedStderr();
+
+    // With several threads, the SAM file is analyzed in batches and the indexed BAM file region by region, with the
+    // same junctions and messages.
+    for (std::string const & path : {default_alignment_long_reads_file_path,
+                                     default_alignment_long_reads_bam_file_path})
+    {
+        std::vector<cmd_arguments> parallel_args = detection_args;
+        for (cmd_arguments & set_args : parallel_args)
+        {
+            set_args.alignment_long_reads_file_path = path;
+            set_args.threads = 4;
+        }
+        testing::internal::CaptureStderr();
+        std::vector<std::vector<Junction>> parallel_junctions{};
+        std::map<std::string, int32_t> parallel_references_lengths{};
+        detect_junctions_in_long_reads_sam_file(parallel_junctions, parallel_references_lengths, parallel_args);
+        EXPECT_EQ(serial_err, testing::internal::GetCapturedStderr()) << path;
+        EXPECT_EQ(parallel_junctions, junctions_res) << path;
+        EXPECT_EQ(parallel_references_lengths, references_lengths) << path;
+    }
+}
+
+TEST(input_file, junction_store)
+{
+    std::vector<Junction> junctions{};
+    std::map<std::string, int32_t> references_lengths{};
+
+    cmd_arguments args{"",
+                       default_alignment_long_reads_file_path,
+                       empty_path, // empty output path
+                       default_vcf_sample_name,
+                       empty_path, // empty junctions path
+                       empty_path, // empty clusters path
+                       default_threads,
+                       default_methods,
+                       simple_clustering,
+                       no_refinement,
+                       default_min_length,
+                       default_max_var_length,
+                       default_max_tol_inserted_length,
+                       default_max_overlap,
+                       default_min_qual,
+                       default_hierarchical_clustering_cutoff};
+    testing::internal::CaptureStderr();
+    detect_junctions_in_long_reads_sam_file(junctions, references_lengths, args);
+    testing::internal::GetCapturedStderr();
+    sort_junctions(junctions);
+    ASSERT_FALSE(junctions.empty());
+
+    std::filesystem::path const store_path{std::filesystem::temp_directory_path()/"junction_store.bin"};
+    write_junction_store(store_path, junctions, references_lengths);
+
+    {
+        junction_store const store{store_path};
+        EXPECT_EQ(store.references_lengths(), references_lengths);
+        ASSERT_EQ(store.size(), junctions.size());
+
+        std::vector<Junction> const stored_junctions = store.junctions();
+        ASSERT_EQ(stored_junctions.size(), junctions.size());
+        for (size_t i = 0; i < junctions.size(); ++i)
+        {
+            EXPECT_EQ(stored_junctions[i], junctions[i]);
+            EXPECT_EQ(stored_junctions[i].get_inserted_sequence(), junctions[i].get_inserted_sequence());
+            EXPECT_EQ(stored_junctions[i].get_read_name(), junctions[i].get_read_name());
+        }
+        EXPECT_EQ(store.junction(junctions.size() - 1), junctions.back());
+    }
+
+    // A file, which is not a junction store, is rejected.
+    std::filesystem::path const not_a_store_path{std::filesystem::temp_directory_path()/"not_a_junction_store.bin"};
+    {
+        std::ofstream not_a_store{not_a_store_path};
+        not_a_store << "@HD\tVN:1.6\tSO:coordinate\n";
+    }
+    EXPECT_THROW((junction_store{not_a_store_path}), std::runtime_error);
+
+    std::filesystem::remove(store_path);
+    std::filesystem::remove(not_a_store_path);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include "variant_detection/variant_output.hpp"     // for output_variants()
+#include "variant_detection/vcf_record_writer.hpp"  // for class vcf_record_writer
+#include "variant_parser/variant_record.hpp"        // for class variant_record
+
+using seqan3::operator""_dna5;
+
+/* -------- variant output tests -------- */
+
+TEST(variant_output, vcf_record_writer)
+{
+    // Records with large positions and qualities, which a std::ostream prints in exponent notation.
+    std::mt19937_64 generator{42};
+    std::ostringstream expected{};
+    std::ostringstream written{};
+    {
+        // A small buffer, so that it is flushed many times and grown for long sequence names.
+        vcf_record_writer writer{written, 64};
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            std::string const chrom = (i % 100 == 0) ? std::string(100, 'c') : "chr" + std::to_string(i % 25);
+            std::string const sv_type = (i % 2 == 0) ? "DEL" : "INS";
+            uint64_t const pos = generator() % 3000000000;
+            float const qual = static_cast<float>((i < 1000) ? i : generator() % 100000000000);
+            int32_t const end = static_cast<int32_t>(generator() % 2000000000);
+            int32_t const sv_len = static_cast<int32_t>(generator() % 2000000) - 1000000;
+
+            variant_record record{};
+            record.set_chrom(chrom);
+            record.set_qual(qual);
+            record.set_alt("<" + sv_type + ">");
+            record.add_info("SVTYPE", sv_type);
+            record.set_pos(pos);
+            record.add_info("SVLEN", std::to_string(sv_len));
+            record.add_info("END", std::to_string(end));
+            record.print(expected);
+            writer.write_record(chrom, pos, sv_type, qual, end, sv_len);
+        }
+    }
+    EXPECT_EQ(written.str(), expected.str());
+}
+
+TEST(variant_output, output_variants)
+{
+    std::vector<Cluster> clusters{};
+    // A deletion of 99 bases supported by one read and an insertion of 40 bases supported by two reads.
+    clusters.emplace_back(std::vector<Junction>{Junction{Breakend{"chr1", 1000, strand::forward},
+                                                         Breakend{"chr1", 1100, strand::forward},
+                                                         ""_dna5,
+                                                         "read_1"}});
+    clusters.emplace_back(std::vector<Junction>{Junction{Breakend{"chr1", 2000, strand::forward},
+                                                         Breakend{"chr1", 2001, strand::forward},
+                                                         seqan3::dna5_vector(40, 'A'_dna5),
+                                                         "read_2"},
+                                                Junction{Breakend{"chr1", 2000, strand::forward},
+                                                         Breakend{"chr1", 2001, strand::forward},
+                                                         seqan3::dna5_vector(40, 'C'_dna5),
+                                                         "read_3"}});
+    // Too short to be reported.
+    clusters.emplace_back(std::vector<Junction>{Junction{Breakend{"chr2", 500, strand::forward},
+                                                         Breakend{"chr2", 510, strand::forward},
+                                                         ""_dna5,
+                                                         "read_4"}});
+    cmd_arguments const args{};
+
+    std::string const expected = "chr1\t1001\t.\tN\t<DEL>\t1\tPASS\tEND=1100;SVLEN=-99;SVTYPE=DEL\tGT\t./.\n"
+                                 "chr1\t2001\t.\tN\t<INS>\t2\tPASS\tEND=2001;SVLEN=40;SVTYPE=INS\tGT\t./.\n";
+    std::ostringstream out_stream{};
+    output_variants(clusters, args, out_stream);
+    EXPECT_EQ(out_stream.str(), expected);
+
+    // A writer collects the records of several calls and writes them on flush.
+    std::ostringstream batch_stream{};
+    vcf_record_writer writer{batch_stream};
+    output_variants(clusters, args, writer);
+    output_variants(clusters, args, writer);
+    EXPECT_EQ(batch_stream.str(), "");
+    writer.flush();
+    EXPECT_EQ(batch_stream.str(), expected + expected);
+}
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "modules/sv_detection_methods/analyze_sa_tag_method.hpp"   // for analyze_sa_tag()
+#include "variant_detection/thread_debug_stream.hpp"                // for thread_debug_stream
+
+using seqan3::operator""_cigar_operation;
+
+// Query start and end computed by walking the CIGAR string on every call, like the previous getters.
+std::pair<int32_t, int32_t> query_interval_by_cigar_walk(AlignedSegment const & segment)
+{
+    int32_t left_soft_clip = 0;
+    for (auto [length, operation] : segment.get_cigar())
+    {
+        if (operation.to_char() == 'S')
+            left_soft_clip += length;
+        else if (operation.to_char() == 'M' || operation.to_char() == '=' || operation.to_char() == 'X' ||
+                 operation.to_char() == 'I')
+            break;
+    }
+    int32_t right_soft_clip = 0;
+    for (auto [length, operation] : std::views::reverse(segment.get_cigar()))
+    {
+        if (operation.to_char() == 'S')
+            right_soft_clip += length;
+        else if (operation.to_char() == 'M' || operation.to_char() == '=' || operation.to_char() == 'X' ||
+                 operation.to_char() == 'I')
+            break;
+    }
+    int32_t query_length = 0;
+    for (auto [length, operation] : segment.get_cigar())
+    {
+        char const c = operation.to_char();
+        if (c == 'M' || c == 'S' || c == 'I' || c == 'X' || c == '=')
+            query_length += length;
+    }
+    if (segment.get_orientation() == strand::forward)
+        return {left_soft_clip, query_length - right_soft_clip};
+    return {right_soft_clip, query_length - left_soft_clip};
+}
+
+// Segments of a read of 5 kbp per segment in random order, each with 13 CIGAR operations.
+std::vector<AlignedSegment> generate_segments(size_t const num_segments)
+{
+    std::vector<AlignedSegment> segments{};
+    int32_t const read_length = 5000 * num_segments;
+    for (size_t i = 0; i < num_segments; ++i)
+    {
+        std::vector<seqan3::cigar> cigar{{static_cast<uint32_t>(5000 * i), 'S'_cigar_operation}};
+        for (uint32_t j = 0; j < 5; ++j)
+        {
+            cigar.push_back({900, 'M'_cigar_operation});
+            cigar.push_back({20, (j % 2) ? 'I'_cigar_operation : 'D'_cigar_operation});
+        }
+        cigar.push_back({400, 'M'_cigar_operation});
+        cigar.push_back({static_cast<uint32_t>(read_length - 5000 * (i + 1)), 'S'_cigar_operation});
+        segments.emplace_back(strand::forward, "chr" + std::to_string(i % 3 + 1), 1000000 + 100000 * i, 60, cigar);
+    }
+    std::shuffle(segments.begin(), segments.end(), std::mt19937{42});
+    return segments;
+}
+
+static void sort_by_cigar_walk(benchmark::State & state)
+{
+    std::vector<AlignedSegment> const segments = generate_segments(state.range(0));
+    auto less = [] (AlignedSegment const & lhs, AlignedSegment const & rhs)
+    {
+        auto const [lhs_start, lhs_end] = query_interval_by_cigar_walk(lhs);
+        auto const [rhs_start, rhs_end] = query_interval_by_cigar_walk(rhs);
+        return lhs_start != rhs_start ? lhs_start < rhs_start
+                                      : lhs_end != rhs_end ? lhs_end < rhs_end : lhs.get_mapq() < rhs.get_mapq();
+    };
+    std::vector<AlignedSegment> sorted{};
+    for (auto _ : state)
+    {
+        sorted = segments;
+        std::sort(sorted.begin(), sorted.end(), less);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+BENCHMARK(sort_by_cigar_walk)->ArgName("segments")->Arg(10)->Arg(20)->Arg(50);
+
+static void sort_by_cached_coordinates(benchmark::State & state)
+{
+    std::vector<AlignedSegment> const segments = generate_segments(state.range(0));
+    std::vector<AlignedSegment> sorted{};
+    for (auto _ : state)
+    {
+        sorted = segments;
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+BENCHMARK(sort_by_cached_coordinates)->ArgName("segments")->Arg(10)->Arg(20)->Arg(50);
+
+// Whole split read analysis of a read with the given number of supplementary segments.
+static void analyze_sa_tag_of_split_read(benchmark::State & state)
+{
+    std::vector<AlignedSegment> const segments = generate_segments(state.range(0) + 1);
+    std::string sa_tag{};
+    for (size_t i = 1; i < segments.size(); ++i)
+    {
+        sa_tag += segments[i].get_ref_name() + "," + std::to_string(segments[i].get_reference_start() + 1) + ",+,";
+        for (auto [length, operation] : segments[i].get_cigar())
+            sa_tag += std::to_string(length) + operation.to_char();
+        sa_tag += ",60,0;";
+    }
+    seqan3::dna5_vector const seq(segments[0].get_query_length());
+    cmd_arguments args{};
+    std::ostream null_stream{nullptr};
+    thread_debug_stream.set_underlying_stream(null_stream);
+    for (auto _ : state)
+    {
+        std::vector<Junction> junctions{};
+        analyze_sa_tag("read", seqan3::sam_flag{}, segments[0].get_ref_name(), segments[0].get_reference_start(), 60,
+                       segments[0].get_cigar(), seq, sa_tag, args, junctions);
+        benchmark::DoNotOptimize(junctions.data());
+    }
+    thread_debug_stream.set_underlying_stream(std::cerr);
+}
+BENCHMARK(analyze_sa_tag_of_split_read)->ArgName("segments")->Arg(10)->Arg(20)->Arg(50);
+
+BENCHMARK_MAIN();
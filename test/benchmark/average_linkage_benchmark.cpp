@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <random>
+
+#include "fastcluster.h"                                            // for hclust_fast
+#include "modules/clustering/average_linkage.hpp"                   // for average_linkage()
+#include "modules/clustering/hierarchical_clustering_method.hpp"    // for junction_distance()
+
+// Condensed distance matrix of a partition from a deep-coverage locus: reads supporting a few deletions, whose
+// junctions differ by a few bases, so that most junctions are merged below the cutoff.
+std::vector<double> generate_distances(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> deletion{0, 3};
+    std::uniform_int_distribution<int32_t> offset{-5, 5};
+    std::uniform_int_distribution<size_t> insertion_length{0, 10};
+    std::vector<Junction> junctions{};
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        int32_t const start = 1000000 + 20 * deletion(generator);
+        junctions.emplace_back(Breakend{"chr1", start + offset(generator), strand::forward},
+                               Breakend{"chr1", start + 5000 + offset(generator), strand::forward},
+                               seqan3::dna5_vector(insertion_length(generator)),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    std::vector<double> distances{};
+    for (size_t i = 0; i < junctions.size(); ++i)
+        for (size_t j = i + 1; j < junctions.size(); ++j)
+            distances.push_back(junction_distance(junctions[i], junctions[j]));
+    return distances;
+}
+
+double const clustering_cutoff = 10;
+
+// The full dendrogram of hclust_fast, cut at the cutoff, with new buffers for every partition.
+static void hclust_fast_and_cutree(benchmark::State & state)
+{
+    size_t const num_junctions = state.range(0);
+    std::vector<double> const distances = generate_distances(num_junctions);
+    for (auto _ : state)
+    {
+        std::vector<double> distmat = distances;
+        std::vector<int> merge(2 * (num_junctions - 1));
+        std::vector<double> height(num_junctions - 1);
+        std::vector<int> labels(num_junctions);
+        hclust_fast(num_junctions, distmat.data(), HCLUST_METHOD_AVERAGE, merge.data(), height.data());
+        cutree_cdist(num_junctions, merge.data(), height.data(), clustering_cutoff, labels.data());
+        benchmark::DoNotOptimize(labels.data());
+    }
+}
+BENCHMARK(hclust_fast_and_cutree)->ArgName("junctions")->Arg(50)->Arg(100)->Arg(200);
+
+// average_linkage() with reused buffers, computing the full dendrogram or stopping at the cutoff.
+template <bool stop_at_cutoff>
+static void nearest_neighbor_chain(benchmark::State & state)
+{
+    size_t const num_junctions = state.range(0);
+    std::vector<double> const distances = generate_distances(num_junctions);
+    average_linkage_buffers buffers{};
+    for (auto _ : state)
+    {
+        buffers.distances.assign(distances.begin(), distances.end());
+        average_linkage(num_junctions,
+                        stop_at_cutoff ? clustering_cutoff : std::numeric_limits<double>::infinity(),
+                        buffers);
+        benchmark::DoNotOptimize(buffers.labels.data());
+    }
+    state.counters["merges"] = buffers.merges.size();
+}
+BENCHMARK_TEMPLATE(nearest_neighbor_chain, false)->ArgName("junctions")->Arg(50)->Arg(100)->Arg(200);
+BENCHMARK_TEMPLATE(nearest_neighbor_chain, true)->ArgName("junctions")->Arg(50)->Arg(100)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include "bam_test_file.hpp"                            // for write_long_read_bam_file()
+#include "variant_detection/bam_functions.hpp"          // for hasFlag* functions
+#include "variant_detection/bam_reader.hpp"             // for class bam_file_reader
+#include "variant_detection/thread_debug_stream.hpp"    // for thread_debug_stream
+#include "variant_detection/variant_detection.hpp"      // for detect_junctions_in_long_reads_sam_file()
+
+// 4000 long reads of 10 kbp, only 20 % of them are good primary alignments, the others are secondary alignments or
+// have a low mapping quality.
+std::filesystem::path const bam_file_path = std::filesystem::temp_directory_path() / "iGenVar_prefilter_benchmark.bam";
+constexpr size_t num_records = 4000;
+constexpr int32_t read_length = 10000;
+constexpr double good_fraction = 0.2;
+
+inline bool is_good(bam_record const & record)
+{
+    seqan3::sam_flag const flag = static_cast<seqan3::sam_flag>(record.flag);
+    return !(hasFlagUnmapped(flag) || hasFlagSecondary(flag) || hasFlagDuplicate(flag) || record.mapq < 20);
+}
+
+// Decodes all fields of every record before filtering, like the previous implementation.
+static void decode_all_records(benchmark::State & state)
+{
+    size_t num_good = 0;
+    for (auto _ : state)
+    {
+        bam_file_reader reader{bam_file_path};
+        bam_record record{};
+        num_good = 0;
+        while (reader.read_record(record))
+        {
+            if (is_good(record))
+                num_good += record.sequence.size() > 0;
+        }
+        benchmark::DoNotOptimize(num_good);
+    }
+    state.counters["good_records"] = num_good;
+    state.counters["records_per_second"] = benchmark::Counter(state.iterations() * num_records,
+                                                              benchmark::Counter::kIsRate);
+}
+BENCHMARK(decode_all_records)->Unit(benchmark::kMillisecond);
+
+// Decodes the variable fields only for records passing the flag and mapping quality filters.
+static void prefilter_records(benchmark::State & state)
+{
+    size_t num_good = 0;
+    for (auto _ : state)
+    {
+        bam_file_reader reader{bam_file_path, static_cast<size_t>(state.range(0))};
+        bam_record record{};
+        num_good = 0;
+        while (reader.read_fixed_fields(record))
+        {
+            if (!is_good(record))
+                continue;
+            reader.decode_variable_fields(record);
+            num_good += record.sequence.size() > 0;
+        }
+        benchmark::DoNotOptimize(num_good);
+    }
+    state.counters["good_records"] = num_good;
+    state.counters["records_per_second"] = benchmark::Counter(state.iterations() * num_records,
+                                                              benchmark::Counter::kIsRate);
+}
+BENCHMARK(prefilter_records)->ArgName("decompression_threads")->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
+
+// Whole junction detection on the BAM file.
+static void detect_junctions(benchmark::State & state)
+{
+    cmd_arguments args{};
+    args.alignment_long_reads_file_path = bam_file_path;
+    args.methods = {cigar_string, split_read};
+    args.decompression_threads = state.range(0);
+    // Discard the messages of the detection methods.
+    std::ostream null_stream{nullptr};
+    thread_debug_stream.set_underlying_stream(null_stream);
+    size_t num_junctions = 0;
+    for (auto _ : state)
+    {
+        std::vector<Junction> junctions{};
+        std::map<std::string, int32_t> references_lengths{};
+        detect_junctions_in_long_reads_sam_file(junctions, references_lengths, args);
+        num_junctions = junctions.size();
+    }
+    thread_debug_stream.set_underlying_stream(std::cerr);
+    state.counters["junctions"] = num_junctions;
+}
+BENCHMARK(detect_junctions)->ArgName("decompression_threads")->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char ** argv)
+{
+    write_long_read_bam_file(bam_file_path, num_records, read_length, good_fraction);
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    std::filesystem::remove(bam_file_path);
+    return 0;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <seqan3/std/filesystem>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+/*! \brief Writes a coordinate sorted BAM file with random long read alignments on a single reference sequence.
+ *
+ * \param[in] path                  - path of the BAM file to write
+ * \param[in] num_records           - number of alignment records
+ * \param[in] read_length           - length of the read sequences
+ * \param[in] good_fraction         - fraction of primary alignments with high mapping quality, the others are
+ *                                    secondary alignments or have a mapping quality below 20
+ *
+ * \details Every good alignment contains a deletion and an insertion in its CIGAR string and every fourth has an SA
+ *          tag, so that all detection methods for long reads have something to do.
+ */
+inline void write_long_read_bam_file(std::filesystem::path const & path,
+                                     size_t const num_records,
+                                     int32_t const read_length,
+                                     double const good_fraction)
+{
+    std::string data{};
+    auto append = [&data] (auto const value)
+    {
+        data.append(reinterpret_cast<char const *>(&value), sizeof(value));
+    };
+
+    // Header
+    std::string const text{"@HD\tVN:1.6\tSO:coordinate\n@SQ\tSN:chr1\tLN:100000000\n"};
+    data.append("BAM\1", 4);
+    append(static_cast<int32_t>(text.size()));
+    data.append(text);
+    append(static_cast<int32_t>(1));
+    append(static_cast<int32_t>(5));
+    data.append("chr1", 5);
+    append(static_cast<int32_t>(100000000));
+
+    // Records
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+    std::string const sa_tag{"chr1,50000000,+,500S500M,60,0;"};
+    for (size_t i = 0; i < num_records; ++i)
+    {
+        bool const good = uniform(generator) < good_fraction;
+        uint16_t const flag = good ? 0 : ((i % 2) ? 256 : 0);
+        uint8_t const mapq = (good || (i % 2)) ? 60 : 5;
+        std::string const name = "read" + std::to_string(i);
+
+        // 100=, 50D, 100=, 50I, rest =
+        std::vector<uint32_t> const cigar{100u << 4 | 7, 50u << 4 | 2, 100u << 4 | 7, 50u << 4 | 1,
+                                          static_cast<uint32_t>(read_length - 250) << 4 | 7};
+        bool const with_sa = (i % 4 == 0);
+        std::string aux{};
+        aux.append("NMi");
+        int32_t const nm = 100;
+        aux.append(reinterpret_cast<char const *>(&nm), sizeof(nm));
+        if (with_sa)
+        {
+            aux.append("SAZ");
+            aux.append(sa_tag);
+            aux.push_back('\0');
+        }
+
+        int32_t const l_seq = read_length;
+        int32_t const block_size = 32 + name.size() + 1 + 4 * cigar.size() + (l_seq + 1) / 2 + l_seq + aux.size();
+        append(block_size);
+        append(static_cast<int32_t>(0));                            // refID
+        append(static_cast<int32_t>(1000 + 10 * i));                // pos
+        append(static_cast<uint8_t>(name.size() + 1));              // l_read_name
+        append(mapq);
+        append(static_cast<uint16_t>(4680));                        // bin
+        append(static_cast<uint16_t>(cigar.size()));
+        append(flag);
+        append(l_seq);
+        append(static_cast<int32_t>(-1));                           // next_refID
+        append(static_cast<int32_t>(-1));                           // next_pos
+        append(static_cast<int32_t>(0));                            // tlen
+        data.append(name.c_str(), name.size() + 1);
+        for (uint32_t const op : cigar)
+            append(op);
+        static constexpr uint8_t bases[] = {1, 2, 4, 8};              // A, C, G, T
+        for (int32_t j = 0; j < (l_seq + 1) / 2; ++j)
+            data.push_back(static_cast<char>(bases[(j * 7) % 4] << 4 | bases[(j * 5 + i) % 4]));
+        data.append(l_seq, '\xff');                                 // no base qualities
+        data.append(aux);
+    }
+
+    // BGZF blocks of at most 0xff00 bytes of uncompressed data, followed by the empty EOF block.
+    std::ofstream out{path, std::ios::binary};
+    auto write_block = [&out] (char const * block_data, size_t const block_length)
+    {
+        std::vector<char> compressed(compressBound(block_length) + 64);
+        z_stream stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(block_data));
+        stream.avail_in = block_length;
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = compressed.size();
+        deflate(&stream, Z_FINISH);
+        size_t const compressed_length = stream.total_out;
+        deflateEnd(&stream);
+
+        uint32_t const crc = crc32(crc32(0, nullptr, 0), reinterpret_cast<Bytef const *>(block_data), block_length);
+        uint16_t const bsize = compressed_length + 25;
+        uint32_t const isize = block_length;
+        char const header[] = {31, static_cast<char>(139), 8, 4, 0, 0, 0, 0, 0, static_cast<char>(255), 6, 0,
+                               'B', 'C', 2, 0};
+        out.write(header, sizeof(header));
+        out.write(reinterpret_cast<char const *>(&bsize), sizeof(bsize));
+        out.write(compressed.data(), compressed_length);
+        out.write(reinterpret_cast<char const *>(&crc), sizeof(crc));
+        out.write(reinterpret_cast<char const *>(&isize), sizeof(isize));
+    };
+    for (size_t offset = 0; offset < data.size(); offset += 0xff00)
+        write_block(data.data() + offset, std::min<size_t>(0xff00, data.size() - offset));
+    write_block(nullptr, 0);
+}
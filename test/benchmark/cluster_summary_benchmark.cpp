@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <random>
+#include <sstream>
+
+#include "structures/cluster.hpp"   // for class Cluster
+
+// Average position of the first or second mates, computed on every call like the previous getters.
+int32_t average_position(Cluster const & cluster, bool const first_mate)
+{
+    uint64_t sum_positions = 0;
+    for (Junction const & junction : cluster.get_members())
+        sum_positions += (first_mate ? junction.get_mate1() : junction.get_mate2()).position;
+    return std::round(static_cast<double>(sum_positions) / cluster.get_cluster_size());
+}
+
+int32_t average_inserted_size(Cluster const & cluster)
+{
+    uint64_t sum_sizes = 0;
+    for (Junction const & junction : cluster.get_members())
+        sum_sizes += junction.inserted_size();
+    return std::round(static_cast<double>(sum_sizes) / cluster.get_cluster_size());
+}
+
+bool less_by_recomputed_summary(Cluster const & lhs, Cluster const & rhs)
+{
+    Breakend const lhs_mate1{lhs.get_members()[0].get_mate1().seq_id, average_position(lhs, true),
+                             lhs.get_members()[0].get_mate1().orientation};
+    Breakend const rhs_mate1{rhs.get_members()[0].get_mate1().seq_id, average_position(rhs, true),
+                             rhs.get_members()[0].get_mate1().orientation};
+    if (lhs_mate1 != rhs_mate1)
+        return lhs_mate1 < rhs_mate1;
+    Breakend const lhs_mate2{lhs.get_members()[0].get_mate2().seq_id, average_position(lhs, false),
+                             lhs.get_members()[0].get_mate2().orientation};
+    Breakend const rhs_mate2{rhs.get_members()[0].get_mate2().seq_id, average_position(rhs, false),
+                             rhs.get_members()[0].get_mate2().orientation};
+    if (lhs_mate2 != rhs_mate2)
+        return lhs_mate2 < rhs_mate2;
+    return average_inserted_size(lhs) < average_inserted_size(rhs);
+}
+
+bool less_by_cached_summary(Cluster const & lhs, Cluster const & rhs)
+{
+    return lhs < rhs;
+}
+
+// Clusters of deletions with the given number of members each, many of them at the same position.
+std::vector<Cluster> generate_clusters(size_t const num_clusters, size_t const num_members)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> position{0, 1000};
+    std::uniform_int_distribution<int32_t> offset{-10, 10};
+    std::vector<Cluster> clusters{};
+    for (size_t i = 0; i < num_clusters; ++i)
+    {
+        int32_t const start = 100 * position(generator);
+        std::vector<Junction> members{};
+        for (size_t j = 0; j < num_members; ++j)
+        {
+            members.emplace_back(Breakend{"chr1", start + offset(generator), strand::forward},
+                                 Breakend{"chr1", start + 5000 + offset(generator), strand::forward},
+                                 seqan3::dna5_vector(j % 20), "read" + std::to_string(j));
+        }
+        clusters.emplace_back(std::move(members));
+    }
+    return clusters;
+}
+
+template <auto less>
+static void sort_clusters(benchmark::State & state)
+{
+    std::vector<Cluster> const clusters = generate_clusters(state.range(0), state.range(1));
+    std::vector<Cluster> sorted{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        sorted = clusters;
+        state.ResumeTiming();
+        std::sort(sorted.begin(), sorted.end(), less);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+BENCHMARK_TEMPLATE(sort_clusters, less_by_recomputed_summary)->ArgNames({"clusters", "members"})->Args({2000, 500})
+                                                             ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(sort_clusters, less_by_cached_summary)->ArgNames({"clusters", "members"})->Args({2000, 500})
+                                                         ->Unit(benchmark::kMillisecond);
+
+// Writing the clusters like the -b option, which prints the summary of every cluster.
+static void write_clusters(benchmark::State & state)
+{
+    std::vector<Cluster> const clusters = generate_clusters(state.range(0), state.range(1));
+    for (auto _ : state)
+    {
+        std::ostringstream out{};
+        for (Cluster const & cluster : clusters)
+            out << cluster << '\n';
+        benchmark::DoNotOptimize(out.str().data());
+    }
+}
+BENCHMARK(write_clusters)->ArgNames({"clusters", "members"})->Args({2000, 500})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>     // for std::lround
+#include <random>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"   // for hierarchical_clustering_method()
+
+// One partition of junctions from a repeat region: deletions every 30bp, each supported by 50 reads with small
+// differences of the positions and the inserted sequence sizes, so that neighboring deletions almost touch.
+std::vector<Junction> generate_repeat_partition(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{-4, 4};
+    std::uniform_int_distribution<size_t> insertion_length{0, 8};
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_junctions);
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        int32_t const start = 1000000 + 30 * static_cast<int32_t>(i / 50);
+        junctions.emplace_back(Breakend{"chr1", start + offset(generator), strand::forward},
+                               Breakend{"chr1", start + 5000 + offset(generator), strand::forward},
+                               seqan3::dna5_vector(insertion_length(generator)),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// One partition of junctions from a single locus with a very high coverage.
+std::vector<Junction> generate_locus_partition(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{-10, 10};
+    std::uniform_int_distribution<size_t> insertion_length{0, 20};
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_junctions);
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        junctions.emplace_back(Breakend{"chr1", 1000000 + offset(generator), strand::forward},
+                               Breakend{"chr1", 1005000 + offset(generator), strand::forward},
+                               seqan3::dna5_vector(insertion_length(generator)),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// One partition of junctions from a single locus whose breakpoints and inserted sequence sizes vary widely, e.g. in a
+// repeat with a variable number of copies. Unlike generate_locus_partition(), the number of distinct junctions keeps
+// growing with the number of junctions, so the clusters and their neighborhoods grow as well.
+std::vector<Junction> generate_spread_locus_partition(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::normal_distribution<double> offset{0.0, 30.0};
+    std::uniform_int_distribution<size_t> insertion_length{0, 50};
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_junctions);
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        junctions.emplace_back(Breakend{"chr1", 1000000 + static_cast<int32_t>(std::lround(offset(generator))),
+                                        strand::forward},
+                               Breakend{"chr1", 1005000 + static_cast<int32_t>(std::lround(offset(generator))),
+                                        strand::forward},
+                               seqan3::dna5_vector(insertion_length(generator)),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// Hierarchical clustering of a single partition, which is clustered with the sparse average linkage if it is larger
+// than 200 junctions. Reports the memory the full distance matrix would need.
+template <auto generate_partition>
+static void cluster_partition(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_partition(state.range(0));
+    size_t num_clusters = 0;
+    for (auto _ : state)
+    {
+        std::vector<Cluster> const clusters = hierarchical_clustering_method(junctions, 10);
+        num_clusters = clusters.size();
+        benchmark::DoNotOptimize(clusters.data());
+    }
+    state.counters["clusters"] = num_clusters;
+    state.counters["distance_matrix_MiB"] = junctions.size() * (junctions.size() - 1) / 2 * sizeof(double) / 1048576.0;
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(cluster_partition, generate_repeat_partition)->ArgName("junctions")->RangeMultiplier(10)
+                                                                ->Range(1000, 1000000)->Unit(benchmark::kMillisecond)
+                                                                ->Complexity(benchmark::oNLogN);
+BENCHMARK_TEMPLATE(cluster_partition, generate_locus_partition)->ArgName("junctions")->RangeMultiplier(10)
+                                                               ->Range(1000, 1000000)->Unit(benchmark::kMillisecond)
+                                                               ->Complexity(benchmark::oNLogN);
+BENCHMARK_TEMPLATE(cluster_partition, generate_spread_locus_partition)->ArgName("junctions")->RangeMultiplier(10)
+                                                                      ->Range(1000, 100000)
+                                                                      ->Unit(benchmark::kMillisecond)
+                                                                      ->Complexity(benchmark::oAuto);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"   // for hierarchical_clustering_method()
+
+// Cutoffs of a sweep like the one of the Snakefile.
+std::vector<double> const sweep_cutoffs{10, 20, 50, 100, 200, 500};
+
+// Partitions of 100 junctions of a deep-coverage sample every 100kb, whose breakends vary by up to 30 bases, and one
+// partition of a repeat region with 2000 junctions, which is clustered with the sparse average linkage.
+std::vector<Junction> generate_sweep_junctions()
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{0, 30};
+    std::vector<Junction> junctions{};
+    for (int32_t partition = 0; partition < 500; ++partition)
+    {
+        int32_t const start = 1000000 + 100000 * partition;
+        for (size_t read = 0; read < 100; ++read)
+        {
+            junctions.emplace_back(Breakend{"chr1", start + offset(generator), strand::forward},
+                                   Breakend{"chr1", start + 500 + offset(generator), strand::forward},
+                                   seqan3::dna5_vector(offset(generator)),
+                                   "m" + std::to_string(read) + "/1/CCS");
+        }
+    }
+    for (int32_t i = 0; i < 2000; ++i)
+    {
+        int32_t const start = 200000 + 30 * (i / 50);
+        junctions.emplace_back(Breakend{"chr1", start + offset(generator) / 4, strand::forward},
+                               Breakend{"chr1", start + 5000 + offset(generator) / 4, strand::forward},
+                               seqan3::dna5_vector(offset(generator) / 4),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// Hierarchical clustering at the first `num_cutoffs` cutoffs of the sweep, one clustering per cutoff.
+static void cluster_every_cutoff(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_sweep_junctions();
+    size_t const num_cutoffs = state.range(0);
+    for (auto _ : state)
+    {
+        for (size_t k = 0; k < num_cutoffs; ++k)
+        {
+            std::vector<Cluster> const clusters = hierarchical_clustering_method(junctions, sweep_cutoffs[k]);
+            benchmark::DoNotOptimize(clusters.data());
+        }
+    }
+}
+BENCHMARK(cluster_every_cutoff)->ArgName("cutoffs")->Arg(1)->Arg(3)->Arg(6)->Unit(benchmark::kMillisecond);
+
+// Hierarchical clustering at the first `num_cutoffs` cutoffs of the sweep at once, with one dendrogram per partition,
+// which is cut at every cutoff.
+static void cluster_all_cutoffs_at_once(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_sweep_junctions();
+    std::vector<double> const clustering_cutoffs(sweep_cutoffs.begin(), sweep_cutoffs.begin() + state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<std::vector<Cluster>> const clusters = hierarchical_clustering_method(junctions,
+                                                                                          clustering_cutoffs);
+        benchmark::DoNotOptimize(clusters.data());
+    }
+}
+BENCHMARK(cluster_all_cutoffs_at_once)->ArgName("cutoffs")->Arg(1)->Arg(3)->Arg(6)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "modules/clustering/distance_kernel.hpp"                   // for condensed_distances()
+#include "modules/clustering/hierarchical_clustering_method.hpp"    // for junction_distance()
+
+// Junctions of one partition: deletions with small insertions around the same position.
+std::vector<Junction> generate_partition(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{-25, 25};
+    std::uniform_int_distribution<size_t> insertion_length{0, 300};
+    std::vector<Junction> junctions{};
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        junctions.emplace_back(Breakend{"chr1", 1000000 + offset(generator), strand::forward},
+                               Breakend{"chr1", 1005000 + offset(generator), strand::forward},
+                               seqan3::dna5_vector(insertion_length(generator)),
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// The previous loop over all pairs of junctions.
+static void junction_distance_loop(benchmark::State & state)
+{
+    std::vector<Junction> const partition = generate_partition(state.range(0));
+    std::vector<double> distmat(partition.size() * (partition.size() - 1) / 2);
+    for (auto _ : state)
+    {
+        size_t k = 0;
+        for (size_t i = 0; i < partition.size(); ++i)
+            for (size_t j = i + 1; j < partition.size(); ++j)
+                distmat[k++] = junction_distance(partition[i], partition[j]);
+        benchmark::DoNotOptimize(distmat.data());
+    }
+    state.counters["pairs"] = benchmark::Counter(distmat.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(junction_distance_loop)->ArgName("junctions")->Arg(50)->Arg(200);
+
+// Loading the coordinates of the partition and computing the distances with one of the kernels.
+template <distance_kernel kernel>
+static void kernel_distances(benchmark::State & state)
+{
+    if (kernel > best_distance_kernel())
+    {
+        state.SkipWithError("Kernel not supported by the CPU");
+        return;
+    }
+    std::vector<Junction> const partition = generate_partition(state.range(0));
+    junction_coordinates coordinates{};
+    std::vector<double> distmat{};
+    for (auto _ : state)
+    {
+        load_coordinates(partition, coordinates);
+        condensed_distances(coordinates, distmat, kernel);
+        benchmark::DoNotOptimize(distmat.data());
+    }
+    state.counters["pairs"] = benchmark::Counter(distmat.size(), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(kernel_distances, distance_kernel::scalar)->ArgName("junctions")->Arg(50)->Arg(200);
+BENCHMARK_TEMPLATE(kernel_distances, distance_kernel::sse2)->ArgName("junctions")->Arg(50)->Arg(200);
+BENCHMARK_TEMPLATE(kernel_distances, distance_kernel::avx2)->ArgName("junctions")->Arg(50)->Arg(200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <new>
+#include <random>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"   // for junction_distance()
+#include "structures/cluster.hpp"                                   // for class Cluster
+
+// Counts the heap allocations of the benchmarked code.
+std::atomic<size_t> num_allocations{0};
+
+void * operator new(size_t const size)
+{
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void * pointer = std::malloc(size))
+        return pointer;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void * pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void * pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Junctions of one partition: deletions with small insertions around the same position.
+std::vector<Junction> generate_partition(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> offset{-25, 25};
+    std::uniform_int_distribution<size_t> insertion_length{0, 300};
+    std::vector<Junction> junctions{};
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        seqan3::dna5_vector const inserted_sequence(insertion_length(generator));
+        junctions.emplace_back(Breakend{"chr1", 1000000 + offset(generator), strand::forward},
+                               Breakend{"chr1", 1005000 + offset(generator), strand::forward},
+                               inserted_sequence,
+                               "m" + std::to_string(i) + "/1/CCS");
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// Distance of two junctions with copies of the inserted sequences, like the previous accessors.
+int junction_distance_by_copy(Junction const & lhs, Junction const & rhs)
+{
+    Breakend const lhs_mate1 = lhs.get_mate1();
+    Breakend const rhs_mate1 = rhs.get_mate1();
+    Breakend const lhs_mate2 = lhs.get_mate2();
+    Breakend const rhs_mate2 = rhs.get_mate2();
+    return std::abs(lhs_mate1.position - rhs_mate1.position) + std::abs(lhs_mate2.position - rhs_mate2.position) +
+           std::abs((int)(lhs.get_inserted_sequence().size() - rhs.get_inserted_sequence().size()));
+}
+
+// The condensed distance matrix of a partition, as computed for the hierarchical clustering.
+template <auto distance>
+static void distance_matrix(benchmark::State & state)
+{
+    std::vector<Junction> const partition = generate_partition(state.range(0));
+    std::vector<double> distmat(partition.size() * (partition.size() - 1) / 2);
+    size_t const allocations_before = num_allocations.load();
+    for (auto _ : state)
+    {
+        size_t k = 0;
+        for (size_t i = 0; i < partition.size(); ++i)
+            for (size_t j = i + 1; j < partition.size(); ++j)
+                distmat[k++] = distance(partition[i], partition[j]);
+        benchmark::DoNotOptimize(distmat.data());
+    }
+    state.counters["allocations"] = benchmark::Counter(num_allocations.load() - allocations_before,
+                                                       benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(distance_matrix, junction_distance_by_copy)->ArgName("junctions")->Arg(200);
+BENCHMARK_TEMPLATE(distance_matrix, junction_distance)->ArgName("junctions")->Arg(200);
+
+// Comparison of two clusters with copies of their members, like the previous operator==.
+bool cluster_equal_by_copy(Cluster const & lhs, Cluster const & rhs)
+{
+    std::vector<Junction> lhs_members = lhs.get_members();
+    std::sort(lhs_members.begin(), lhs_members.end());
+    std::vector<Junction> rhs_members = rhs.get_members();
+    std::sort(rhs_members.begin(), rhs_members.end());
+    return lhs_members == rhs_members;
+}
+
+bool cluster_equal(Cluster const & lhs, Cluster const & rhs)
+{
+    return lhs == rhs;
+}
+
+template <auto equal>
+static void compare_clusters(benchmark::State & state)
+{
+    Cluster const lhs{generate_partition(state.range(0))};
+    Cluster const rhs{generate_partition(state.range(0))};
+    size_t const allocations_before = num_allocations.load();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(equal(lhs, rhs));
+    state.counters["allocations"] = benchmark::Counter(num_allocations.load() - allocations_before,
+                                                       benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(compare_clusters, cluster_equal_by_copy)->ArgName("members")->Arg(200);
+BENCHMARK_TEMPLATE(compare_clusters, cluster_equal)->ArgName("members")->Arg(200);
+
+// Average mates and inserted sequence size of a cluster, as computed for the VCF output.
+static void cluster_averages(benchmark::State & state)
+{
+    Cluster const cluster{generate_partition(state.range(0))};
+    size_t const allocations_before = num_allocations.load();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cluster.get_average_mate1());
+        benchmark::DoNotOptimize(cluster.get_average_mate2());
+        benchmark::DoNotOptimize(cluster.get_average_inserted_sequence_size());
+    }
+    state.counters["allocations"] = benchmark::Counter(num_allocations.load() - allocations_before,
+                                                       benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(cluster_averages)->ArgName("members")->Arg(200);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"   // for hierarchical_clustering_method()
+#include "modules/clustering/junction_compaction.hpp"              // for compact_junctions()
+
+// Partitions of a deep-coverage sample: deletions every 100kb, each supported by `coverage` reads. Most reads report
+// the exact breakends, the others are off by a few bases.
+std::vector<Junction> generate_deep_coverage_junctions(size_t const num_partitions, size_t const coverage)
+{
+    std::mt19937 generator{42};
+    std::discrete_distribution<int32_t> offset{{1, 2, 20, 2, 1}};
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_partitions * coverage);
+    for (size_t partition = 0; partition < num_partitions; ++partition)
+    {
+        int32_t const start = 1000000 + 100000 * static_cast<int32_t>(partition);
+        for (size_t read = 0; read < coverage; ++read)
+        {
+            junctions.emplace_back(Breakend{"chr1", start + offset(generator) - 2, strand::forward},
+                                   Breakend{"chr1", start + 500 + offset(generator) - 2, strand::forward},
+                                   seqan3::dna5_vector(offset(generator)),
+                                   "m" + std::to_string(read) + "/1/CCS");
+        }
+    }
+    std::sort(junctions.begin(), junctions.end());
+    return junctions;
+}
+
+// Hierarchical clustering of 1000 partitions with identical junctions collapsed (tolerance 0) and with nearly
+// identical junctions collapsed as well. Reports the number of representatives per partition.
+static void cluster_compacted_junctions(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_deep_coverage_junctions(1000, state.range(0));
+    int32_t const tolerance = state.range(1);
+    for (auto _ : state)
+    {
+        std::vector<Cluster> const clusters = hierarchical_clustering_method(junctions, 10, 1, tolerance);
+        benchmark::DoNotOptimize(clusters.data());
+    }
+    state.counters["representatives"] = compact_junctions(std::span{junctions}.first(state.range(0)), tolerance).size();
+}
+BENCHMARK(cluster_compacted_junctions)->ArgNames({"coverage", "tolerance"})
+                                      ->ArgsProduct({{50, 200, 1000}, {0, 1, 2}})
+                                      ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
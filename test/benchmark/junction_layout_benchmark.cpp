@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <malloc.h>     // for mallinfo2
+
+#include <random>
+
+#include "modules/clustering/hierarchical_clustering_method.hpp"   // for hierarchical_clustering_method()
+#include "structures/junction.hpp"                                  // for class Junction
+
+using seqan3::operator""_dna5;
+
+// The previous junction layout with an own allocation for the inserted sequence and the read name.
+struct allocating_junction
+{
+    Breakend mate1{};
+    Breakend mate2{};
+    seqan3::dna5_vector inserted_sequence{};
+    std::string read_name{};
+
+    friend bool operator<(allocating_junction const & lhs, allocating_junction const & rhs)
+    {
+        return lhs.mate1 != rhs.mate1
+               ? lhs.mate1 < rhs.mate1
+               : lhs.mate2 != rhs.mate2
+                 ? lhs.mate2 < rhs.mate2
+                 : lhs.inserted_sequence < rhs.inserted_sequence;
+    }
+};
+
+// Deletions and insertions of long reads: every read gives rise to 4 junctions, a third of them are insertions.
+template <typename junction_t>
+std::vector<junction_t> generate_junctions(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> position{0, 100000000};
+    std::uniform_int_distribution<size_t> insertion_length{50, 500};
+    std::uniform_int_distribution<uint8_t> base{0, 3};
+    std::string const chromosomes[]{"chr1", "chr2", "chr3"};
+    std::vector<junction_t> junctions{};
+    junctions.reserve(num_junctions);
+    std::string read_name{};
+    seqan3::dna5_vector inserted_sequence{};
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        if (i % 4 == 0)
+            read_name = "m" + std::to_string(i) + "/" + std::to_string(i % 7919) + "/CCS";
+        inserted_sequence.clear();
+        if (i % 3 == 0)
+        {
+            inserted_sequence.resize(insertion_length(generator));
+            for (seqan3::dna5 & b : inserted_sequence)
+                b.assign_rank(base(generator));
+        }
+        Breakend mate1{chromosomes[i % 3], position(generator), strand::forward};
+        Breakend mate2{chromosomes[i % 3], mate1.position + 1 + (i % 5) * 100, strand::forward};
+        if constexpr (std::same_as<junction_t, Junction>)
+            junctions.emplace_back(mate1, mate2, inserted_sequence, read_name);
+        else
+            junctions.push_back(junction_t{mate1, mate2, inserted_sequence, read_name});
+    }
+    return junctions;
+}
+
+// Bytes allocated on the heap (including memory mapped chunks), e.g. for the inserted sequences.
+size_t allocated_bytes()
+{
+    struct mallinfo2 const info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template <typename junction_t>
+static void create_and_sort_junctions(benchmark::State & state)
+{
+    size_t const num_junctions = state.range(0);
+    size_t bytes_per_junction{};
+    for (auto _ : state)
+    {
+        size_t const allocated_before = allocated_bytes();
+        std::vector<junction_t> junctions = generate_junctions<junction_t>(num_junctions);
+        bytes_per_junction = (allocated_bytes() - allocated_before) / num_junctions;
+        std::sort(junctions.begin(), junctions.end());
+        benchmark::DoNotOptimize(junctions.data());
+    }
+    state.counters["bytes_per_junction"] = bytes_per_junction;
+}
+BENCHMARK_TEMPLATE(create_and_sort_junctions, allocating_junction)->ArgName("junctions")->Arg(1000000)
+                                                                   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(create_and_sort_junctions, Junction)->ArgName("junctions")->Arg(1000000)
+                                                       ->Unit(benchmark::kMillisecond);
+
+template <typename junction_t>
+static void sort_junctions(benchmark::State & state)
+{
+    std::vector<junction_t> const junctions = generate_junctions<junction_t>(state.range(0));
+    std::vector<junction_t> sorted{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        sorted = junctions;
+        state.ResumeTiming();
+        std::sort(sorted.begin(), sorted.end());
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+BENCHMARK_TEMPLATE(sort_junctions, allocating_junction)->ArgName("junctions")->Arg(1000000)
+                                                       ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(sort_junctions, Junction)->ArgName("junctions")->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Partitioning and hierarchical clustering of the junctions, which copies them several times.
+static void cluster_junctions(benchmark::State & state)
+{
+    std::vector<Junction> junctions = generate_junctions<Junction>(state.range(0));
+    std::sort(junctions.begin(), junctions.end());
+    for (auto _ : state)
+    {
+        std::vector<Cluster> clusters = hierarchical_clustering_method(junctions, 10);
+        benchmark::DoNotOptimize(clusters.data());
+    }
+}
+BENCHMARK(cluster_junctions)->ArgName("junctions")->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
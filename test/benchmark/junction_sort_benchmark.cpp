@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>    // for std::sort, std::stable_sort
+#include <random>
+#include <string>
+#include <vector>
+
+#include "structures/junction.hpp"          // for class Junction
+#include "structures/junction_sort.hpp"     // for sort_junctions()
+
+// Junctions of long reads from a deep coverage sample: every locus is supported by about 20 reads with a few bases of
+// difference, a third of the junctions are insertions. As in an alignment file sorted by read name, the junctions of a
+// locus are spread over the whole input.
+std::vector<Junction> generate_junctions(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> position{0, 100000000};
+    std::uniform_int_distribution<size_t> locus{0, num_junctions / 20};
+    std::uniform_int_distribution<int32_t> jitter{-5, 5};
+    std::uniform_int_distribution<size_t> insertion_length{50, 500};
+    std::uniform_int_distribution<uint8_t> base{0, 3};
+    std::string const chromosomes[]{"chr1", "chr2", "chr3"};
+    std::vector<int32_t> loci(num_junctions / 20 + 1);
+    for (int32_t & locus_position : loci)
+        locus_position = position(generator);
+
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_junctions);
+    std::string read_name{};
+    seqan3::dna5_vector inserted_sequence{};
+    for (size_t i = 0; i < num_junctions; ++i)
+    {
+        if (i % 4 == 0)
+            read_name = "m" + std::to_string(i) + "/" + std::to_string(i % 7919) + "/CCS";
+        inserted_sequence.clear();
+        if (i % 3 == 0)
+        {
+            inserted_sequence.resize(insertion_length(generator));
+            for (seqan3::dna5 & b : inserted_sequence)
+                b.assign_rank(base(generator));
+        }
+        size_t const l = locus(generator);
+        Breakend mate1{chromosomes[l % 3], loci[l] + jitter(generator), strand::forward};
+        Breakend mate2{chromosomes[l % 3], mate1.position + 1 + static_cast<int32_t>(l % 5) * 100, strand::forward};
+        junctions.emplace_back(mate1, mate2, inserted_sequence, read_name);
+    }
+    return junctions;
+}
+
+enum struct sort_algorithm
+{
+    comparison,
+    stable_comparison,
+    radix
+};
+
+template <sort_algorithm algorithm>
+static void sort_deep_coverage_junctions(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_junctions(state.range(0));
+    size_t const threads = state.range(1);
+    std::vector<Junction> sorted{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        sorted = junctions;
+        state.ResumeTiming();
+        if constexpr (algorithm == sort_algorithm::comparison)
+            std::sort(sorted.begin(), sorted.end());
+        else if constexpr (algorithm == sort_algorithm::stable_comparison)
+            std::stable_sort(sorted.begin(), sorted.end());
+        else
+            sort_junctions(sorted, threads);
+        benchmark::DoNotOptimize(sorted.data());
+    }
+}
+BENCHMARK_TEMPLATE(sort_deep_coverage_junctions, sort_algorithm::comparison)->ArgNames({"junctions", "threads"})
+                                                                            ->Args({1000000, 1})
+                                                                            ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(sort_deep_coverage_junctions, sort_algorithm::stable_comparison)->ArgNames({"junctions", "threads"})
+                                                                                   ->Args({1000000, 1})
+                                                                                   ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(sort_deep_coverage_junctions, sort_algorithm::radix)->ArgNames({"junctions", "threads"})
+                                                                       ->Args({1000000, 1})
+                                                                       ->Args({1000000, 4})
+                                                                       ->Args({1000000, 8})
+                                                                       ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
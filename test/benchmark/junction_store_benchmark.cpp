@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "structures/junction_sort.hpp"     // for sort_junctions()
+#include "structures/junction_store.hpp"    // for write_junction_store(), class junction_store
+
+// Sorted junctions of long reads on 24 chromosomes, every read reports up to 4 junctions with short insertions.
+std::vector<Junction> generate_stored_junctions(size_t const num_junctions)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> chromosome{1, 24};
+    std::uniform_int_distribution<int32_t> position{1, 100000000};
+    std::uniform_int_distribution<size_t> inserted_size{0, 50};
+    std::uniform_int_distribution<size_t> junctions_per_read{1, 4};
+    std::vector<Junction> junctions{};
+    junctions.reserve(num_junctions);
+    for (size_t read = 0; junctions.size() < num_junctions; ++read)
+    {
+        std::string const read_name = "m" + std::to_string(read) + "/" + std::to_string(read % 9973) + "/CCS";
+        for (size_t j = junctions_per_read(generator); j > 0 && junctions.size() < num_junctions; --j)
+        {
+            std::string const chr = "chr" + std::to_string(chromosome(generator));
+            int32_t const start = position(generator);
+            junctions.emplace_back(Breakend{chr, start, strand::forward},
+                                   Breakend{chr, start + 500, strand::forward},
+                                   seqan3::dna5_vector(inserted_size(generator)),
+                                   read_name);
+        }
+    }
+    sort_junctions(junctions);
+    return junctions;
+}
+
+std::map<std::string, int32_t> generate_references_lengths()
+{
+    std::map<std::string, int32_t> references_lengths{};
+    for (int32_t chromosome = 1; chromosome <= 24; ++chromosome)
+        references_lengths.emplace("chr" + std::to_string(chromosome), 200000000);
+    return references_lengths;
+}
+
+// Writing one million junctions to a junction store. Reports the file size per junction.
+static void write_store(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_stored_junctions(state.range(0));
+    std::map<std::string, int32_t> const references_lengths = generate_references_lengths();
+    std::filesystem::path const path{std::filesystem::temp_directory_path()/"junction_store_benchmark.bin"};
+    for (auto _ : state)
+        write_junction_store(path, junctions, references_lengths);
+    state.counters["bytes_per_junction"] = static_cast<double>(std::filesystem::file_size(path)) / junctions.size();
+    std::filesystem::remove(path);
+}
+BENCHMARK(write_store)->ArgName("junctions")->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// Mapping a junction store of one million junctions and creating the junctions, which refer to the mapped inserted
+// sequences and read names, as --input_junction_store does before the clustering.
+static void load_store(benchmark::State & state)
+{
+    std::vector<Junction> const junctions = generate_stored_junctions(state.range(0));
+    std::filesystem::path const path{std::filesystem::temp_directory_path()/"junction_store_benchmark.bin"};
+    write_junction_store(path, junctions, generate_references_lengths());
+    for (auto _ : state)
+    {
+        junction_store const store{path};
+        std::vector<Junction> const stored_junctions = store.junctions();
+        benchmark::DoNotOptimize(stored_junctions.data());
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(load_store)->ArgName("junctions")->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+#include "modules/sv_detection_methods/analyze_sa_tag_method.hpp"   // for parse_sa_tag()
+
+// Previous SA tag parser based on std::stringstream, std::stoi and seqan3::detail::parse_cigar.
+void retrieve_aligned_segments_stringstream(std::string const & sa_string,
+                                            std::vector<AlignedSegment> & aligned_segments)
+{
+    std::vector<std::string> sa_tags{};
+    split_string(sa_string, sa_tags, ';');
+    for (std::string sa_tag : sa_tags)
+    {
+        std::vector<std::string> fields {};
+        split_string(sa_tag, fields, ',');
+        if (fields.size() == 6)
+        {
+            std::string ref_name = fields[0];
+            int32_t pos = std::stoi(fields[1]) - 1;
+            strand orientation;
+            if (fields[2] == "+")
+                orientation = strand::forward;
+            else if (fields[2] == "-")
+                orientation = strand::reverse;
+            else
+                continue;
+            std::vector<seqan3::cigar> cigar_vector = std::get<0>(seqan3::detail::parse_cigar(fields[3]));
+            int32_t mapq = std::stoi(fields[4]);
+            aligned_segments.push_back(AlignedSegment{orientation, ref_name, pos, mapq, cigar_vector});
+        }
+    }
+}
+
+// SA tag with the given number of segments of an ultra long read, each with a CIGAR string of 5 operations.
+std::string generate_sa_tag(size_t const num_segments)
+{
+    std::string sa_tag{};
+    for (size_t i = 0; i < num_segments; ++i)
+    {
+        sa_tag += "chr" + std::to_string(i % 22 + 1) + "," + std::to_string(1000000 + 7919 * i) +
+                  ((i % 3) ? ",+," : ",-,") + std::to_string(5000 * i) + "S2000M34I3000M" +
+                  std::to_string(5000 * (num_segments - i)) + "S,60," + std::to_string(i) + ";";
+    }
+    return sa_tag;
+}
+
+static void stringstream_parser(benchmark::State & state)
+{
+    std::string const sa_tag = generate_sa_tag(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<AlignedSegment> aligned_segments{};
+        retrieve_aligned_segments_stringstream(sa_tag, aligned_segments);
+        benchmark::DoNotOptimize(aligned_segments.data());
+    }
+    state.counters["segments_per_second"] = benchmark::Counter(state.iterations() * state.range(0),
+                                                               benchmark::Counter::kIsRate);
+}
+BENCHMARK(stringstream_parser)->ArgName("segments")->Arg(2)->Arg(10)->Arg(50);
+
+static void from_chars_parser(benchmark::State & state)
+{
+    std::string const sa_tag = generate_sa_tag(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<AlignedSegment> aligned_segments{};
+        retrieve_aligned_segments(sa_tag, aligned_segments);
+        benchmark::DoNotOptimize(aligned_segments.data());
+    }
+    state.counters["segments_per_second"] = benchmark::Counter(state.iterations() * state.range(0),
+                                                               benchmark::Counter::kIsRate);
+}
+BENCHMARK(from_chars_parser)->ArgName("segments")->Arg(2)->Arg(10)->Arg(50);
+
+// The buffer is reused for all SA tags like in analyze_sa_tag(), so there are no allocations after the first tag.
+static void from_chars_parser_reused_buffer(benchmark::State & state)
+{
+    std::string const sa_tag = generate_sa_tag(state.range(0));
+    std::vector<AlignedSegment> aligned_segments{};
+    for (auto _ : state)
+    {
+        size_t const num_segments = parse_sa_tag(sa_tag, aligned_segments, 0);
+        benchmark::DoNotOptimize(num_segments);
+    }
+    state.counters["segments_per_second"] = benchmark::Counter(state.iterations() * state.range(0),
+                                                               benchmark::Counter::kIsRate);
+}
+BENCHMARK(from_chars_parser_reused_buffer)->ArgName("segments")->Arg(2)->Arg(10)->Arg(50);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <random>
+
+#include "variant_detection/variant_output.hpp"     // for output_variants()
+#include "variant_detection/vcf_record_writer.hpp"  // for class vcf_record_writer
+#include "variant_parser/variant_record.hpp"        // for class variant_record
+
+// The fields of a deletion or insertion record.
+struct sv_fields
+{
+    std::string chrom;
+    uint64_t pos;
+    std::string sv_type;
+    float qual;
+    int32_t end;
+    int32_t sv_len;
+};
+
+// Records of a dense call set: deletions and insertions every few hundred bases on 24 chromosomes.
+std::vector<sv_fields> generate_records(size_t const num_records)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> length{30, 5000};
+    std::uniform_int_distribution<int32_t> support{1, 60};
+    std::vector<sv_fields> records{};
+    records.reserve(num_records);
+    for (size_t i = 0; i < num_records; ++i)
+    {
+        bool const deletion = i % 3 != 0;
+        int32_t const pos = 10000 + 300 * static_cast<int32_t>(i % 500000);
+        int32_t const sv_len = length(generator);
+        records.push_back(sv_fields{"chr" + std::to_string(1 + i / 500000 % 24),
+                                    static_cast<uint64_t>(pos + 1),
+                                    deletion ? "DEL" : "INS",
+                                    static_cast<float>(support(generator)),
+                                    deletion ? pos + sv_len : pos + 1,
+                                    deletion ? -sv_len + 1 : sv_len});
+    }
+    return records;
+}
+
+// One million records written to /dev/null with a variant_record per record, like the previous output_variants().
+static void write_variant_records(benchmark::State & state)
+{
+    std::vector<sv_fields> const records = generate_records(1000000);
+    std::ofstream out_stream{"/dev/null"};
+    for (auto _ : state)
+    {
+        for (sv_fields const & fields : records)
+        {
+            variant_record tmp{};
+            tmp.set_chrom(fields.chrom);
+            tmp.set_qual(fields.qual);
+            tmp.set_alt("<" + fields.sv_type + ">");
+            tmp.add_info("SVTYPE", fields.sv_type);
+            tmp.set_pos(fields.pos);
+            tmp.add_info("SVLEN", std::to_string(fields.sv_len));
+            tmp.add_info("END", std::to_string(fields.end));
+            tmp.print(out_stream);
+        }
+        out_stream.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(write_variant_records)->Unit(benchmark::kMillisecond);
+
+// One million records written to /dev/null with the vcf_record_writer, with buffers of 4KiB to 4MiB.
+static void write_with_vcf_record_writer(benchmark::State & state)
+{
+    std::vector<sv_fields> const records = generate_records(1000000);
+    std::ofstream out_stream{"/dev/null"};
+    for (auto _ : state)
+    {
+        vcf_record_writer writer{out_stream, static_cast<size_t>(state.range(0))};
+        for (sv_fields const & fields : records)
+            writer.write_record(fields.chrom, fields.pos, fields.sv_type, fields.qual, fields.end, fields.sv_len);
+        writer.flush();
+        out_stream.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(write_with_vcf_record_writer)->ArgName("buffer_size")->RangeMultiplier(32)->Range(1 << 12, 1 << 22)
+                                       ->Unit(benchmark::kMillisecond);
+
+// output_variants() for 200000 clusters of deletions with 1 to 60 members each, which all pass the filters.
+static void output_variants_of_clusters(benchmark::State & state)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int32_t> length{30, 5000};
+    std::uniform_int_distribution<size_t> support{1, 60};
+    std::vector<Cluster> clusters{};
+    for (int32_t i = 0; i < 200000; ++i)
+    {
+        int32_t const pos = 10000 + 300 * i;
+        Junction const junction{Breakend{"chr1", pos, strand::forward},
+                                Breakend{"chr1", pos + length(generator), strand::forward},
+                                seqan3::dna5_vector{},
+                                "m" + std::to_string(i) + "/1/CCS"};
+        clusters.emplace_back(std::vector<Junction>(support(generator), junction));
+    }
+    cmd_arguments const args{};
+    std::ofstream out_stream{"/dev/null"};
+    for (auto _ : state)
+    {
+        output_variants(clusters, args, out_stream);
+        out_stream.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * clusters.size());
+}
+BENCHMARK(output_variants_of_clusters)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -10,6 +10,9 @@ std::string const default_alignment_long_reads_file_path = "simulated.minimap2.h
 std::string const vcf_out_file_path = "variants_file_out.vcf";
 std::string const junctions_out_file_path = "junctions_file_out.txt";
 std::string const clusters_out_file_path = "clusters_file_out.txt";
+std::string const junction_store_file_path = "junction_store_out.bin";
+std::string const cluster_checkpoint_file_path = "cluster_checkpoint_out.bin";
+std::string const sweep_output_directory = "sweep_out";
 
 std::string const help_page_part_1
 {
@@ -46,6 +49,12 @@ std::string const help_page_part_1
     "    -s, --vcf_sample_name (std::string)\n"
     "          Specify your sample name for the vcf header line. Default: MYSAMPLE.\n"
     "    -t, --threads (signed 16 bit integer)\n"
+    "          Specify the number of threads used for the junction detection and the\n"
+    "          clustering. Indexed long read BAM files are split into regions, which\n"
+    "          are analyzed in parallel. Otherwise, batches of alignments are\n"
+    "          analyzed in parallel. The partitions of the hierarchical clustering\n"
+    "          are clustered in parallel. Default: 1.\n"
+    "    --decompression_threads (signed 16 bit integer)\n"
     "          Specify the number of decompression threads used for reading BAM\n"
     "          files. Default: 1.\n"
 };
@@ -72,6 +81,10 @@ std::string const help_page_part_2
 
 std::string const help_page_advanced
 {
+    "    -g, --region_size (signed 32 bit integer)\n"
+    "          Specify the size of the regions for the parallel analysis of indexed\n"
+    "          long read BAM files. 0 splits the genome by chromosome only. This\n"
+    "          value needs to be non-negative. Default: 10000000.\n"
     "    -a, --junctions (std::filesystem::path)\n"
     "          The path of the optional junction output file. If no path is given,\n"
     "          junctions will not be output. Default: \"\". Write permissions must be\n"
@@ -80,6 +93,34 @@ std::string const help_page_advanced
     "          The path of the optional cluster output file. If no path is given,\n"
     "          clusters will not be output. Default: \"\". Write permissions must be\n"
     "          granted.\n"
+    "    --junction_store (std::filesystem::path)\n"
+    "          The path of the optional binary junction store. If a path is given,\n"
+    "          the sorted junctions are stored with their reference sequences, so\n"
+    "          that they can be clustered again with --input_junction_store without\n"
+    "          analyzing the alignment files. Default: \"\". Write permissions must be\n"
+    "          granted.\n"
+    "    --input_junction_store (std::filesystem::path)\n"
+    "          Cluster the junctions of a binary junction store written with\n"
+    "          --junction_store instead of detecting junctions in alignment files,\n"
+    "          so that only the partitioning, the clustering and the output are run.\n"
+    "          Default: \"\". The input file must exist and read permissions must be\n"
+    "          granted.\n"
+    "    --cluster_checkpoint (std::filesystem::path)\n"
+    "          The path of the optional binary cluster checkpoint. If a path is\n"
+    "          given, the members of the clusters are stored as indices into the\n"
+    "          junction store of --junction_store or --input_junction_store together\n"
+    "          with the summaries of the clusters, so that the output can be\n"
+    "          repeated with --resume_from clusters. Default: \"\". Write permissions\n"
+    "          must be granted.\n"
+    "    --resume_from (resume_stages)\n"
+    "          Resume a previous run from its junction store, given with\n"
+    "          --input_junction_store, and its cluster checkpoint, given with\n"
+    "          --cluster_checkpoint, instead of analyzing the alignment files. Value\n"
+    "          must be one of [0,none,1,junctions,2,clusters]. From junctions, the\n"
+    "          stored junctions are clustered again. From clusters, only the variants\n"
+    "          of the stored clusters are output, so that e.g. --min_qual,\n"
+    "          --max_var_length or --max_tol_inserted_length can be changed without\n"
+    "          clustering. Default: none.\n"
     "    -d, --method (List of detection_methods)\n"
     "          Choose the detection method(s) to be used. Value must be one of\n"
     "          (method name or number)\n"
@@ -117,6 +158,46 @@ std::string const help_page_advanced
     "    -w, --hierarchical_clustering_cutoff (double)\n"
     "          Specify the distance cutoff for the hierarchical clustering. This\n"
     "          value needs to be non-negative. Default: 10.\n"
+    "    --compaction_tolerance (signed 32 bit integer)\n"
+    "          Specify the tolerance for collapsing nearly identical junctions\n"
+    "          before the hierarchical clustering. Junctions whose mate positions\n"
+    "          and inserted sizes each differ by at most this value from a\n"
+    "          representative are clustered as one weighted junction. 0 collapses\n"
+    "          identical junctions only, which does not change the clusters. This\n"
+    "          value needs to be non-negative. Default: 0.\n"
+    "    --streaming\n"
+    "          Cluster the junctions of a long read file while reading it and output\n"
+    "          their variants right away, so that the memory grows with the coverage\n"
+    "          instead of the genome size. The junctions are detected by a single\n"
+    "          thread and the VCF records are sorted by the order of the alignment\n"
+    "          file.\n"
+    "    --by_chromosome\n"
+    "          Analyze an indexed long read BAM file one chromosome at a time:\n"
+    "          detect, cluster and output the variants of a chromosome before the\n"
+    "          next one is read, so that the memory is bounded by the largest\n"
+    "          chromosome instead of the genome size. The VCF records are sorted by\n"
+    "          the order of the BAM header.\n"
+    "    --max_memory (signed 32 bit integer)\n"
+    "          Specify the memory budget in MiB for the junctions. If the junctions\n"
+    "          exceed it, they are sorted and spilled to temporary files in TMPDIR,\n"
+    "          which are merged for the clustering. The long read junctions are then\n"
+    "          detected by a single thread. 0 keeps all junctions in memory. This\n"
+    "          value needs to be non-negative. Default: 0.\n"
+    "    --sweep (List of std::string)\n"
+    "          Sweep a parameter over a list of values, given as\n"
+    "          name=value1,value2,..., and output the variants of every parameter\n"
+    "          combination to an own VCF file in --sweep_output_directory. The long\n"
+    "          read file is read only once. This option can be given multiple times.\n"
+    "          The parameters min_var_length, max_var_length,\n"
+    "          max_tol_inserted_length, max_overlap, min_qual and\n"
+    "          hierarchical_clustering_cutoff can be swept. Default: [].\n"
+    "    --sweep_separately\n"
+    "          Vary one swept parameter at a time, while the other parameters keep\n"
+    "          their given values, instead of combining all values of all swept\n"
+    "          parameters.\n"
+    "    --sweep_output_directory (std::filesystem::path)\n"
+    "          The directory of the VCF files of the parameter sweep. It is created\n"
+    "          if it does not exist. Default: \"\".\n"
 };
 
 // std::string expected_res_default
@@ -336,6 +417,48 @@ TEST_F(iGenVar_cli_test, fail_negative_hierarchical_clustering_cutoff)
     EXPECT_EQ(result.err, expected_err);
 }
 
+TEST_F(iGenVar_cli_test, fail_negative_compaction_tolerance)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j", data(default_alignment_long_reads_file_path),
+                                         "--compaction_tolerance -2");
+    std::string expected_err
+    {
+        "[Error] You gave a negative compaction_tolerance parameter.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_negative_region_size)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j", data(default_alignment_long_reads_file_path),
+                                         "--region_size -30");
+    std::string expected_err
+    {
+        "[Error] You gave a negative region_size parameter.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_no_threads)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j", data(default_alignment_long_reads_file_path),
+                                         "--threads 0");
+    std::string expected_err
+    {
+        "[Error] You need to specify at least one thread.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
 TEST_F(iGenVar_cli_test, with_default_arguments)
 {
     cli_test_result result = execute_app("iGenVar",
@@ -360,6 +483,23 @@ TEST_F(iGenVar_cli_test, with_default_arguments)
     EXPECT_EQ(result.err, expected_err);
 }
 
+TEST_F(iGenVar_cli_test, test_threads_progress_messages)
+{
+    // The regions of the indexed BAM file are analyzed in parallel, but the progress messages are numbered and
+    // ordered like in a serial run.
+    cli_test_result result_serial = execute_app("iGenVar",
+                                                "-j ", data("progress_example.bam"),
+                                                "--threads 1");
+    cli_test_result result_parallel = execute_app("iGenVar",
+                                                  "-j ", data("progress_example.bam"),
+                                                  "--threads 4 --region_size 20000");
+    EXPECT_EQ(result_serial.exit_code, 0);
+    EXPECT_EQ(result_parallel.exit_code, 0);
+    EXPECT_NE(result_serial.err.find("2000 good alignments from long read file.\n"), std::string::npos);
+    EXPECT_EQ(result_parallel.err, result_serial.err);
+    EXPECT_EQ(result_parallel.out, result_serial.out);
+}
+
 TEST_F(iGenVar_cli_test, test_outfile)
 {
     cli_test_result result = execute_app("iGenVar",
@@ -400,6 +540,182 @@ TEST_F(iGenVar_cli_test, test_intermediate_result_output)
     EXPECT_NE(buffer2.str(), "");
 }
 
+TEST_F(iGenVar_cli_test, test_junction_store)
+{
+    cli_test_result result_store = execute_app("iGenVar",
+                                               "-j ", data(default_alignment_long_reads_file_path),
+                                               "--junction_store ", junction_store_file_path);
+    EXPECT_EQ(result_store.exit_code, 0);
+    EXPECT_EQ(result_store.out, expected_res_default);
+
+    // Clustering the stored junctions again gives the same variants without reading the alignment file.
+    cli_test_result result = execute_app("iGenVar", "--input_junction_store ", junction_store_file_path);
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, expected_res_default);
+}
+
+TEST_F(iGenVar_cli_test, test_resume_from_checkpoint)
+{
+    cli_test_result result_checkpoint = execute_app("iGenVar",
+                                                    "-j ", data(default_alignment_long_reads_file_path),
+                                                    "--junction_store ", junction_store_file_path,
+                                                    "--cluster_checkpoint ", cluster_checkpoint_file_path);
+    EXPECT_EQ(result_checkpoint.exit_code, 0);
+    EXPECT_EQ(result_checkpoint.out, expected_res_default);
+
+    cli_test_result result_junctions = execute_app("iGenVar",
+                                                   "--input_junction_store ", junction_store_file_path,
+                                                   "--resume_from junctions");
+    EXPECT_EQ(result_junctions.exit_code, 0);
+    EXPECT_EQ(result_junctions.out, expected_res_default);
+
+    cli_test_result result_clusters = execute_app("iGenVar",
+                                                  "--input_junction_store ", junction_store_file_path,
+                                                  "--cluster_checkpoint ", cluster_checkpoint_file_path,
+                                                  "--resume_from clusters");
+    EXPECT_EQ(result_clusters.exit_code, 0);
+    EXPECT_EQ(result_clusters.out, expected_res_default);
+
+    // A filter of the output is applied to the stored clusters like in a full run.
+    cli_test_result result_min_qual = execute_app("iGenVar",
+                                                  "--input_junction_store ", junction_store_file_path,
+                                                  "--cluster_checkpoint ", cluster_checkpoint_file_path,
+                                                  "--resume_from clusters --min_qual 2");
+    cli_test_result expected_min_qual = execute_app("iGenVar",
+                                                    "-j ", data(default_alignment_long_reads_file_path),
+                                                    "--min_qual 2");
+    EXPECT_EQ(result_min_qual.exit_code, 0);
+    EXPECT_EQ(result_min_qual.out, expected_min_qual.out);
+}
+
+TEST_F(iGenVar_cli_test, fail_resume_from_clusters_without_checkpoint)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "--input_junction_store ", junction_store_file_path,
+                                         "--resume_from clusters");
+    std::string expected_err
+    {
+        "[Error] A run resumed from clusters needs the cluster checkpoint of the previous run, please use "
+        "--cluster_checkpoint.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_resume_from_output_junction_store)
+{
+    // The store of the previous run is read, so it is given as an input file.
+    cli_test_result result = execute_app("iGenVar",
+                                         "--junction_store ", junction_store_file_path,
+                                         "--resume_from junctions");
+    std::string expected_err
+    {
+        "[Error] A resumed run needs the junction store of the previous run, please use --input_junction_store "
+        "instead of --junction_store.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_resume_from_checkpoint_of_other_store)
+{
+    std::string const other_junction_store_file_path = "other_junction_store_out.bin";
+    cli_test_result result_checkpoint = execute_app("iGenVar",
+                                                    "-j ", data(default_alignment_long_reads_file_path),
+                                                    "--junction_store ", junction_store_file_path,
+                                                    "--cluster_checkpoint ", cluster_checkpoint_file_path);
+    EXPECT_EQ(result_checkpoint.exit_code, 0);
+    // The store of another run, without the insertion.
+    cli_test_result result_other_store = execute_app("iGenVar",
+                                                     "-j ", data(default_alignment_long_reads_file_path),
+                                                     "--junction_store ", other_junction_store_file_path,
+                                                     "--min_var_length 2000");
+    EXPECT_EQ(result_other_store.exit_code, 0);
+
+    cli_test_result result = execute_app("iGenVar",
+                                         "--input_junction_store ", other_junction_store_file_path,
+                                         "--cluster_checkpoint ", cluster_checkpoint_file_path,
+                                         "--resume_from clusters");
+    EXPECT_NE(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_NE(result.err.find("it belongs to another junction store"), std::string::npos);
+}
+
+TEST_F(iGenVar_cli_test, test_parameter_sweep)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j ", data(default_alignment_long_reads_file_path),
+                                         "--sweep min_var_length=30,50 --sweep min_qual=1,2",
+                                         "--sweep_output_directory ", sweep_output_directory);
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+
+    // Every combination is identical to a separate run with its parameters.
+    for (std::string const min_var_length : {"30", "50"})
+    {
+        for (std::string const min_qual : {"1", "2"})
+        {
+            cli_test_result expected = execute_app("iGenVar",
+                                                   "-j ", data(default_alignment_long_reads_file_path),
+                                                   "--min_var_length ", min_var_length,
+                                                   "--min_qual ", min_qual);
+            std::ifstream f{sweep_output_directory + "/min_var_length_" + min_var_length + ".min_qual_" +
+                            min_qual + ".vcf"};
+            std::stringstream buffer;
+            buffer << f.rdbuf();
+            EXPECT_TRUE(f.is_open());
+            EXPECT_EQ(buffer.str(), expected.out);
+        }
+    }
+}
+
+TEST_F(iGenVar_cli_test, fail_parameter_sweep_unknown_parameter)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j ", data(default_alignment_long_reads_file_path),
+                                         "--sweep threads=1,2",
+                                         "--sweep_output_directory ", sweep_output_directory);
+    std::string expected_err
+    {
+        "[Error] The parameter threads can not be swept. Value must be one of [min_var_length,max_var_length,"
+        "max_tol_inserted_length,max_overlap,min_qual,hierarchical_clustering_cutoff].\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_parameter_sweep_repeated_value)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j ", data(default_alignment_long_reads_file_path),
+                                         "--sweep hierarchical_clustering_cutoff=10,20,10",
+                                         "--sweep_output_directory ", sweep_output_directory);
+    std::string expected_err
+    {
+        "[Error] The value '10' of the swept parameter hierarchical_clustering_cutoff was given multiple times.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
+TEST_F(iGenVar_cli_test, fail_junction_store_with_alignment_file)
+{
+    cli_test_result result = execute_app("iGenVar",
+                                         "-j ", data(default_alignment_long_reads_file_path),
+                                         "--input_junction_store ", data(default_alignment_long_reads_file_path));
+    std::string expected_err
+    {
+        "[Error] A junction store can not be combined with alignment files.\n"
+    };
+    EXPECT_EQ(result.exit_code, 65280);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected_err);
+}
+
 TEST_F(iGenVar_cli_test, with_detection_method_arguments)
 {
     cli_test_result result = execute_app("iGenVar",
@@ -11,6 +11,29 @@ declare_datasource (FILE simulated.minimap2.hg19.coordsorted_cutoff.sam
                     URL ${CMAKE_SOURCE_DIR}/test/data/simulated.minimap2.hg19.coordsorted_cutoff.sam
                     URL_HASH SHA256=e59b42c85ed309faf8b3d2f1a8e64a9ccd0a47becd1cb291144efd56be0aa4f9)
 
+# copies file to <build>/data/simulated.minimap2.hg19.coordsorted_cutoff.bam
+# BAM version of simulated.minimap2.hg19.coordsorted_cutoff.sam, with the BAI index below.
+declare_datasource (FILE simulated.minimap2.hg19.coordsorted_cutoff.bam
+                    URL ${CMAKE_SOURCE_DIR}/test/data/simulated.minimap2.hg19.coordsorted_cutoff.bam
+                    URL_HASH SHA256=07facf50a4ca9882da9afbd49cc62406e424703bc4ce798cbb3bf9fd25c968c7)
+
+# copies file to <build>/data/simulated.minimap2.hg19.coordsorted_cutoff.bam.bai
+declare_datasource (FILE simulated.minimap2.hg19.coordsorted_cutoff.bam.bai
+                    URL ${CMAKE_SOURCE_DIR}/test/data/simulated.minimap2.hg19.coordsorted_cutoff.bam.bai
+                    URL_HASH SHA256=120469b94dd6b6ec543f7704f63541c09639772d1393b1c17969244c200b98c0)
+
+# copies file to <build>/data/progress_example.bam
+# 2500 synthetic alignments of 20bp on one sequence, six of them with an insertion of 40bp, with the BAI index below.
+# Long enough for the progress messages, which are printed every 1000 good alignments.
+declare_datasource (FILE progress_example.bam
+                    URL ${CMAKE_SOURCE_DIR}/test/data/progress_example.bam
+                    URL_HASH SHA256=21fd7f3bf33eeceb7daeb4d8c9e3ea99b4d647078561aab48ee5fc38c4660600)
+
+# copies file to <build>/data/progress_example.bam.bai
+declare_datasource (FILE progress_example.bam.bai
+                    URL ${CMAKE_SOURCE_DIR}/test/data/progress_example.bam.bai
+                    URL_HASH SHA256=fc735f9e2609086b5f54741ef4a4c00038bc46ad1ebb7eb51bb92bbd616bb13a)
+
 # copies file to <build>/data/paired_end_mini_example.sam
 declare_datasource (FILE paired_end_mini_example.sam
                     URL ${CMAKE_SOURCE_DIR}/test/data/mini_example/paired_end_mini_example.sam